@@ -0,0 +1,27 @@
+#ifdef VERTEX
+
+out vec2 uv;
+
+void main()
+{
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	uv = position;
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#endif
+
+#ifdef FRAGMENT
+
+uniform sampler2D source;
+
+in vec2 uv;
+
+out vec4 fragColor;
+
+void main()
+{
+	fragColor = texture(source, uv);
+}
+
+#endif
@@ -2,6 +2,11 @@
 
 layout(location = 0) in vec2 uv;
 layout(location = 1) in int vertexIndex;
+layout(location = 2) in int part;
+layout(location = 3) in mat4 modelMatrix;
+layout(location = 7) in ivec4 frameIndices;
+layout(location = 8) in ivec4 skinLayers;
+layout(location = 9) in float delta;
 
 uniform GlobalUniforms
 {
@@ -16,12 +21,12 @@ out VertexData
 	vec2 uv;
 	vec3 pos_eye;
 	vec3 n_eye;
+	flat int layer;
 } vert;
 
-uniform mat4 modelMatrix;
 uniform isamplerBuffer frameVertexBuffer;
+uniform samplerBuffer frameTransformBuffer;
 uniform samplerBuffer normalBuffer;
-uniform float delta;
 
 struct Frame
 {
@@ -30,14 +35,23 @@ struct Frame
 	vec3 scale;
 };
 
-uniform Frame frames[2];
-
 struct Vertex
 {
 	vec3 position;
 	vec3 normal;
 };
 
+Frame GetFrame(int index, int transformIndex)
+{
+	int transform = (transformIndex + part) * 2;
+
+	Frame frame;
+	frame.index = index;
+	frame.translate = texelFetch(frameTransformBuffer, transform).rgb;
+	frame.scale = texelFetch(frameTransformBuffer, transform + 1).rgb;
+	return frame;
+}
+
 Vertex GetVertex(Frame frame)
 {
 	ivec4 frameVertex = texelFetch(frameVertexBuffer, frame.index + vertexIndex);
@@ -57,14 +71,15 @@ vec3 Lerp(vec3 a, vec3 b, float t)
 
 void main()
 {
-	Vertex vertex = GetVertex(frames[0]);
-	Vertex nextVertex = GetVertex(frames[1]);
+	Vertex vertex = GetVertex(GetFrame(frameIndices.x, frameIndices.z));
+	Vertex nextVertex = GetVertex(GetFrame(frameIndices.y, frameIndices.w));
 
 	vec3 lerpPosition = Lerp(vertex.position, nextVertex.position, delta);
 	vec3 lerpNormal = Lerp(vertex.normal, nextVertex.normal, delta);
 
 	vert.uv = uv;
 	vert.normal = lerpNormal;
+	vert.layer = skinLayers[part];
 
 	vert.pos_eye = vec3(viewMatrix * modelMatrix * vec4(lerpPosition, 1.0));
   	vert.n_eye = vec3(viewMatrix * modelMatrix * vec4(lerpNormal, 0.0));
@@ -77,6 +92,8 @@ void main()
 #ifdef FRAGMENT
 
 uniform sampler2D diffuse;
+uniform sampler2DArray diffuseArray;
+uniform int useDiffuseArray;
 uniform samplerCube cubemap;
 
 in VertexData
@@ -85,6 +102,7 @@ in VertexData
 	vec2 uv;
 	vec3 pos_eye;
 	vec3 n_eye;
+	flat int layer;
 } vert;
 
 out vec4 fragColor;
@@ -95,7 +113,7 @@ void main()
   	vec3 normal = normalize(vert.n_eye);
   	vec3 reflected = reflect(incident_eye, normal);
 
-	vec4 textureColor = texture(diffuse, vert.uv);
+	vec4 textureColor = (useDiffuseArray != 0) ? texture(diffuseArray, vec3(vert.uv, vert.layer)) : texture(diffuse, vert.uv);
 	vec4 cubemapColor = texture(cubemap, reflected);
     fragColor = vec4(mix(cubemapColor.rgb * 2.0, textureColor.rgb, textureColor.a), 1.0);
 }
@@ -13,7 +13,13 @@ uniform GlobalUniforms
     mat4 viewProjectionMatrix;
 };
 
-uniform mat4 modelMatrix;
+layout(std140) uniform DrawUniforms
+{
+    mat4 modelMatrix;
+    float brightness;
+    float alphaCutOff;
+    float alphaMultiply;
+};
 
 out VertexData
 {
@@ -39,9 +45,13 @@ void main()
 
 uniform sampler2D diffuse;
 uniform sampler2D lightmap;
-uniform float brightness;
-uniform float alphaMultiply;
-uniform float alphaCutOff;
+layout(std140) uniform DrawUniforms
+{
+    mat4 modelMatrix;
+    float brightness;
+    float alphaCutOff;
+    float alphaMultiply;
+};
 
 in VertexData
 {
@@ -1,5 +1,6 @@
 #include "AudioClip.h"
 #include "WavLoader.h"
+#include "AudioDevice.h"
 
 #include <AL/alc.h>
 #include <AL/alext.h>
@@ -12,8 +13,14 @@ namespace Freeking
 		AddLoader<WavLoader>();
 	}
 
-	AudioClip::AudioClip(uint32_t numChannels, uint32_t bitsPerSample, uint32_t sampleRate, const std::vector<char>& pcmData) :
-		_bufferId(0)
+	size_t AudioClipLibrary::GetAssetBytes(const AudioClip& audioClip) const
+	{
+		return audioClip.GetNumBytes();
+	}
+
+	AudioClip::AudioClip(uint32_t numChannels, uint32_t bitsPerSample, uint32_t sampleRate, const uint8_t* pcmData, size_t pcmSize) :
+		_bufferId(0),
+		_numBytes(pcmSize)
 	{
 		ALenum format = AL_INVALID_ENUM;
 		if (numChannels == 1)
@@ -28,13 +35,18 @@ namespace Freeking
 		}
 
 		alGenBuffers(1, &_bufferId);
-		alBufferData(_bufferId, format, pcmData.data(), (ALsizei)pcmData.size(), sampleRate);
+		alBufferData(_bufferId, format, pcmData, (ALsizei)pcmSize, sampleRate);
 	}
 
 	AudioClip::~AudioClip()
 	{
 		if (_bufferId)
 		{
+			if (AudioDevice::Current)
+			{
+				AudioDevice::Current->ReleaseClip(this);
+			}
+
 			alDeleteBuffers(1, &_bufferId);
 		}
 	}
@@ -12,6 +12,7 @@ namespace Freeking
 	protected:
 
 		virtual void UpdateLoaders() override;
+		virtual size_t GetAssetBytes(const AudioClip& audioClip) const override;
 	};
 
 	class AudioClip
@@ -20,13 +21,15 @@ namespace Freeking
 
 		static AudioClipLibrary Library;
 
-		AudioClip(uint32_t numChannels, uint32_t bitsPerSample, uint32_t sampleRate, const std::vector<char>& pcmData);
+		AudioClip(uint32_t numChannels, uint32_t bitsPerSample, uint32_t sampleRate, const uint8_t* pcmData, size_t pcmSize);
 		~AudioClip();
 
 		uint32_t GetBufferId() const { return _bufferId; }
+		size_t GetNumBytes() const { return _numBytes; }
 
 	private:
 
 		uint32_t _bufferId;
+		size_t _numBytes;
 	};
 }
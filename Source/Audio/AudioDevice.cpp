@@ -1,5 +1,6 @@
 #include "AudioDevice.h"
 #include "AudioClip.h"
+#include <algorithm>
 #include <stdexcept>
 
 namespace Freeking
@@ -16,6 +17,42 @@ namespace Freeking
 	AudioDevice::~AudioDevice()
 	{
 		ShutdownOpenAL();
+
+		if (Current == this)
+		{
+			Current = nullptr;
+		}
+	}
+
+	void AudioDevice::StopAll()
+	{
+		_audioQueue.clear();
+
+		for (const auto& sourceId : _sourceIds)
+		{
+			alSourceStop(sourceId);
+			alSourcei(sourceId, AL_BUFFER, 0);
+		}
+	}
+
+	void AudioDevice::ReleaseClip(const AudioClip* audioClip)
+	{
+		_audioQueue.erase(std::remove_if(_audioQueue.begin(), _audioQueue.end(), [audioClip](const QueuedAudio& queuedAudio)
+		{
+			return queuedAudio.audioClip == audioClip;
+		}), _audioQueue.end());
+
+		for (const auto& sourceId : _sourceIds)
+		{
+			ALint bufferId = 0;
+			alGetSourcei(sourceId, AL_BUFFER, &bufferId);
+
+			if ((uint32_t)bufferId == audioClip->GetBufferId())
+			{
+				alSourceStop(sourceId);
+				alSourcei(sourceId, AL_BUFFER, 0);
+			}
+		}
 	}
 
 	void AudioDevice::FlushQueue()
@@ -24,6 +24,10 @@ namespace Freeking
 
 		void Play(AudioClip* audioClip, const Vector3f& position, bool loop = false, bool relative = false, bool queued = false);
 		void FlushQueue();
+		void StopAll();
+
+		// Detaches the clip from every source so its buffer can be deleted.
+		void ReleaseClip(const AudioClip* audioClip);
 
 		void SetListenerTransform(const Vector3f& position, const Quaternion& rotation);
 
@@ -51,9 +51,29 @@ namespace Freeking
 
 	struct BspFile
 	{
-		static const BspFile& Create(const uint8_t* Data)
+		// Returns nullptr unless the header is valid and every lump lies within the file.
+		static const BspFile* Create(const uint8_t* Data, size_t Size)
 		{
-			return (const BspFile&)*Data;
+			if (Size < sizeof(BspHeader))
+			{
+				return nullptr;
+			}
+
+			const auto& File = (const BspFile&)*Data;
+			if (!File.IsValid())
+			{
+				return nullptr;
+			}
+
+			for (const auto& Lump : File.Header.LumpsHeaders)
+			{
+				if (Lump.Offset < 0 || Lump.Length < 0 || (size_t)Lump.Offset + (size_t)Lump.Length > Size)
+				{
+					return nullptr;
+				}
+			}
+
+			return &File;
 		}
 
 		inline bool IsValid() const
@@ -1,5 +1,6 @@
 #include "EntityLump.h"
 #include "Util.h"
+#include <algorithm>
 
 namespace Freeking
 {
@@ -20,7 +21,7 @@ namespace Freeking
 
 	bool EntityProperty::ValueAsStringArray(std::vector<std::string>& v) const
 	{
-		v = Util::SplitString(_value, " ");
+		v = Util::SplitString(std::string(_value), " ");
 
 		return !v.empty();
 	}
@@ -40,153 +41,76 @@ namespace Freeking
 		return false;
 	}
 
-	bool EntityProperties::TryGetString(const std::string& key, CommonString& value) const
+	EntityProperties::EntityProperties(const EntityProperty* keyValues, size_t numKeyValues) :
+		_keyValues(keyValues),
+		_numKeyValues(numKeyValues)
 	{
-		if (TryGetString(key, value.value))
+		for (const auto& property : GetKeyValues())
 		{
-			value.unset = false;
-			return true;
+			switch (property.GetKeyId())
+			{
+			case "classname"_key:
+				_classname = property.Value();
+				break;
+			case "name"_key:
+				_name = property.Value();
+				break;
+			case "targetname"_key:
+				_targetname = property.Value();
+				break;
+			case "target"_key:
+				_target = property.Value();
+				break;
+			case "origin"_key:
+				_origin.unset = !property.ValueAsVector(_origin.value);
+				break;
+			case "angle"_key:
+				_angle.unset = !property.ValueAsFloat(_angle.value);
+				break;
+			}
 		}
-
-		return false;
 	}
 
-	bool EntityProperties::TryGetVector(const std::string& key, CommonVector& value) const
+	const EntityProperty* EntityProperties::Find(EntityKey key) const
 	{
-		if (TryGetVector(key, value.value))
+		auto last = _keyValues + _numKeyValues;
+		auto it = std::lower_bound(_keyValues, last, key, [](const EntityProperty& property, EntityKey key)
 		{
-			value.unset = false;
-			return true;
-		}
-
-		return false;
-	}
+			return property.GetKeyId() < key;
+		});
 
-	bool EntityProperties::TryGetFloat(const std::string& key, CommonScalar& value) const
-	{
-		if (TryGetFloat(key, value.value))
+		if (it != last && it->IsKey(key))
 		{
-			value.unset = false;
-			return true;
+			return it;
 		}
 
-		return false;
+		return nullptr;
 	}
 
-	bool EntityProperties::TryGetInt(const std::string& key, CommonInt& value) const
+	bool EntityProperties::TryGetString(EntityKey key, std::string& value) const
 	{
-		if (TryGetInt(key, value.value))
+		if (auto property = Find(key))
 		{
-			value.unset = false;
+			value = property->Value();
+
 			return true;
 		}
 
 		return false;
 	}
 
-	bool EntityProperties::TryGetString(const std::string& key, std::string& value) const
-	{
-		auto it = _keyToValues.find(key);
-		if (it == _keyToValues.end())
-		{
-			return false;
-		}
-
-		value = it->second;
-
-		return true;
-	}
-
-	bool EntityProperties::TryGetSplitString(const std::string& key, std::vector<std::string>& value) const
-	{
-		auto it = _keyToValues.find(key);
-		if (it == _keyToValues.end())
-		{
-			return false;
-		}
-
-		value = Util::SplitString(it->second, " ");
-
-		return true;
-	}
-
-	bool EntityProperties::TryGetInt(const std::string& key, int& value) const
-	{
-		std::string s;
-		if (!TryGetString(key, s))
-		{
-			return false;
-		}
-
-		return Util::TryParseInt(s, value);
-	}
-
-	bool EntityProperties::TryGetFloat(const std::string& key, float& value) const
-	{
-		std::string s;
-		if (!TryGetString(key, s))
-		{
-			return false;
-		}
-
-		return Util::TryParseFloat(s, value);
-	}
-
-	bool EntityProperties::TryGetVector(const std::string& key, Vector3f& value) const
-	{
-		std::string s;
-		if (!TryGetString(key, s))
-		{
-			return false;
-		}
-
-		return Util::TryParseVector(s, value);
-	}
-
-	void EntityProperties::AddKeyValue(const std::string& key, const std::string& value)
+	bool EntityLump::Parse(const std::string_view& string)
 	{
-		_keyValues.emplace_back(key, value);
-		_keyToValues.emplace(key, value);
-	}
-
-	void EntityProperties::FindCommonValues()
-	{
-		if (TryGetString("classname", _classname))
-		{
-			TryGetString("name", _name);
-			TryGetString("targetname", _targetname);
-			TryGetString("target", _target);
-			TryGetVector("origin", _origin);
-			TryGetFloat("angle", _angle);
-		}
-	}
+		_keyValues.clear();
+		_entities.clear();
 
-	bool EntityLump::Parse(const std::string& string, std::vector<EntityProperties>& items)
-	{
-		std::vector<EntityProperties> entityKeyValues;
+		// Every key/value pair takes four quotes, so this reserve is an upper bound
+		// and the property pointers handed to EntityProperties stay valid.
+		_keyValues.reserve(std::count(string.begin(), string.end(), '"') / 4);
+		_entities.reserve(std::count(string.begin(), string.end(), '{'));
 
 		size_t pos = 0;
-		while (pos < string.size())
-		{
-			EntityProperties keyValues;
-			if (!TryParseKeyValues(string, pos, keyValues))
-			{
-				return false;
-			}
-
-			keyValues.FindCommonValues();
-
-			if (keyValues.GetClassnameProperty())
-			{
-				items.push_back(std::move(keyValues));
-			}
-		}
-
-		return true;
-	}
-
-	bool EntityLump::TryParseKeyValues(const std::string& string, size_t& pos, EntityProperties& properties)
-	{
+		size_t first = 0;
 		bool begin = false;
 
 		while (pos < string.size())
@@ -196,7 +120,8 @@ namespace Freeking
 			if (c == ' ' ||
 				c == '\t' ||
 				c == '\n' ||
-				c == '\r')
+				c == '\r' ||
+				c == 0)
 			{
 				pos++;
 
@@ -210,61 +135,78 @@ namespace Freeking
 				}
 
 				begin = true;
+				first = _keyValues.size();
 				pos++;
 
 				continue;
 			}
 			else if (c == '}')
 			{
+				if (begin)
+				{
+					auto keyValues = _keyValues.data() + first;
+					size_t numKeyValues = _keyValues.size() - first;
+
+					for (size_t i = 1; i < numKeyValues; ++i)
+					{
+						for (size_t j = i; j > 0 && keyValues[j].GetKeyId() < keyValues[j - 1].GetKeyId(); --j)
+						{
+							std::swap(keyValues[j], keyValues[j - 1]);
+						}
+					}
+
+					EntityProperties properties(keyValues, numKeyValues);
+
+					if (properties.GetClassnameProperty())
+					{
+						_entities.push_back(properties);
+					}
+				}
+
+				begin = false;
 				pos++;
 
-				break;
+				continue;
 			}
 			else if (begin && c == '"')
 			{
-				std::string key = ParseSubString(string, pos);
-				std::string value = ParseSubString(string, pos);
-				properties.AddKeyValue(key, value);
+				std::string_view key;
+				std::string_view value;
+
+				if (!ParseSubString(string, pos, key) ||
+					!ParseSubString(string, pos, value))
+				{
+					return false;
+				}
+
+				_keyValues.emplace_back(key, value);
 
 				continue;
 			}
-			else if (c != 0)
-			{
-				return false;
-			}
 
-			pos++;
+			return false;
 		}
 
 		return true;
 	}
 
-	std::string EntityLump::ParseSubString(const std::string& string, size_t& pos)
+	bool EntityLump::ParseSubString(const std::string_view& string, size_t& pos, std::string_view& subString)
 	{
-		bool begin = false;
-		std::string subString = "";
-
-		while (pos < string.size())
+		size_t begin = string.find('"', pos);
+		if (begin == std::string_view::npos)
 		{
-			const char& c = string[pos++];
-
-			if (c == '"')
-			{
-				if (!begin)
-				{
-					begin = true;
-
-					continue;
-				}
+			return false;
+		}
 
-				break;
-			}
-			else if (begin)
-			{
-				subString += c;
-			}
+		size_t end = string.find('"', begin + 1);
+		if (end == std::string_view::npos)
+		{
+			return false;
 		}
 
-		return subString;
+		subString = string.substr(begin + 1, end - begin - 1);
+		pos = end + 1;
+
+		return true;
 	}
 }
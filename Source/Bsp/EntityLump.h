@@ -2,25 +2,36 @@
 
 #include "Vector.h"
 #include "EnumFlags.h"
+#include "Hash.h"
+#include "Name.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 
 namespace Freeking
 {
+	using EntityKey = uint32_t;
+
+	constexpr EntityKey operator""_key(const char* key, size_t length)
+	{
+		return Hash::Fnv1a(std::string_view(key, length));
+	}
+
 	class EntityProperty
 	{
 	public:
 
 		EntityProperty() = delete;
-		EntityProperty(const std::string& key, const std::string& value) :
-			_key(key), _value(value)
+		EntityProperty(const std::string_view& key, const std::string_view& value) :
+			_key(key), _value(value), _keyId(_key.GetHash())
 		{
 		}
 
-		inline bool IsKey(const std::string& key) const { return _key == key; }
-		inline const std::string Key() const { return _key; }
-		inline const std::string Value() const { return _value; }
+		inline bool IsKey(EntityKey key) const { return _keyId == key; }
+		inline EntityKey GetKeyId() const { return _keyId; }
+		inline const Name& Key() const { return _key; }
+		inline const std::string_view& Value() const { return _value; }
 
 		bool ValueAsVector(Vector3f& v) const;
 		bool ValueAsFloat(float& v) const;
@@ -44,8 +55,9 @@ namespace Freeking
 
 	private:
 
-		std::string _key;
-		std::string _value;
+		Name _key;
+		std::string_view _value;
+		EntityKey _keyId;
 	};
 
 	class EntityProperties
@@ -72,20 +84,24 @@ namespace Freeking
 			friend class EntityProperties;
 		};
 
-		EntityProperties() = default;
-		EntityProperties(EntityProperties&&) = default;
-		EntityProperties(const EntityProperties&) = delete;
-		EntityProperties& operator=(const EntityProperties&) = delete;
+		struct KeyValues
+		{
+			const EntityProperty* first;
+			const EntityProperty* last;
+
+			inline const EntityProperty* begin() const { return first; }
+			inline const EntityProperty* end() const { return last; }
+			inline size_t size() const { return last - first; }
+		};
 
-		void AddKeyValue(const std::string& key, const std::string& value);
-		void FindCommonValues();
+		EntityProperties(const EntityProperty* keyValues, size_t numKeyValues);
 
-		using CommonString = CommonValue<std::string>;
+		using CommonString = CommonValue<std::string_view>;
 		using CommonVector = CommonValue<Vector3f>;
 		using CommonScalar = CommonValue<float>;
 		using CommonInt = CommonValue<int>;
 
-		inline const std::vector<EntityProperty>& GetKeyValues() const { return _keyValues; }
+		inline KeyValues GetKeyValues() const { return { _keyValues, _keyValues + _numKeyValues }; }
 
 		const CommonString& GetClassnameProperty() const { return _classname; }
 		const CommonString& GetNameProperty() const { return _name; }
@@ -94,22 +110,13 @@ namespace Freeking
 		const CommonVector& GetOriginProperty() const { return _origin; }
 		const CommonScalar& GetAngleProperty() const { return _angle; }
 
-		bool TryGetString(const std::string& key, std::string& value) const;
+		const EntityProperty* Find(EntityKey key) const;
+		bool TryGetString(EntityKey key, std::string& value) const;
 
 	private:
 
-		bool TryGetInt(const std::string& key, int& value) const;
-		bool TryGetFloat(const std::string& key, float& value) const;
-		bool TryGetVector(const std::string& key, Vector3f& value) const;
-		bool TryGetSplitString(const std::string& key, std::vector<std::string>& value) const;
-
-		bool TryGetString(const std::string& key, CommonString& value) const;
-		bool TryGetVector(const std::string& key, CommonVector& value) const;
-		bool TryGetFloat(const std::string& key, CommonScalar& value) const;
-		bool TryGetInt(const std::string& key, CommonInt& value) const;
-
-		std::unordered_map<std::string, std::string> _keyToValues;
-		std::vector<EntityProperty> _keyValues;
+		const EntityProperty* _keyValues;
+		size_t _numKeyValues;
 
 		CommonString _classname;
 		CommonString _name;
@@ -123,14 +130,19 @@ namespace Freeking
 	{
 	public:
 
-		EntityLump() = delete;
-		~EntityLump() = delete;
+		EntityLump() = default;
+		EntityLump(const EntityLump&) = delete;
+		EntityLump& operator=(const EntityLump&) = delete;
 
-		static bool Parse(const std::string& string, std::vector<EntityProperties>& items);
+		bool Parse(const std::string_view& string);
+
+		inline const std::vector<EntityProperties>& GetEntities() const { return _entities; }
 
 	private:
 
-		static bool TryParseKeyValues(const std::string& string, size_t& pos, EntityProperties& properties);
-		static std::string ParseSubString(const std::string& string, size_t& pos);
+		static bool ParseSubString(const std::string_view& string, size_t& pos, std::string_view& subString);
+
+		std::vector<EntityProperty> _keyValues;
+		std::vector<EntityProperties> _entities;
 	};
 }
@@ -0,0 +1,68 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef FREEKING_TRACK_ALLOCATIONS
+
+static std::atomic<size_t> _allocationCount = 0;
+
+void* operator new(size_t size)
+{
+	_allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* p = std::malloc(size ? size : 1))
+	{
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+#endif
+
+namespace Freeking
+{
+	bool AllocationCounter::IsEnabled()
+	{
+#ifdef FREEKING_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	size_t AllocationCounter::GetCount()
+	{
+#ifdef FREEKING_TRACK_ALLOCATIONS
+		return _allocationCount.load(std::memory_order_relaxed);
+#else
+		return 0;
+#endif
+	}
+}
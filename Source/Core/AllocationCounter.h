@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Freeking
+{
+	class AllocationCounter
+	{
+	public:
+
+		AllocationCounter() = delete;
+		~AllocationCounter() = delete;
+
+		static bool IsEnabled();
+		static size_t GetCount();
+	};
+}
@@ -1,6 +1,105 @@
 #include "AssetLibrary.h"
+#include <algorithm>
 
 namespace Freeking
 {
-	std::stack<std::filesystem::path> PathStack::_paths = {};
+	thread_local std::stack<std::filesystem::path> PathStack::_paths = {};
+	uint32_t AssetLibraryBase::_generation = 0;
+	size_t AssetLibraryBase::_residencyBudget = 256 * 1024 * 1024;
+
+	AssetLibraryBase::AssetLibraryBase() :
+		_numGets(0),
+		_numLoads(0),
+		_frameGets(0),
+		_frameLoads(0)
+	{
+		GetLibraries().push_back(this);
+	}
+
+	AssetLibraryBase::~AssetLibraryBase()
+	{
+		auto& libraries = GetLibraries();
+		libraries.erase(std::remove(libraries.begin(), libraries.end(), this), libraries.end());
+	}
+
+	void AssetLibraryBase::EndFrame()
+	{
+		for (auto library : GetLibraries())
+		{
+			library->_frameGets = library->_numGets;
+			library->_frameLoads = library->_numLoads;
+			library->_numGets = 0;
+			library->_numLoads = 0;
+		}
+	}
+
+	void AssetLibraryBase::BeginTransition()
+	{
+		_generation++;
+
+		for (auto library : GetLibraries())
+		{
+			library->_residencyReport = {};
+		}
+	}
+
+	void AssetLibraryBase::EndTransition()
+	{
+		std::vector<EvictionCandidate> candidates;
+		size_t residentBytes = 0;
+
+		for (auto library : GetLibraries())
+		{
+			library->_residencyReport.retained.clear();
+			library->_residencyReport.evicted.clear();
+			library->_residencyReport.numShared = 0;
+			library->_residencyReport.retainedBytes = 0;
+			library->_residencyReport.evictedBytes = 0;
+
+			library->GetEvictionCandidates(candidates);
+			residentBytes += library->GetResidentBytes();
+		}
+
+		// Oldest first, and the largest of those last used by the same map.
+		std::sort(candidates.begin(), candidates.end(), [](const EvictionCandidate& a, const EvictionCandidate& b)
+		{
+			return (a.lastUsed != b.lastUsed) ? (a.lastUsed < b.lastUsed) : (a.bytes > b.bytes);
+		});
+
+		for (const auto& candidate : candidates)
+		{
+			if (residentBytes <= _residencyBudget)
+			{
+				break;
+			}
+
+			candidate.library->Evict(candidate.name);
+			candidate.library->_residencyReport.evicted.push_back(candidate.name);
+			candidate.library->_residencyReport.evictedBytes += candidate.bytes;
+			residentBytes -= candidate.bytes;
+		}
+
+		for (auto library : GetLibraries())
+		{
+			library->UpdateRetained();
+		}
+	}
+
+	size_t AssetLibraryBase::GetTotalResidentBytes()
+	{
+		size_t bytes = 0;
+
+		for (auto library : GetLibraries())
+		{
+			bytes += library->GetResidentBytes();
+		}
+
+		return bytes;
+	}
+
+	std::vector<AssetLibraryBase*>& AssetLibraryBase::GetLibraries()
+	{
+		static std::vector<AssetLibraryBase*> libraries;
+		return libraries;
+	}
 }
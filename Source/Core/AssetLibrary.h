@@ -1,8 +1,12 @@
 #pragma once
 
 #include "FileSystem.h"
+#include "Name.h"
+#include "AssetLoadQueue.h"
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <string>
 #include <filesystem>
 #include <stack>
@@ -17,6 +21,7 @@ namespace Freeking
 		PathStack() = delete;
 
 		static std::filesystem::path Top() { return _paths.empty() ? "" : _paths.top(); }
+		static bool IsEmpty() { return _paths.empty(); }
 
 	private:
 
@@ -26,7 +31,12 @@ namespace Freeking
 		PathStack(const std::filesystem::path& path) { _paths.push(path.parent_path()); }
 		~PathStack() { _paths.pop(); }
 
-		static std::stack<std::filesystem::path> _paths;
+		static thread_local std::stack<std::filesystem::path> _paths;
+	};
+
+	struct AssetLoadData
+	{
+		virtual ~AssetLoadData() {}
 	};
 
 	template <typename T>
@@ -42,12 +52,153 @@ namespace Freeking
 		AssetLoader(const AssetLoader&) = delete;
 		AssetLoader& operator=(const AssetLoader&) = delete;
 
-		virtual AssetPtr Load(const std::string&) const { return nullptr; }
+		virtual AssetPtr Load(const std::string& name) const
+		{
+			if (auto data = Decode(name))
+			{
+				return Upload(*data);
+			}
+
+			return nullptr;
+		}
+
 		virtual bool CanLoadExtension(const std::string&) const { return false; };
+
+		// Loaders that can split their work implement Decode, which runs on a worker
+		// thread and must not touch GL/AL, and Upload, which runs on the main thread.
+		virtual bool CanLoadAsync() const { return false; }
+		virtual std::unique_ptr<AssetLoadData> Decode(const std::string&) const { return nullptr; }
+		virtual AssetPtr Upload(AssetLoadData&) const { return nullptr; }
 	};
 
+	enum class AssetLoadState
+	{
+		Pending,
+		Ready,
+		Failed
+	};
+
+	template <typename T>
+	class AssetLibrary;
+
 	template <typename T>
-	class AssetLibrary
+	class AssetRequest
+	{
+	public:
+
+		using AssetPtr = std::shared_ptr<T>;
+
+		AssetRequest() {}
+
+		inline AssetLoadState GetState() const { return _record ? _record->state : AssetLoadState::Failed; }
+		inline bool IsPending() const { return GetState() == AssetLoadState::Pending; }
+		inline bool IsReady() const { return GetState() == AssetLoadState::Ready; }
+		inline bool IsFailed() const { return GetState() == AssetLoadState::Failed; }
+
+		// Returns the loaded asset, or the library placeholder until it's ready.
+		inline const AssetPtr& Get() const
+		{
+			static const AssetPtr null;
+
+			if (!_record)
+			{
+				return null;
+			}
+
+			return (_record->state == AssetLoadState::Ready) ? _record->asset : _record->placeholder;
+		}
+
+	private:
+
+		friend class AssetLibrary<T>;
+
+		struct Record
+		{
+			AssetLoadState state = AssetLoadState::Pending;
+			AssetPtr asset;
+			AssetPtr placeholder;
+		};
+
+		AssetRequest(std::shared_ptr<Record> record) : _record(std::move(record)) {}
+
+		std::shared_ptr<Record> _record;
+	};
+
+	// What the last map change did to the assets of one library. Reloaded assets are
+	// those evicted by an earlier change and loaded again since the last one began.
+	struct AssetResidencyReport
+	{
+		std::vector<Name> retained;
+		std::vector<Name> evicted;
+		std::vector<Name> reloaded;
+		size_t numShared = 0;
+		size_t retainedBytes = 0;
+		size_t evictedBytes = 0;
+		size_t reloadedBytes = 0;
+	};
+
+	class AssetLibraryBase
+	{
+	public:
+
+		AssetLibraryBase();
+		virtual ~AssetLibraryBase();
+
+		// Rolls the per-frame counters of every library; called once per frame.
+		static void EndFrame();
+
+		// Call before releasing the old map. Assets requested from then on count as used
+		// by the new one.
+		static void BeginTransition();
+
+		// Call once the new map has finished loading. Assets that nothing outside the
+		// libraries holds on to are evicted, least recently used first, until every
+		// library together fits the residency budget.
+		static void EndTransition();
+
+		static inline void SetResidencyBudget(size_t bytes) { _residencyBudget = bytes; }
+		static inline size_t GetResidencyBudget() { return _residencyBudget; }
+		static size_t GetTotalResidentBytes();
+
+		inline size_t GetFrameGets() const { return _frameGets; }
+		inline size_t GetFrameLoads() const { return _frameLoads; }
+		inline const AssetResidencyReport& GetResidencyReport() const { return _residencyReport; }
+
+		virtual size_t GetResidentBytes() const { return 0; }
+
+	protected:
+
+		struct EvictionCandidate
+		{
+			AssetLibraryBase* library;
+			Name name;
+			size_t bytes;
+			uint32_t lastUsed;
+		};
+
+		virtual void GetEvictionCandidates(std::vector<EvictionCandidate>&) {}
+		virtual void Evict(const Name&) {}
+		virtual void UpdateRetained() {}
+
+		size_t _numGets;
+		size_t _numLoads;
+		AssetResidencyReport _residencyReport;
+
+		// Incremented by every map change.
+		static uint32_t _generation;
+
+	private:
+
+		static std::vector<AssetLibraryBase*>& GetLibraries();
+
+		size_t _frameGets;
+		size_t _frameLoads;
+
+		static size_t _residencyBudget;
+	};
+
+	template <typename T>
+	class AssetLibrary : public AssetLibraryBase
 	{
 	public:
 
@@ -60,9 +211,11 @@ namespace Freeking
 		AssetLibrary(const AssetLibrary&) = delete;
 		AssetLibrary& operator=(const AssetLibrary&) = delete;
 
-		AssetPtr Get(const std::string& name)
+		AssetPtr Get(const Name& name)
 		{
-			if (name.empty())
+			_numGets++;
+
+			if (name.IsEmpty())
 			{
 				return nullptr;
 			}
@@ -72,64 +225,237 @@ namespace Freeking
 				return it->second;
 			}
 
-			auto absolutePath = PathStack::Top() / name;
+			if (PathStack::IsEmpty())
+			{
+				if (auto it = _pathAssets.find(name); it != _pathAssets.end())
+				{
+					return Use(it->second);
+				}
+
+				if (_missingAssets.find(name) != _missingAssets.end())
+				{
+					return nullptr;
+				}
+			}
+
+			auto absolutePath = PathStack::Top() / name.ToStringView();
 			auto absoluteName = absolutePath.string();
 			std::replace(absoluteName.begin(), absoluteName.end(), '\\', '/');
+			Name absoluteKey(absoluteName);
 
-			if (auto it = _pathAssets.find(absoluteName); it != _pathAssets.end())
+			if (auto it = _pathAssets.find(absoluteKey); it != _pathAssets.end())
 			{
-				return it->second;
+				return Use(it->second);
 			}
-			else
+
+			if (_missingAssets.find(absoluteKey) != _missingAssets.end())
 			{
-				if (!FileSystem::FileExists(absoluteName))
-				{
-					return nullptr;
-				}
+				return nullptr;
+			}
 
-				auto extension = std::filesystem::path(absoluteName).extension();
-				if (extension.empty())
+			_numLoads++;
+
+			if (auto asset = Load(absolutePath, absoluteName))
+			{
+				AddPathAsset(absoluteKey, asset);
+
+				return asset;
+			}
+
+			_missingAssets.insert(absoluteKey);
+
+			return nullptr;
+		}
+
+		AssetRequest<T> GetAsync(const Name& name)
+		{
+			using Record = typename AssetRequest<T>::Record;
+
+			if (name.IsEmpty())
+			{
+				return {};
+			}
+
+			_numGets++;
+
+			if (auto it = _specialAssets.find(name); it != _specialAssets.end())
+			{
+				return MakeReadyRequest(it->second);
+			}
+
+			auto absolutePath = PathStack::Top() / name.ToStringView();
+			auto absoluteName = absolutePath.string();
+			std::replace(absoluteName.begin(), absoluteName.end(), '\\', '/');
+			Name absoluteKey(absoluteName);
+
+			if (auto it = _pathAssets.find(absoluteKey); it != _pathAssets.end())
+			{
+				return MakeReadyRequest(Use(it->second));
+			}
+
+			if (auto it = _pendingAssets.find(absoluteKey); it != _pendingAssets.end())
+			{
+				return AssetRequest<T>(it->second);
+			}
+
+			if (_missingAssets.find(absoluteKey) != _missingAssets.end())
+			{
+				return MakeReadyRequest(nullptr);
+			}
+
+			if (_loaders.empty())
+			{
+				UpdateLoaders();
+			}
+
+			const AssetLoader<T>* asyncLoader = nullptr;
+			auto extension = std::filesystem::path(absoluteName).extension().string();
+
+			for (const auto& loader : _loaders)
+			{
+				if (loader->CanLoadExtension(extension) && loader->CanLoadAsync())
 				{
-					return nullptr;
+					asyncLoader = loader.get();
+					break;
 				}
+			}
+
+			if (!asyncLoader || !FileSystem::FileExists(absoluteName))
+			{
+				return MakeReadyRequest(Get(name));
+			}
+
+			if (!_placeholder)
+			{
+				_placeholder = CreatePlaceholder();
+			}
+
+			_numLoads++;
+
+			auto record = std::make_shared<Record>();
+			record->placeholder = _placeholder;
+			_pendingAssets.emplace(absoluteKey, record);
+
+			AssetLoadQueue::EnqueueDecode([this, asyncLoader, absolutePath, absoluteName, absoluteKey, record]()
+			{
+				std::shared_ptr<AssetLoadData> data;
 
-				if (_loaders.empty())
 				{
-					UpdateLoaders();
+					PathStack ps(absolutePath);
+					data = asyncLoader->Decode(absoluteName);
 				}
 
-				PathStack ps(absolutePath);
-
-				for (const auto& loader : _loaders)
+				AssetLoadQueue::EnqueueUpload([this, asyncLoader, absoluteKey, record, data]()
 				{
-					if (!loader->CanLoadExtension(extension.string()))
+					_pendingAssets.erase(absoluteKey);
+
+					// A synchronous Get may have loaded the same asset while this one was in flight.
+					if (auto it = _pathAssets.find(absoluteKey); it != _pathAssets.end())
 					{
-						continue;
+						record->asset = Use(it->second);
 					}
-
-					if (auto asset = loader->Load(absoluteName))
+					else if (data)
 					{
-						_pathAssets.emplace(absoluteName, asset);
+						record->asset = asyncLoader->Upload(*data);
 
-						return asset;
+						if (record->asset)
+						{
+							AddPathAsset(absoluteKey, record->asset);
+						}
 					}
-				}
 
-				return nullptr;
-			}
+					if (!record->asset)
+					{
+						_missingAssets.insert(absoluteKey);
+					}
+
+					record->state = record->asset ? AssetLoadState::Ready : AssetLoadState::Failed;
+				});
+			});
+
+			return AssetRequest<T>(record);
 		}
 
-		void SetSpecialNamed(const std::string& name, AssetPtr asset)
+		void SetSpecialNamed(const Name& name, AssetPtr asset)
 		{
 			_specialAssets.emplace(name, asset);
 		}
 
-		inline const std::unordered_map<std::string, AssetPtr>& GetPathAssets() const { return _pathAssets; }
-		inline const std::unordered_map<std::string, AssetPtr>& GetSpecialAssets() const { return _specialAssets; }
+		struct ResidentAsset
+		{
+			AssetPtr asset;
+			uint32_t loaded;
+			uint32_t lastUsed;
+		};
+
+		inline const std::unordered_map<Name, ResidentAsset>& GetPathAssets() const { return _pathAssets; }
+		inline const std::unordered_map<Name, AssetPtr>& GetSpecialAssets() const { return _specialAssets; }
+		inline size_t GetNumPendingAssets() const { return _pendingAssets.size(); }
+		inline size_t GetNumMissingAssets() const { return _missingAssets.size(); }
+
+		// Forget failed lookups, e.g. after mounting another file system.
+		void ClearMissingAssets() { _missingAssets.clear(); }
+
+		virtual size_t GetResidentBytes() const override
+		{
+			size_t bytes = 0;
+
+			for (const auto& [name, resident] : _pathAssets)
+			{
+				bytes += GetAssetBytes(*resident.asset);
+			}
+
+			return bytes;
+		}
 
 	protected:
 
 		virtual void UpdateLoaders() {}
+		virtual AssetPtr CreatePlaceholder() { return nullptr; }
+
+		// Libraries only take part in eviction if they report the memory their assets use.
+		virtual size_t GetAssetBytes(const T&) const { return 0; }
+
+		virtual void GetEvictionCandidates(std::vector<EvictionCandidate>& candidates) override
+		{
+			for (const auto& [name, resident] : _pathAssets)
+			{
+				if (resident.asset.use_count() > 1)
+				{
+					continue;
+				}
+
+				if (auto bytes = GetAssetBytes(*resident.asset); bytes > 0)
+				{
+					candidates.push_back({ this, name, bytes, resident.lastUsed });
+				}
+			}
+		}
+
+		virtual void Evict(const Name& name) override
+		{
+			_pathAssets.erase(name);
+			_evictedAssets.insert(name);
+		}
+
+		virtual void UpdateRetained() override
+		{
+			for (const auto& [name, resident] : _pathAssets)
+			{
+				if (resident.loaded == _generation)
+				{
+					continue;
+				}
+
+				_residencyReport.retained.push_back(name);
+				_residencyReport.retainedBytes += GetAssetBytes(*resident.asset);
+
+				if (resident.lastUsed == _generation)
+				{
+					_residencyReport.numShared++;
+				}
+			}
+		}
 
 		template<class T> void AddLoader()
 		{
@@ -138,8 +464,129 @@ namespace Freeking
 
 	private:
 
-		std::unordered_map<std::string, AssetPtr> _pathAssets;
-		std::unordered_map<std::string, AssetPtr> _specialAssets;
+		AssetPtr Load(const std::filesystem::path& absolutePath, const std::string& absoluteName)
+		{
+			if (!FileSystem::FileExists(absoluteName))
+			{
+				return nullptr;
+			}
+
+			auto extension = std::filesystem::path(absoluteName).extension();
+			if (extension.empty())
+			{
+				return nullptr;
+			}
+
+			if (_loaders.empty())
+			{
+				UpdateLoaders();
+			}
+
+			PathStack ps(absolutePath);
+
+			for (const auto& loader : _loaders)
+			{
+				if (!loader->CanLoadExtension(extension.string()))
+				{
+					continue;
+				}
+
+				if (auto asset = loader->Load(absoluteName))
+				{
+					return asset;
+				}
+			}
+
+			return nullptr;
+		}
+
+		inline const AssetPtr& Use(ResidentAsset& resident)
+		{
+			resident.lastUsed = _generation;
+
+			return resident.asset;
+		}
+
+		void AddPathAsset(const Name& key, const AssetPtr& asset)
+		{
+			_pathAssets.insert_or_assign(key, ResidentAsset{ asset, _generation, _generation });
+
+			if (_evictedAssets.erase(key) > 0)
+			{
+				_residencyReport.reloaded.push_back(key);
+				_residencyReport.reloadedBytes += GetAssetBytes(*asset);
+			}
+		}
+
+		static AssetRequest<T> MakeReadyRequest(AssetPtr asset)
+		{
+			auto record = std::make_shared<typename AssetRequest<T>::Record>();
+			record->state = asset ? AssetLoadState::Ready : AssetLoadState::Failed;
+			record->asset = std::move(asset);
+
+			return AssetRequest<T>(record);
+		}
+
+		std::unordered_map<Name, ResidentAsset> _pathAssets;
+		std::unordered_map<Name, AssetPtr> _specialAssets;
+		std::unordered_map<Name, std::shared_ptr<typename AssetRequest<T>::Record>> _pendingAssets;
+		std::unordered_set<Name> _missingAssets;
+		std::unordered_set<Name> _evictedAssets;
 		std::vector<AssetLoaderPtr> _loaders;
+		AssetPtr _placeholder;
+	};
+
+	// Resolves its path on first use and keeps the asset, so hot code pays for
+	// the lookup once instead of on every call.
+	template <typename T>
+	class AssetHandle
+	{
+	public:
+
+		AssetHandle() :
+			_library(nullptr),
+			_resolved(true)
+		{
+		}
+
+		AssetHandle(AssetLibrary<T>& library, const Name& name) :
+			_library(&library),
+			_name(name),
+			_resolved(false)
+		{
+		}
+
+		inline T* Get() const
+		{
+			if (!_resolved)
+			{
+				Resolve();
+			}
+
+			return _asset.get();
+		}
+
+		inline const std::shared_ptr<T>& GetShared() const
+		{
+			Get();
+			return _asset;
+		}
+
+		inline const Name& GetName() const { return _name; }
+		inline T* operator->() const { return Get(); }
+		inline explicit operator bool() const { return Get() != nullptr; }
+
+	private:
+
+		void Resolve() const
+		{
+			_asset = _library->Get(_name);
+			_resolved = true;
+		}
+
+		AssetLibrary<T>* _library;
+		Name _name;
+		mutable std::shared_ptr<T> _asset;
+		mutable bool _resolved;
 	};
 }
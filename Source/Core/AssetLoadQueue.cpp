@@ -0,0 +1,218 @@
+#include "AssetLoadQueue.h"
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+namespace Freeking
+{
+	std::vector<std::thread> AssetLoadQueue::_workers = {};
+	std::deque<AssetLoadQueue::Job> AssetLoadQueue::_decodeJobs = {};
+	std::deque<AssetLoadQueue::Job> AssetLoadQueue::_uploadJobs = {};
+	std::mutex AssetLoadQueue::_decodeMutex;
+	std::mutex AssetLoadQueue::_uploadMutex;
+	std::condition_variable AssetLoadQueue::_decodeCondition;
+	size_t AssetLoadQueue::_numActiveDecodes = 0;
+	bool AssetLoadQueue::_stopping = false;
+
+	void AssetLoadQueue::Start(size_t numWorkers)
+	{
+		if (!_workers.empty())
+		{
+			return;
+		}
+
+		if (numWorkers == 0)
+		{
+			// Leave a core for the main thread.
+			numWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+			numWorkers = std::clamp(numWorkers, (size_t)1, (size_t)4);
+		}
+
+		_stopping = false;
+
+		for (size_t i = 0; i < numWorkers; ++i)
+		{
+			_workers.emplace_back(WorkerMain);
+		}
+	}
+
+	void AssetLoadQueue::Stop()
+	{
+		{
+			std::lock_guard lock(_decodeMutex);
+			_stopping = true;
+			_decodeJobs.clear();
+		}
+
+		_decodeCondition.notify_all();
+
+		for (auto& worker : _workers)
+		{
+			worker.join();
+		}
+
+		_workers.clear();
+
+		std::lock_guard lock(_uploadMutex);
+		_uploadJobs.clear();
+	}
+
+	void AssetLoadQueue::EnqueueDecode(Job job)
+	{
+		if (_workers.empty())
+		{
+			Start();
+		}
+
+		{
+			std::lock_guard lock(_decodeMutex);
+			_decodeJobs.push_back(std::move(job));
+		}
+
+		_decodeCondition.notify_one();
+	}
+
+	void AssetLoadQueue::EnqueueUpload(Job job)
+	{
+		std::lock_guard lock(_uploadMutex);
+		_uploadJobs.push_back(std::move(job));
+	}
+
+	size_t AssetLoadQueue::ProcessUploads(double budgetMilliseconds)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budgetMilliseconds));
+		size_t numProcessed = 0;
+
+		// Always run at least one upload so a tight budget can't starve the queue.
+		do
+		{
+			Job job;
+
+			{
+				std::lock_guard lock(_uploadMutex);
+				if (_uploadJobs.empty())
+				{
+					break;
+				}
+
+				job = std::move(_uploadJobs.front());
+				_uploadJobs.pop_front();
+			}
+
+			job();
+			numProcessed++;
+
+		} while (Clock::now() < deadline);
+
+		return numProcessed;
+	}
+
+	void AssetLoadQueue::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function)
+	{
+		grainSize = std::max(grainSize, (size_t)1);
+		size_t numChunks = (count + grainSize - 1) / grainSize;
+
+		if (numChunks <= 1 || _workers.empty())
+		{
+			if (count > 0)
+			{
+				function(0, count);
+			}
+
+			return;
+		}
+
+		struct Chunks
+		{
+			const std::function<void(size_t, size_t)>* function;
+			size_t count;
+			size_t grainSize;
+			size_t numChunks;
+			std::atomic<size_t> nextChunk = 0;
+			size_t numDone = 0;
+			std::mutex mutex;
+			std::condition_variable condition;
+
+			void Run()
+			{
+				for (size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+				{
+					size_t begin = chunk * grainSize;
+					(*function)(begin, std::min(begin + grainSize, count));
+
+					std::lock_guard lock(mutex);
+					if (++numDone == numChunks)
+					{
+						condition.notify_all();
+					}
+				}
+			}
+		};
+
+		auto chunks = std::make_shared<Chunks>();
+		chunks->function = &function;
+		chunks->count = count;
+		chunks->grainSize = grainSize;
+		chunks->numChunks = numChunks;
+
+		size_t numHelpers = std::min(numChunks - 1, _workers.size());
+
+		{
+			std::lock_guard lock(_decodeMutex);
+			for (size_t i = 0; i < numHelpers; ++i)
+			{
+				_decodeJobs.push_front([chunks]() { chunks->Run(); });
+			}
+		}
+
+		_decodeCondition.notify_all();
+
+		// Helpers that start after the last chunk is claimed return without touching the function.
+		chunks->Run();
+
+		std::unique_lock lock(chunks->mutex);
+		chunks->condition.wait(lock, [&chunks]() { return chunks->numDone == chunks->numChunks; });
+	}
+
+	size_t AssetLoadQueue::GetNumPendingDecodes()
+	{
+		std::lock_guard lock(_decodeMutex);
+		return _decodeJobs.size() + _numActiveDecodes;
+	}
+
+	size_t AssetLoadQueue::GetNumPendingUploads()
+	{
+		std::lock_guard lock(_uploadMutex);
+		return _uploadJobs.size();
+	}
+
+	void AssetLoadQueue::WorkerMain()
+	{
+		while (true)
+		{
+			Job job;
+
+			{
+				std::unique_lock lock(_decodeMutex);
+				_decodeCondition.wait(lock, [] { return _stopping || !_decodeJobs.empty(); });
+
+				if (_stopping)
+				{
+					return;
+				}
+
+				job = std::move(_decodeJobs.front());
+				_decodeJobs.pop_front();
+				_numActiveDecodes++;
+			}
+
+			job();
+
+			std::lock_guard lock(_decodeMutex);
+			_numActiveDecodes--;
+		}
+	}
+}
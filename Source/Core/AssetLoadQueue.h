@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Freeking
+{
+	class AssetLoadQueue
+	{
+	public:
+
+		using Job = std::function<void()>;
+
+		AssetLoadQueue() = delete;
+		~AssetLoadQueue() = delete;
+
+		static void Start(size_t numWorkers = 0);
+		static void Stop();
+
+		static void EnqueueDecode(Job job);
+		static void EnqueueUpload(Job job);
+		static size_t ProcessUploads(double budgetMilliseconds);
+
+		// Splits [0, count) into chunks of grainSize and runs them on the calling thread and
+		// any idle decode workers, returning once every chunk is done. Helper jobs go to the
+		// front of the queue, but the caller never waits on a chunk nobody has started, so it
+		// is safe to call from inside a decode job.
+		static void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function);
+
+		static size_t GetNumPendingDecodes();
+		static size_t GetNumPendingUploads();
+		static inline size_t GetNumWorkers() { return _workers.size(); }
+
+	private:
+
+		static void WorkerMain();
+
+		static std::vector<std::thread> _workers;
+		static std::deque<Job> _decodeJobs;
+		static std::deque<Job> _uploadJobs;
+		static std::mutex _decodeMutex;
+		static std::mutex _uploadMutex;
+		static std::condition_variable _decodeCondition;
+		static size_t _numActiveDecodes;
+		static bool _stopping;
+	};
+}
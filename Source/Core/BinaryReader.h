@@ -0,0 +1,154 @@
+#pragma once
+
+#include "FileView.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace Freeking
+{
+	// Bounds-checked reader over a byte range it does not own. Reads past the end leave the
+	// destination zeroed and put the reader into a failed state that sticks, so a loader can
+	// read a run of fields and check once. Values are copied out with memcpy, so the data
+	// does not need to be aligned.
+	class BinaryReader
+	{
+	public:
+
+		BinaryReader(const uint8_t* data, size_t size) :
+			_begin(data),
+			_end(data + size),
+			_position(data),
+			_failed(false)
+		{
+		}
+
+		explicit BinaryReader(const FileView& view) :
+			BinaryReader(view.data(), view.size())
+		{
+		}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryReader can only read trivially copyable types");
+
+			if (!Require(sizeof(T)))
+			{
+				value = T{};
+				return false;
+			}
+
+			std::memcpy(&value, _position, sizeof(T));
+			_position += sizeof(T);
+
+			return true;
+		}
+
+		template <typename T>
+		T Read()
+		{
+			T value;
+			Read(value);
+
+			return value;
+		}
+
+		bool ReadBytes(void* dest, size_t length)
+		{
+			if (!Require(length))
+			{
+				std::memset(dest, 0, length);
+				return false;
+			}
+
+			std::memcpy(dest, _position, length);
+			_position += length;
+
+			return true;
+		}
+
+		// Returns a pointer into the underlying data for count elements and skips over them,
+		// or nullptr if they do not fit. Only byte-aligned element types can be viewed in place.
+		template <typename T>
+		const T* ReadArray(size_t count)
+		{
+			static_assert(alignof(T) == 1, "Use Read<T>() for types that need alignment");
+
+			if (_failed || count > Remaining() / sizeof(T))
+			{
+				_failed = true;
+				return nullptr;
+			}
+
+			auto data = reinterpret_cast<const T*>(_position);
+			_position += count * sizeof(T);
+
+			return data;
+		}
+
+		// Reads a fixed-size, possibly unterminated, string field.
+		std::string ReadString(size_t length)
+		{
+			auto data = ReadArray<char>(length);
+			if (!data)
+			{
+				return {};
+			}
+
+			return std::string(data, strnlen(data, length));
+		}
+
+		bool Skip(size_t length)
+		{
+			if (!Require(length))
+			{
+				return false;
+			}
+
+			_position += length;
+
+			return true;
+		}
+
+		bool Seek(size_t position)
+		{
+			if (position > Size())
+			{
+				_failed = true;
+				return false;
+			}
+
+			_position = _begin + position;
+
+			return true;
+		}
+
+		inline const uint8_t* Data() const { return _position; }
+		inline size_t Position() const { return _position - _begin; }
+		inline size_t Size() const { return _end - _begin; }
+		inline size_t Remaining() const { return _end - _position; }
+		inline bool End() const { return _position == _end; }
+		inline bool Failed() const { return _failed; }
+		explicit inline operator bool() const { return !_failed; }
+
+	private:
+
+		inline bool Require(size_t length)
+		{
+			if (_failed || length > Remaining())
+			{
+				_failed = true;
+				return false;
+			}
+
+			return true;
+		}
+
+		const uint8_t* _begin;
+		const uint8_t* _end;
+		const uint8_t* _position;
+		bool _failed;
+	};
+}
@@ -0,0 +1,139 @@
+#include "FilePrefetcher.h"
+#include <fstream>
+#include <iostream>
+
+namespace Freeking
+{
+	bool FilePrefetcher::_enabled = true;
+	bool FilePrefetcher::_recording = false;
+	std::string FilePrefetcher::_name;
+	std::thread FilePrefetcher::_thread;
+	std::atomic<bool> FilePrefetcher::_cancel = false;
+	std::atomic<size_t> FilePrefetcher::_numPrefetchedFiles = 0;
+	std::atomic<size_t> FilePrefetcher::_numPrefetchedBytes = 0;
+	std::chrono::steady_clock::time_point FilePrefetcher::_loadStart;
+	double FilePrefetcher::_lastLoadTime = 0.0;
+
+	void FilePrefetcher::BeginLoad(const std::string& name)
+	{
+		if (IsLoading())
+		{
+			EndLoad();
+		}
+
+		_name = name;
+		_numPrefetchedFiles = 0;
+		_numPrefetchedBytes = 0;
+		_loadStart = std::chrono::steady_clock::now();
+
+		if (_enabled)
+		{
+			auto reads = ReadRecording(GetRecordingPath(name));
+
+			if (!reads.empty())
+			{
+				_cancel = false;
+				_thread = std::thread(PrefetchMain, std::move(reads));
+			}
+		}
+
+		if (_recording)
+		{
+			FileSystem::StartReadRecording();
+		}
+	}
+
+	void FilePrefetcher::EndLoad()
+	{
+		if (!IsLoading())
+		{
+			return;
+		}
+
+		_lastLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - _loadStart).count();
+
+		_cancel = true;
+
+		if (_thread.joinable())
+		{
+			_thread.join();
+		}
+
+		if (_recording)
+		{
+			auto reads = FileSystem::StopReadRecording();
+			WriteRecording(GetRecordingPath(_name), reads);
+
+			std::cout << "Recorded " << reads.size() << " file reads for " << _name << std::endl;
+		}
+
+		std::cout << "Loaded " << _name << " in " << _lastLoadTime << "s (" << _numPrefetchedFiles
+			<< " files prefetched, prefetch " << (_enabled ? "on" : "off") << ")" << std::endl;
+
+		_name.clear();
+	}
+
+	std::vector<FileRead> FilePrefetcher::GetRecordedReads(const std::string& name)
+	{
+		return ReadRecording(GetRecordingPath(name));
+	}
+
+	std::filesystem::path FilePrefetcher::GetRecordingPath(const std::string& name)
+	{
+		return std::filesystem::current_path() / "Cache" / (name + ".reads");
+	}
+
+	std::vector<FileRead> FilePrefetcher::ReadRecording(const std::filesystem::path& path)
+	{
+		std::vector<FileRead> reads;
+		std::ifstream file(path);
+
+		FileRead read;
+		while (file >> read.offset >> read.size && std::getline(file >> std::ws, read.path))
+		{
+			reads.push_back(read);
+		}
+
+		return reads;
+	}
+
+	void FilePrefetcher::WriteRecording(const std::filesystem::path& path, const std::vector<FileRead>& reads)
+	{
+		if (reads.empty())
+		{
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			std::cout << "Failed to write read recording " << path << std::endl;
+			return;
+		}
+
+		for (const auto& read : reads)
+		{
+			file << read.offset << ' ' << read.size << ' ' << read.path << '\n';
+		}
+	}
+
+	void FilePrefetcher::PrefetchMain(std::vector<FileRead> reads)
+	{
+		for (const auto& read : reads)
+		{
+			if (_cancel)
+			{
+				break;
+			}
+
+			if (auto size = FileSystem::Prefetch(read.path, read.offset, read.size))
+			{
+				_numPrefetchedFiles++;
+				_numPrefetchedBytes += size;
+			}
+		}
+	}
+}
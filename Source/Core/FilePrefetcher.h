@@ -0,0 +1,54 @@
+#pragma once
+
+#include "FileSystem.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace Freeking
+{
+	class FilePrefetcher
+	{
+	public:
+
+		FilePrefetcher() = delete;
+		~FilePrefetcher() = delete;
+
+		// Replays the reads recorded by an earlier load of the same name on a background thread.
+		// With recording on, this load's reads are saved for next time.
+		static void BeginLoad(const std::string& name);
+		static void EndLoad();
+
+		// The reads saved by the last recorded load of the name, empty if there are none.
+		static std::vector<FileRead> GetRecordedReads(const std::string& name);
+
+		static inline void SetEnabled(bool enabled) { _enabled = enabled; }
+		static inline bool IsEnabled() { return _enabled; }
+		static inline void SetRecording(bool recording) { _recording = recording; }
+		static inline bool IsRecording() { return _recording; }
+		static inline bool IsLoading() { return !_name.empty(); }
+
+		static inline size_t GetNumPrefetchedFiles() { return _numPrefetchedFiles; }
+		static inline size_t GetNumPrefetchedBytes() { return _numPrefetchedBytes; }
+		static inline double GetLastLoadTime() { return _lastLoadTime; }
+
+	private:
+
+		static std::filesystem::path GetRecordingPath(const std::string& name);
+		static std::vector<FileRead> ReadRecording(const std::filesystem::path& path);
+		static void WriteRecording(const std::filesystem::path& path, const std::vector<FileRead>& reads);
+		static void PrefetchMain(std::vector<FileRead> reads);
+
+		static bool _enabled;
+		static bool _recording;
+		static std::string _name;
+		static std::thread _thread;
+		static std::atomic<bool> _cancel;
+		static std::atomic<size_t> _numPrefetchedFiles;
+		static std::atomic<size_t> _numPrefetchedBytes;
+		static std::chrono::steady_clock::time_point _loadStart;
+		static double _lastLoadTime;
+	};
+}
@@ -1,42 +1,294 @@
 #include "FileSystem.h"
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 
 namespace Freeking
 {
 	std::vector<std::unique_ptr<IFileSystem>> FileSystem::_fileSystems = {};
+	std::unordered_map<std::string, FileSystem::IndexEntry> FileSystem::_index = {};
+	std::atomic<size_t> FileSystem::_numSyscalls = 0;
+	std::atomic<bool> FileSystem::_recordReads = false;
+	std::mutex FileSystem::_readRecordingMutex;
+	size_t FileSystem::_numReadRecorders = 0;
+	std::vector<FileRead> FileSystem::_recordedReads = {};
+	std::unordered_set<std::string> FileSystem::_recordedPaths = {};
+	std::ofstream FileSystem::_accessLog;
 
 	void FileSystem::AddFileSystem(std::unique_ptr<IFileSystem> fileSystem)
 	{
 		if (fileSystem)
 		{
+			AddToIndex(fileSystem.get());
 			_fileSystems.push_back(std::move(fileSystem));
 		}
 	}
 
-	bool FileSystem::FileExists(const std::string& filename)
+	void FileSystem::Refresh()
 	{
+		_index.clear();
+
 		for (const auto& fileSystem : _fileSystems)
 		{
-			if (fileSystem->FileExists(filename))
+			AddToIndex(fileSystem.get());
+		}
+	}
+
+	void FileSystem::AddToIndex(IFileSystem* fileSystem)
+	{
+		std::vector<std::string> files;
+		fileSystem->FindFiles("", "", files);
+
+		_index.reserve(_index.size() + files.size());
+
+		for (auto& filename : files)
+		{
+			auto path = NormalisePath(filename);
+
+			// Earlier mounts take priority, so an existing entry is never replaced.
+			_index.try_emplace(std::move(path), IndexEntry{ fileSystem, std::move(filename) });
+		}
+	}
+
+	std::string FileSystem::NormalisePath(std::string_view path)
+	{
+		std::string normalised(path);
+
+		for (auto& c : normalised)
+		{
+			if (c == '\\')
+			{
+				c = '/';
+			}
+			else if (c >= 'A' && c <= 'Z')
 			{
-				return true;
+				c += ('a' - 'A');
 			}
 		}
 
-		return false;
+		return normalised;
+	}
+
+	const FileSystem::IndexEntry* FileSystem::FindEntry(const std::string& path)
+	{
+		if (auto it = _index.find(path); it != _index.end())
+		{
+			return &it->second;
+		}
+
+		return nullptr;
+	}
+
+	bool FileSystem::FileExists(const std::string& filename)
+	{
+		return FindEntry(NormalisePath(filename)) != nullptr;
 	}
 
 	std::vector<uint8_t> FileSystem::GetFileData(const std::string& filename)
 	{
-		for (const auto& fileSystem : _fileSystems)
+		auto view = GetFileView(filename);
+
+		return std::vector<uint8_t>(view.begin(), view.end());
+	}
+
+	FileView FileSystem::GetFileView(const std::string& filename)
+	{
+		auto path = NormalisePath(filename);
+
+		if (auto entry = FindEntry(path))
 		{
-			if (fileSystem->FileExists(filename))
+			auto view = entry->fileSystem->GetFileView(entry->filename);
+
+			if (_recordReads)
 			{
-				return fileSystem->GetFileData(filename);
+				RecordRead(path, view.size());
 			}
+
+			return view;
 		}
 
 		return {};
 	}
+
+	size_t FileSystem::Prefetch(const std::string& filename, uint64_t offset, uint64_t size)
+	{
+		auto entry = FindEntry(NormalisePath(filename));
+		if (!entry)
+		{
+			return 0;
+		}
+
+		auto view = entry->fileSystem->GetFileView(entry->filename);
+		if (offset >= view.size())
+		{
+			return 0;
+		}
+
+		size = std::min<uint64_t>(size, view.size() - offset);
+		if (size == 0)
+		{
+			return 0;
+		}
+
+		// Touch one byte per page so the kernel faults the range in ahead of the loader.
+		static const size_t PageSize = 4096;
+		const volatile uint8_t* data = view.data() + offset;
+		uint8_t sum = 0;
+
+		for (uint64_t i = 0; i < size; i += PageSize)
+		{
+			sum += data[i];
+		}
+
+		sum += data[size - 1];
+		(void)sum;
+
+		return (size_t)size;
+	}
+
+	size_t FileSystem::Evict(const std::string& filename, uint64_t offset, uint64_t size)
+	{
+#if defined(_WIN32) || !defined(MADV_PAGEOUT)
+		return 0;
+#else
+		auto entry = FindEntry(NormalisePath(filename));
+		if (!entry)
+		{
+			return 0;
+		}
+
+		auto view = entry->fileSystem->GetFileView(entry->filename);
+		if (offset >= view.size())
+		{
+			return 0;
+		}
+
+		size = std::min<uint64_t>(size, view.size() - offset);
+		if (size == 0)
+		{
+			return 0;
+		}
+
+		// Page-out only reclaims pages this mapping has faulted in, so touch them first.
+		Prefetch(filename, offset, size);
+
+		static const uintptr_t PageMask = 4096 - 1;
+		auto begin = reinterpret_cast<uintptr_t>(view.data() + offset) & ~PageMask;
+		auto end = reinterpret_cast<uintptr_t>(view.data() + offset + size);
+
+		if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_PAGEOUT) != 0)
+		{
+			return 0;
+		}
+
+		return (size_t)size;
+#endif
+	}
+
+	void FileSystem::StartReadRecording()
+	{
+		std::lock_guard lock(_readRecordingMutex);
+
+		if (_numReadRecorders++ == 0)
+		{
+			_recordedReads.clear();
+			_recordedPaths.clear();
+			_recordReads = true;
+		}
+	}
+
+	std::vector<FileRead> FileSystem::StopReadRecording()
+	{
+		std::lock_guard lock(_readRecordingMutex);
+
+		if (_numReadRecorders == 0)
+		{
+			return {};
+		}
+
+		if (--_numReadRecorders > 0)
+		{
+			return _recordedReads;
+		}
+
+		_recordReads = false;
+		_recordedPaths.clear();
+
+		return std::move(_recordedReads);
+	}
+
+	void FileSystem::RecordRead(const std::string& path, uint64_t size)
+	{
+		std::lock_guard lock(_readRecordingMutex);
+
+		if (_recordReads && _recordedPaths.insert(path).second)
+		{
+			_recordedReads.push_back({ path, 0, size });
+		}
+	}
+
+	bool FileSystem::StartAccessLog(const std::filesystem::path& path)
+	{
+		if (_accessLog.is_open())
+		{
+			StopAccessLog();
+		}
+
+		_accessLog.open(path, std::ios::out | std::ios::trunc);
+		if (!_accessLog.is_open())
+		{
+			return false;
+		}
+
+		StartReadRecording();
+
+		return true;
+	}
+
+	void FileSystem::StopAccessLog()
+	{
+		if (!_accessLog.is_open())
+		{
+			return;
+		}
+
+		for (const auto& read : StopReadRecording())
+		{
+			_accessLog << read.path << '\n';
+		}
+
+		_accessLog.close();
+	}
+
+	std::vector<std::string> FileSystem::FindFiles(const std::string& directory, const std::string& extension)
+	{
+		std::vector<std::string> files;
+
+		auto prefix = NormalisePath(directory);
+		if (!prefix.empty() && prefix.back() != '/')
+		{
+			prefix += '/';
+		}
+
+		auto suffix = NormalisePath(extension);
+
+		for (const auto& [path, entry] : _index)
+		{
+			if (path.size() >= prefix.size() + suffix.size() &&
+				path.compare(0, prefix.size(), prefix) == 0 &&
+				path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0)
+			{
+				files.push_back(entry.filename);
+			}
+		}
+
+		std::sort(files.begin(), files.end());
+		files.erase(std::unique(files.begin(), files.end()), files.end());
+
+		return files;
+	}
 }
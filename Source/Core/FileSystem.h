@@ -4,6 +4,12 @@
 #include <string>
 #include <filesystem>
 #include <memory>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <unordered_set>
+#include "FileView.h"
 
 namespace Freeking
 {
@@ -16,6 +22,18 @@ namespace Freeking
 
 		virtual bool FileExists(const std::string& filename) = 0;
 		virtual std::vector<uint8_t> GetFileData(const std::string& filename) = 0;
+
+		// Returns an empty view when the file doesn't exist in this file system. Views
+		// into mounted archives stay valid for as long as the file system is mounted.
+		virtual FileView GetFileView(const std::string& filename) { return FileView(GetFileData(filename)); }
+		virtual void FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& files) = 0;
+	};
+
+	struct FileRead
+	{
+		std::string path;
+		uint64_t offset;
+		uint64_t size;
 	};
 
 	class FileSystem
@@ -28,9 +46,61 @@ namespace Freeking
 		static void AddFileSystem(std::unique_ptr<IFileSystem> fileSystem);
 		static bool FileExists(const std::string& filename);
 		static std::vector<uint8_t> GetFileData(const std::string& filename);
+		static FileView GetFileView(const std::string& filename);
+		static std::vector<std::string> FindFiles(const std::string& directory, const std::string& extension);
+
+		// Rebuilds the index, picking up files added to directory mounts since they were mounted.
+		// Not safe while other threads are reading files; the game only calls it when idle.
+		static void Refresh();
+
+		static std::string NormalisePath(std::string_view path);
+
+		// Records the first read of each file, with the byte range read, until stopped. Starts
+		// and stops nest, so the access log and the prefetcher can record at the same time;
+		// each stop returns everything recorded so far.
+		static void StartReadRecording();
+		static std::vector<FileRead> StopReadRecording();
+
+		// Writes the normalised paths from the read recording to a file when stopped. The game
+		// stops it once the first map has loaded. The cook tool uses the log to lay out archives
+		// in access order.
+		static bool StartAccessLog(const std::filesystem::path& path);
+		static void StopAccessLog();
+
+		// Pulls a byte range of a file into the page cache without recording the read.
+		static size_t Prefetch(const std::string& filename, uint64_t offset, uint64_t size);
+
+		// Asks the kernel to drop a byte range of a mapped file from memory, so the next read
+		// goes to disk. Best effort: pages mapped by another process stay, and it does nothing
+		// on Windows. Only meant for benchmarks. Returns the bytes it asked to drop.
+		static size_t Evict(const std::string& filename, uint64_t offset, uint64_t size);
+
+		static inline size_t GetNumIndexedFiles() { return _index.size(); }
+		static inline size_t GetNumSyscalls() { return _numSyscalls; }
+		static inline void AddSyscalls(size_t count) { _numSyscalls += count; }
 
 	private:
 
+		struct IndexEntry
+		{
+			IFileSystem* fileSystem;
+			std::string filename;
+		};
+
+		static void AddToIndex(IFileSystem* fileSystem);
+		static const IndexEntry* FindEntry(const std::string& path);
+		static void RecordRead(const std::string& path, uint64_t size);
+
 		static std::vector<std::unique_ptr<IFileSystem>> _fileSystems;
+		static std::unordered_map<std::string, IndexEntry> _index;
+		static std::atomic<size_t> _numSyscalls;
+
+		static std::atomic<bool> _recordReads;
+		static std::mutex _readRecordingMutex;
+		static size_t _numReadRecorders;
+		static std::vector<FileRead> _recordedReads;
+		static std::unordered_set<std::string> _recordedPaths;
+
+		static std::ofstream _accessLog;
 	};
 }
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+
+namespace Freeking
+{
+	// Read-only view of a file's contents. The view either points into a mapping owned
+	// by the file system that returned it, or keeps its own storage alive.
+	class FileView
+	{
+	public:
+
+		FileView() :
+			_data(nullptr),
+			_size(0)
+		{
+		}
+
+		FileView(const uint8_t* data, size_t size, std::shared_ptr<const void> owner = nullptr) :
+			_data(data),
+			_size(size),
+			_owner(std::move(owner))
+		{
+		}
+
+		explicit FileView(std::vector<uint8_t>&& data)
+		{
+			auto storage = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+			_data = storage->data();
+			_size = storage->size();
+			_owner = std::move(storage);
+		}
+
+		inline const uint8_t* data() const { return _data; }
+		inline size_t size() const { return _size; }
+		inline bool empty() const { return _size == 0; }
+		inline const uint8_t* begin() const { return _data; }
+		inline const uint8_t* end() const { return _data + _size; }
+
+	private:
+
+		const uint8_t* _data;
+		size_t _size;
+		std::shared_ptr<const void> _owner;
+	};
+}
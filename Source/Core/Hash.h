@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Freeking
+{
+	struct Hash
+	{
+		static constexpr uint32_t Fnv1a(const std::string_view& string)
+		{
+			uint32_t hash = 2166136261u;
+
+			for (char c : string)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 16777619u;
+			}
+
+			return hash;
+		}
+
+		static constexpr uint64_t Fnv1a64(const std::string_view& string)
+		{
+			uint64_t hash = 14695981039346656037ull;
+
+			for (char c : string)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+
+			return hash;
+		}
+
+		// Seeded variant with a final avalanche, for building hash families such as perfect hashes.
+		static constexpr uint32_t Fnv1a(const std::string_view& string, uint32_t seed)
+		{
+			uint32_t hash = 2166136261u ^ seed;
+
+			for (char c : string)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 16777619u;
+			}
+
+			hash ^= hash >> 16;
+			hash *= 0x85ebca6bu;
+			hash ^= hash >> 13;
+			hash *= 0xc2b2ae35u;
+			hash ^= hash >> 16;
+
+			return hash;
+		}
+	};
+}
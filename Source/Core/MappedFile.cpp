@@ -0,0 +1,99 @@
+#include "MappedFile.h"
+#include "FileSystem.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Freeking
+{
+	std::shared_ptr<MappedFile> MappedFile::Open(const std::filesystem::path& path)
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		FileSystem::AddSyscalls(1);
+
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return nullptr;
+		}
+
+		// Size query, mapping creation, view mapping and handle close.
+		FileSystem::AddSyscalls(4);
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+
+		if (!mapping)
+		{
+			return nullptr;
+		}
+
+		auto data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!data)
+		{
+			CloseHandle(mapping);
+			return nullptr;
+		}
+
+		return std::shared_ptr<MappedFile>(new MappedFile(data, (size_t)fileSize.QuadPart, mapping));
+#else
+		int file = open(path.c_str(), O_RDONLY);
+		FileSystem::AddSyscalls(1);
+
+		if (file < 0)
+		{
+			return nullptr;
+		}
+
+		// fstat, mmap and close.
+		FileSystem::AddSyscalls(3);
+
+		struct stat fileStat;
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			close(file);
+			return nullptr;
+		}
+
+		void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+
+		if (data == MAP_FAILED)
+		{
+			return nullptr;
+		}
+
+		return std::shared_ptr<MappedFile>(new MappedFile(static_cast<const uint8_t*>(data), (size_t)fileStat.st_size, nullptr));
+#endif
+	}
+
+	MappedFile::MappedFile(const uint8_t* data, size_t size, void* handle) :
+		_data(data),
+		_size(size),
+		_handle(handle)
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(_data);
+		CloseHandle(_handle);
+#else
+		munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+	}
+}
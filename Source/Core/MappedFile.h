@@ -0,0 +1,31 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+namespace Freeking
+{
+	class MappedFile
+	{
+	public:
+
+		static std::shared_ptr<MappedFile> Open(const std::filesystem::path& path);
+
+		MappedFile() = delete;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		inline const uint8_t* GetData() const { return _data; }
+		inline size_t GetSize() const { return _size; }
+
+	private:
+
+		MappedFile(const uint8_t* data, size_t size, void* handle);
+
+		const uint8_t* _data;
+		size_t _size;
+		void* _handle;
+	};
+}
@@ -0,0 +1,281 @@
+#include "Name.h"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cassert>
+#include <iostream>
+
+namespace Freeking
+{
+	class NameTable
+	{
+	public:
+
+		static NameTable& Get()
+		{
+			static NameTable table;
+			return table;
+		}
+
+		uint32_t Find(const std::string_view& string, uint32_t hash) const
+		{
+			const Table* table = _table.load(std::memory_order_acquire);
+
+			for (uint32_t i = hash & table->mask;; i = (i + 1) & table->mask)
+			{
+				uint32_t index = table->slots[i].load(std::memory_order_acquire);
+				if (index == 0)
+				{
+					return 0;
+				}
+
+				const Entry& entry = GetEntry(index);
+				if (entry.hash == hash && entry.ToStringView() == string)
+				{
+					return index;
+				}
+			}
+		}
+
+		uint32_t Add(const std::string_view& string)
+		{
+			if (string.empty())
+			{
+				return 0;
+			}
+
+			uint32_t hash = Hash::Fnv1a(string);
+
+			if (uint32_t index = Find(string, hash))
+			{
+				return index;
+			}
+
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			Table* table = _table.load(std::memory_order_relaxed);
+			uint32_t slot = hash & table->mask;
+
+			for (;; slot = (slot + 1) & table->mask)
+			{
+				uint32_t index = table->slots[slot].load(std::memory_order_relaxed);
+				if (index == 0)
+				{
+					break;
+				}
+
+				const Entry& entry = GetEntry(index);
+				if (entry.hash == hash)
+				{
+					if (entry.ToStringView() == string)
+					{
+						return index;
+					}
+
+					_numCollisions++;
+					std::cout << "Name hash collision between \"" << entry.ToStringView() << "\" and \"" << string << "\"" << std::endl;
+				}
+			}
+
+			uint32_t index = _numEntries.load(std::memory_order_relaxed);
+			assert(index < MaxChunks * ChunkSize);
+
+			uint32_t chunk = index / ChunkSize;
+			if (!_chunks[chunk].load(std::memory_order_relaxed))
+			{
+				_chunkStorage.push_back(std::make_unique<Entry[]>(ChunkSize));
+				_chunks[chunk].store(_chunkStorage.back().get(), std::memory_order_release);
+			}
+
+			Entry& entry = _chunks[chunk].load(std::memory_order_relaxed)[index % ChunkSize];
+			entry.chars = AllocateString(string);
+			entry.length = static_cast<uint32_t>(string.size());
+			entry.hash = hash;
+
+			_numEntries.store(index + 1, std::memory_order_release);
+
+			if ((index + 1) * 2 > table->mask)
+			{
+				Grow();
+			}
+			else
+			{
+				table->slots[slot].store(index, std::memory_order_release);
+			}
+
+			return index;
+		}
+
+		inline std::string_view ToStringView(uint32_t index) const
+		{
+			return GetEntry(index).ToStringView();
+		}
+
+		inline uint32_t GetHash(uint32_t index) const
+		{
+			return GetEntry(index).hash;
+		}
+
+		size_t GetCount() const { return _numEntries.load(std::memory_order_acquire) - 1; }
+		size_t GetCapacity() const { return _table.load(std::memory_order_acquire)->mask + 1; }
+		size_t GetStringBytes() const { std::lock_guard<std::mutex> lock(_mutex); return _stringBytes; }
+		size_t GetHashCollisions() const { std::lock_guard<std::mutex> lock(_mutex); return _numCollisions; }
+
+	private:
+
+		static constexpr uint32_t ChunkSize = 4096;
+		static constexpr uint32_t MaxChunks = 1024;
+		static constexpr size_t StringBlockSize = 64 * 1024;
+
+		struct Entry
+		{
+			const char* chars;
+			uint32_t length;
+			uint32_t hash;
+
+			inline std::string_view ToStringView() const { return std::string_view(chars, length); }
+		};
+
+		struct Table
+		{
+			explicit Table(uint32_t size) :
+				mask(size - 1),
+				slots(std::make_unique<std::atomic<uint32_t>[]>(size))
+			{
+				for (uint32_t i = 0; i < size; ++i)
+				{
+					slots[i].store(0, std::memory_order_relaxed);
+				}
+			}
+
+			uint32_t mask;
+			std::unique_ptr<std::atomic<uint32_t>[]> slots;
+		};
+
+		NameTable() :
+			_numEntries(1),
+			_stringBlockUsed(StringBlockSize),
+			_stringBytes(0),
+			_numCollisions(0)
+		{
+			for (auto& chunk : _chunks)
+			{
+				chunk.store(nullptr, std::memory_order_relaxed);
+			}
+
+			_chunkStorage.push_back(std::make_unique<Entry[]>(ChunkSize));
+			_chunkStorage.back()[0] = { "", 0, Hash::Fnv1a("") };
+			_chunks[0].store(_chunkStorage.back().get(), std::memory_order_release);
+
+			_tables.push_back(std::make_unique<Table>(1024));
+			_table.store(_tables.back().get(), std::memory_order_release);
+		}
+
+		inline const Entry& GetEntry(uint32_t index) const
+		{
+			return _chunks[index / ChunkSize].load(std::memory_order_acquire)[index % ChunkSize];
+		}
+
+		const char* AllocateString(const std::string_view& string)
+		{
+			size_t size = string.size() + 1;
+
+			if (_stringBlockUsed + size > StringBlockSize)
+			{
+				_stringBlocks.push_back(std::make_unique<char[]>(std::max(size, StringBlockSize)));
+				_stringBlockUsed = 0;
+			}
+
+			char* chars = _stringBlocks.back().get() + _stringBlockUsed;
+			string.copy(chars, string.size());
+			chars[string.size()] = 0;
+
+			_stringBlockUsed += size;
+			_stringBytes += size;
+
+			return chars;
+		}
+
+		// Old tables are kept alive because readers may still be probing them;
+		// a reader that misses on a stale table falls through to the locked path.
+		void Grow()
+		{
+			const Table* oldTable = _table.load(std::memory_order_relaxed);
+			auto table = std::make_unique<Table>((oldTable->mask + 1) * 2);
+			uint32_t numEntries = _numEntries.load(std::memory_order_relaxed);
+
+			for (uint32_t index = 1; index < numEntries; ++index)
+			{
+				for (uint32_t i = GetEntry(index).hash & table->mask;; i = (i + 1) & table->mask)
+				{
+					if (table->slots[i].load(std::memory_order_relaxed) == 0)
+					{
+						table->slots[i].store(index, std::memory_order_relaxed);
+						break;
+					}
+				}
+			}
+
+			_table.store(table.get(), std::memory_order_release);
+			_tables.push_back(std::move(table));
+		}
+
+		std::atomic<Entry*> _chunks[MaxChunks];
+		std::atomic<Table*> _table;
+		std::atomic<uint32_t> _numEntries;
+
+		mutable std::mutex _mutex;
+		std::vector<std::unique_ptr<Entry[]>> _chunkStorage;
+		std::vector<std::unique_ptr<Table>> _tables;
+		std::vector<std::unique_ptr<char[]>> _stringBlocks;
+		size_t _stringBlockUsed;
+		size_t _stringBytes;
+		size_t _numCollisions;
+	};
+
+	Name::Name(const std::string_view& string) :
+		_index(NameTable::Get().Add(string))
+	{
+	}
+
+	Name Name::Find(const std::string_view& string)
+	{
+		if (string.empty())
+		{
+			return Name();
+		}
+
+		return Name(NameTable::Get().Find(string, Hash::Fnv1a(string)));
+	}
+
+	std::string_view Name::ToStringView() const
+	{
+		return NameTable::Get().ToStringView(_index);
+	}
+
+	uint32_t Name::GetHash() const
+	{
+		return NameTable::Get().GetHash(_index);
+	}
+
+	size_t Name::GetCount()
+	{
+		return NameTable::Get().GetCount();
+	}
+
+	size_t Name::GetCapacity()
+	{
+		return NameTable::Get().GetCapacity();
+	}
+
+	size_t Name::GetStringBytes()
+	{
+		return NameTable::Get().GetStringBytes();
+	}
+
+	size_t Name::GetHashCollisions()
+	{
+		return NameTable::Get().GetHashCollisions();
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Hash.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <functional>
+
+namespace Freeking
+{
+	class Name
+	{
+	public:
+
+		constexpr Name() :
+			_index(0)
+		{
+		}
+
+		Name(const char* string) : Name(std::string_view(string)) {}
+		Name(const std::string& string) : Name(std::string_view(string)) {}
+		Name(const std::string_view& string);
+
+		static Name Find(const std::string_view& string);
+
+		std::string_view ToStringView() const;
+		std::string ToString() const { return std::string(ToStringView()); }
+		uint32_t GetHash() const;
+
+		inline uint32_t GetIndex() const { return _index; }
+		inline bool IsEmpty() const { return _index == 0; }
+
+		inline bool operator==(const Name& other) const { return _index == other._index; }
+		inline bool operator!=(const Name& other) const { return _index != other._index; }
+
+		static size_t GetCount();
+		static size_t GetCapacity();
+		static size_t GetStringBytes();
+		static size_t GetHashCollisions();
+
+	private:
+
+		explicit constexpr Name(uint32_t index) :
+			_index(index)
+		{
+		}
+
+		uint32_t _index;
+	};
+}
+
+namespace std
+{
+	template <>
+	struct hash<Freeking::Name>
+	{
+		size_t operator()(const Freeking::Name& name) const
+		{
+			return name.GetHash();
+		}
+	};
+}
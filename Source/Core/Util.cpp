@@ -36,33 +36,50 @@ namespace Freeking
 		return true;
 	}
 
-	bool Util::TryParseFloat(const std::string& s, float& v)
+	bool Util::TryParseFloat(const std::string_view& s, float& v)
 	{
 		return std::from_chars(s.data(), s.data() + s.size(), v, std::chars_format::general).ec == std::errc();
 	}
 
-	bool Util::TryParseInt(const std::string& s, int& v)
+	bool Util::TryParseInt(const std::string_view& s, int& v)
 	{
 		return std::from_chars(s.data(), s.data() + s.size(), v).ec == std::errc();
 	}
 
-	bool Util::TryParseVector(const std::string& s, Vector3f& v)
+	bool Util::TryParseVector(const std::string_view& s, Vector3f& v)
 	{
-		auto xyz = SplitString(s, " ");
-		if (xyz.size() != 3)
+		const char* it = s.data();
+		const char* end = s.data() + s.size();
+
+		float xyz[3];
+
+		for (float& f : xyz)
 		{
-			return false;
+			while (it != end && *it == ' ')
+			{
+				++it;
+			}
+
+			auto result = std::from_chars(it, end, f, std::chars_format::general);
+			if (result.ec != std::errc())
+			{
+				return false;
+			}
+
+			it = result.ptr;
+		}
+
+		while (it != end && *it == ' ')
+		{
+			++it;
 		}
 
-		float x, y, z;
-		if (!Util::TryParseFloat(xyz[0], x) ||
-			!Util::TryParseFloat(xyz[1], y) ||
-			!Util::TryParseFloat(xyz[2], z))
+		if (it != end)
 		{
 			return false;
 		}
 
-		v = Vector3f(x, y, z);
+		v = Vector3f(xyz[0], xyz[1], xyz[2]);
 
 		return true;
 	}
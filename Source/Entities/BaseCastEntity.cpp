@@ -1,4 +1,5 @@
 #include "BaseCastEntity.h"
+#include "CastModel.h"
 #include "Shader.h"
 #include "Renderer.h"
 #include "LineRenderer.h"
@@ -6,51 +7,194 @@
 
 namespace Freeking
 {
-	BaseCastEntity::BaseCastEntity()
+	static const std::array<std::string, 3> BodyParts =
 	{
+		"head",
+		"body",
+		"legs"
+	};
+
+	// Half extents of a box after transforming it by the matrix, grown to stay axis aligned.
+	static Vector3f TransformExtents(const Matrix4x4& matrix, const Vector3f& halfSize)
+	{
+		Vector3f extents;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			extents[axis] =
+				std::abs(matrix[0][axis]) * halfSize.x +
+				std::abs(matrix[1][axis]) * halfSize.y +
+				std::abs(matrix[2][axis]) * halfSize.z;
+		}
+
+		return extents;
+	}
+
+	BaseCastEntity::BaseCastEntity() :
+		_meshesResolved(false),
+		_skinLayers({ 0, 0, 0, 0 }),
+		_lod(0),
+		_partBodyParts({ 0, 0, 0, 0 }),
+		_hitBoundsMin(0),
+		_hitBoundsMax(0),
+		_hitboxFrame(0),
+		_hitboxNextFrame(0),
+		_hitboxDelta(-1.0f)
+	{
+		_animator.SetScheduled(true);
 	}
 
 	void BaseCastEntity::Initialize()
 	{
 		PrimitiveEntity::Initialize();
 
-		static const std::array<std::string, 3> bodyParts =
+		for (size_t bodyPartIndex = 0; bodyPartIndex < BodyParts.size(); ++bodyPartIndex)
 		{
-			"head",
-			"body",
-			"legs"
-		};
+			_meshRequests[bodyPartIndex] = DynamicModel::Library.GetAsync(_modelFolder + "/" + BodyParts[bodyPartIndex] + ".mdx");
+			_meshTextureRequests[bodyPartIndex] = Texture2D::Library.GetAsync(GetSkinPath(bodyPartIndex));
+		}
+
+		SetLocalBounds(Vector3f(-16, -24, -16), Vector3f(16, 50, 16));
+
+		ResolveMeshes();
+	}
+
+	std::string BaseCastEntity::GetSkinPath(size_t bodyPartIndex) const
+	{
+		const auto& bodyPart = BodyParts[bodyPartIndex];
 
-		int bodyPartIndex = 0;
-		for (const auto& bodyPart : bodyParts)
+		return _skinFolder[bodyPartIndex] + "/" + bodyPart + "_" + _artSkins[bodyPartIndex] + ".tga";
+	}
+
+	void BaseCastEntity::ResolveMeshes()
+	{
+		for (size_t i = 0; i < _meshRequests.size(); ++i)
 		{
-			if (auto mesh = DynamicModel::Library.Get(_modelFolder + "/" + bodyPart + ".mdx"))
+			if (_meshRequests[i].IsPending() || _meshTextureRequests[i].IsPending())
 			{
-				if (auto texture = Texture2D::Library.Get(_skinFolder[bodyPartIndex] + "/" + bodyPart + "_" + _artSkins[bodyPartIndex] + ".tga"))
-				{
-					_meshTextures.push_back(texture);
-					_meshes.push_back(mesh);
-				}
+				return;
+			}
+		}
+
+		// Casts with the same parts share a merged model, so the key records which loaded.
+		std::vector<std::shared_ptr<DynamicModel>> meshes;
+		std::vector<std::pair<std::string, std::shared_ptr<Texture2D>>> meshTextures;
+		std::string key = _modelFolder;
+
+		for (size_t i = 0; i < _meshRequests.size(); ++i)
+		{
+			if (_meshRequests[i].IsReady() && _meshTextureRequests[i].IsReady())
+			{
+				_partBodyParts[meshes.size()] = (int)i;
+				meshes.push_back(_meshRequests[i].Get());
+				meshTextures.push_back({ GetSkinPath(i), _meshTextureRequests[i].Get() });
+				key += ":" + std::to_string(i);
 			}
 
-			bodyPartIndex++;
+			_meshRequests[i] = {};
+			_meshTextureRequests[i] = {};
 		}
 
-		_shader = Shader::Library.DynamicModel;
+		_meshesResolved = true;
 
-		SetLocalBounds(Vector3f(-16, -24, -16), Vector3f(16, 50, 16));
+		if (meshes.empty())
+		{
+			return;
+		}
+
+		std::vector<const DynamicModel*> parts;
+		for (const auto& mesh : meshes)
+		{
+			parts.push_back(mesh.get());
+		}
+
+		_castModel = CastModel::Get(key, parts);
+		if (!_castModel)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < meshTextures.size(); ++i)
+		{
+			_skinLayers[i] = _castModel->GetSkinLayer(meshTextures[i].first, meshTextures[i].second);
+		}
 
-		for (const auto& frameAnimation : _meshes.front()->GetFrameAnimations())
+		for (const auto& frameAnimation : _castModel->GetModel()->GetFrameAnimations())
 		{
 			_animator.AddAnimation(frameAnimation.name, frameAnimation.firstFrame, frameAnimation.numFrames);
 		}
+
+		bool firstBounds = true;
+
+		for (const auto& subObjectBounds : _castModel->GetModel()->FrameBounds)
+		{
+			for (const auto& bounds : subObjectBounds)
+			{
+				for (const auto& corner : { bounds.boundsMin, bounds.boundsMax })
+				{
+					for (int axis = 0; axis < 3; ++axis)
+					{
+						_hitBoundsMin[axis] = firstBounds ? corner[axis] : std::min(_hitBoundsMin[axis], corner[axis]);
+						_hitBoundsMax[axis] = firstBounds ? corner[axis] : std::max(_hitBoundsMax[axis], corner[axis]);
+					}
+
+					firstBounds = false;
+				}
+			}
+		}
+	}
+
+	void BaseCastEntity::UpdateHitboxes()
+	{
+		_animator.Resolve();
+
+		size_t frame = _animator.GetFrame();
+		size_t nextFrame = _animator.GetNextFrame();
+		float delta = _animator.GetFrameDelta();
+
+		if (frame == _hitboxFrame && nextFrame == _hitboxNextFrame && delta == _hitboxDelta)
+		{
+			return;
+		}
+
+		_hitboxFrame = frame;
+		_hitboxNextFrame = nextFrame;
+		_hitboxDelta = delta;
+		_hitboxes.Clear();
+
+		for (const auto& subObjectBounds : _castModel->GetModel()->FrameBounds)
+		{
+			if (frame >= subObjectBounds.size() || nextFrame >= subObjectBounds.size())
+			{
+				_hitboxes.Add(Vector3f(0), Vector3f(0));
+				continue;
+			}
+
+			const auto& bounds = subObjectBounds[frame];
+			const auto& nextBounds = subObjectBounds[nextFrame];
+
+			_hitboxes.Add(
+				Vector3f::Lerp(bounds.boundsMin, nextBounds.boundsMin, delta),
+				Vector3f::Lerp(bounds.boundsMax, nextBounds.boundsMax, delta));
+		}
 	}
 
 	void BaseCastEntity::Tick(double dt)
 	{
 		PrimitiveEntity::Tick(dt);
 
-		_animator.Tick(dt);
+		if (!_meshesResolved)
+		{
+			ResolveMeshes();
+		}
+
+		if (!_castModel)
+		{
+			return;
+		}
+
+		auto center = GetPosition() + (GetLocalMinBounds() + GetLocalMaxBounds()) * 0.5f;
+		_animator.SetBounds(center, (GetLocalMaxBounds() - GetLocalMinBounds()).Length() * 0.5f, _hidden);
 
 		Vector3f traceStart = GetTransform().Translation() + Vector3f::Up * 70.0f;
 		Vector3f traceEnd = Renderer::ViewMatrix.InverseTranslation();
@@ -66,7 +210,7 @@ namespace Freeking
 	{
 		PrimitiveEntity::PostTick();
 
-		if (!_hidden && Renderer::DebugDraw)
+		if (!_hidden && _castModel && Renderer::DebugDraw)
 		{
 			const auto& viewMatrix = Renderer::ViewMatrix;
 			auto position = GetTransformCenter().Translation();
@@ -76,17 +220,16 @@ namespace Freeking
 			{
 				float alpha = 1.0f - (distance / 512.0f);
 
-				for (const auto& mesh : _meshes)
+				const auto& frameBounds = _castModel->GetModel()->FrameBounds;
+
+				for (int i = 0; i < frameBounds.size(); ++i)
 				{
-					for (int i = 0; i < mesh->FrameBounds.size(); ++i)
-					{
-						const auto& frameBounds = mesh->FrameBounds.at(i).at(_animator.GetFrame());
-						const auto& nextFrameBounds = mesh->FrameBounds.at(i).at(_animator.GetNextFrame());
-						auto boundsMin = Vector3f::Lerp(frameBounds.boundsMin, nextFrameBounds.boundsMin, _animator.GetFrameDelta());
-						auto boundsMax = Vector3f::Lerp(frameBounds.boundsMax, nextFrameBounds.boundsMax, _animator.GetFrameDelta());
+					const auto& bounds = frameBounds.at(i).at(_animator.GetFrame());
+					const auto& nextBounds = frameBounds.at(i).at(_animator.GetNextFrame());
+					auto boundsMin = Vector3f::Lerp(bounds.boundsMin, nextBounds.boundsMin, _animator.GetFrameDelta());
+					auto boundsMax = Vector3f::Lerp(bounds.boundsMax, nextBounds.boundsMax, _animator.GetFrameDelta());
 
-						LineRenderer::Debug->DrawBox(GetTransform(), boundsMin, boundsMax, LinearColor(0, 1, 1, alpha));
-					}
+					LineRenderer::Debug->DrawBox(GetTransform(), boundsMin, boundsMax, LinearColor(0, 1, 1, alpha));
 				}
 
 				LineRenderer::Debug->DrawAABBox(GetPosition(), GetLocalMinBounds(), GetLocalMaxBounds(), LinearColor(0, 1, 0, alpha));
@@ -94,37 +237,28 @@ namespace Freeking
 		}
 	}
 
-	void BaseCastEntity::PreRender(bool translucent)
+	void BaseCastEntity::Render(RenderQueue& queue)
 	{
-		_shader->Bind();
-		_shader->SetParameterValue("delta", _animator.GetFrameDelta());
-		_shader->SetParameterValue("modelMatrix", GetTransform());
-		_shader->SetParameterValue("normalBuffer", DynamicModel::GetNormalBuffer().get());
-	}
-
-	void BaseCastEntity::RenderOpaque()
-	{
-		for (size_t i = 0; i < _meshes.size(); ++i)
+		if (!_castModel)
 		{
-			const auto& mesh = _meshes.at(i);
-			const auto& meshTexture = _meshTextures.at(i);
+			return;
+		}
 
-			_shader->SetParameterValue("diffuse", meshTexture.get());
-			_shader->SetParameterValue("frameVertexBuffer", mesh->GetFrameVertexBuffer().get());
-			_shader->SetParameterValue("frames[0].index", (int)(_animator.GetFrame() * mesh->GetFrameVertexCount()));
-			_shader->SetParameterValue("frames[0].translate", mesh->FrameTransforms[_animator.GetFrame()].translate);
-			_shader->SetParameterValue("frames[0].scale", mesh->FrameTransforms[_animator.GetFrame()].scale);
-			_shader->SetParameterValue("frames[1].index", (int)(_animator.GetNextFrame() * mesh->GetFrameVertexCount()));
-			_shader->SetParameterValue("frames[1].translate", mesh->FrameTransforms[_animator.GetNextFrame()].translate);
-			_shader->SetParameterValue("frames[1].scale", mesh->FrameTransforms[_animator.GetNextFrame()].scale);
+		auto model = _castModel->GetModel();
+		auto center = GetPosition() + (GetLocalMinBounds() + GetLocalMaxBounds()) * 0.5f;
+		float radius = (GetLocalMaxBounds() - GetLocalMinBounds()).Length() * 0.5f;
+		_lod = model->SelectLod(DynamicModel::GetScreenSize(center, radius), _lod);
+		_animator.Resolve();
 
-			mesh->Draw();
-		}
+		auto& batch = Map::Current->GetDynamicModelBatch();
+		batch.Add(model, _castModel->GetSkins(), _skinLayers, GetTransform(), _animator.GetFrame(), _animator.GetNextFrame(), _animator.GetFrameDelta(), _lod);
 	}
 
 	bool BaseCastEntity::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("art_skins"))
+		switch (property.GetKeyId())
+		{
+		case "art_skins"_key:
 		{
 			std::vector<std::string> artSkins;
 			if (property.ValueAsStringArray(artSkins) && artSkins.size() == 3)
@@ -138,15 +272,61 @@ namespace Freeking
 
 			return false;
 		}
+		}
 
 		return PrimitiveEntity::SetProperty(property);
 	}
 
 	void BaseCastEntity::Trace(const Vector3f& start, const Vector3f& end, const Vector3f& mins, const Vector3f& maxs, TraceResult& trace, const BspContentFlags& brushMask)
 	{
-		if ( _hidden)
+		if (_hidden || !_castModel || !((uint32_t)brushMask & (uint32_t)BspContentFlags::Monster))
+		{
+			return;
+		}
+
+		// Reject on the box around every pose before looking at the current one.
+		const auto& transform = GetTransform();
+		auto boundsCenter = transform.TransformPoint((_hitBoundsMin + _hitBoundsMax) * 0.5f);
+		auto boundsExtents = TransformExtents(transform, (_hitBoundsMax - _hitBoundsMin) * 0.5f);
+
+		if (!HitboxSet::SegmentIntersectsBox(start, end, boundsCenter - boundsExtents - maxs, boundsCenter + boundsExtents - mins))
 		{
 			return;
 		}
+
+		UpdateHitboxes();
+
+		// The hitboxes share the entity's transform, so the trace moves into model space once.
+		auto inverse = transform.Inverse();
+		auto traceCenter = (mins + maxs) * 0.5f;
+		auto localStart = inverse.TransformPoint(start + traceCenter);
+		auto localEnd = inverse.TransformPoint(end + traceCenter);
+		auto localExtents = TransformExtents(inverse, (maxs - mins) * 0.5f);
+
+		float fraction;
+		size_t box;
+		Vector3f normal;
+
+		if (!_hitboxes.Trace(localStart, localEnd, localExtents, fraction, box, normal))
+		{
+			return;
+		}
+
+		trace.hit = true;
+		trace.fraction = fraction;
+		trace.planeNormal = (GetRotation() * normal).Normalise();
+		trace.startPosition = start;
+		trace.endPosition = start + ((end - start) * fraction);
+		trace.planeDistance = Vector3f::Dot(trace.planeNormal, trace.endPosition);
+		trace.axisU = Vector3f::Cross(trace.planeNormal, Vector3f::Up);
+
+		if (trace.axisU.Length() <= 0.0f)
+		{
+			trace.axisU = Vector3f::Cross(trace.planeNormal, Vector3f::Right);
+		}
+
+		trace.axisU = trace.axisU.Normalise();
+		trace.axisV = Vector3f::Cross(trace.axisU, trace.planeNormal).Normalise();
+		trace.hitPart = _partBodyParts[_castModel->GetModel()->GetBoundsPart(box)];
 	}
 }
@@ -2,13 +2,14 @@
 
 #include "PrimitiveEntity.h"
 #include "DynamicModel.h"
+#include "HitboxSet.h"
 #include <array>
 
 namespace Freeking
 {
 	class DynamicModel;
 	class Texture2D;
-	class Shader;
+	class CastModel;
 
 	class BaseCastEntity : public PrimitiveEntity
 	{
@@ -19,9 +20,10 @@ namespace Freeking
 		virtual void Initialize() override;
 		virtual void Tick(double dt) override;
 		virtual void PostTick() override;
-		virtual void PreRender(bool translucent) override;
-		virtual void RenderOpaque() override;
+		virtual void Render(RenderQueue& queue) override;
 
+		// Traces that collide with monsters hit the model's per sub-object boxes for the
+		// current pose. The hit part is the body part, 0 for the head, 1 the body, 2 the legs.
 		virtual void Trace(const Vector3f& start, const Vector3f& end, const Vector3f& mins, const Vector3f& maxs, TraceResult& trace, const BspContentFlags& brushMask) override;
 
 	protected:
@@ -34,9 +36,28 @@ namespace Freeking
 
 	private:
 
-		std::vector<std::shared_ptr<DynamicModel>> _meshes;
-		std::vector<std::shared_ptr<Texture2D>> _meshTextures;
-		std::shared_ptr<Shader> _shader;
+		void ResolveMeshes();
+		std::string GetSkinPath(size_t bodyPartIndex) const;
+		void UpdateHitboxes();
+
+		std::array<AssetRequest<DynamicModel>, 3> _meshRequests;
+		std::array<AssetRequest<Texture2D>, 3> _meshTextureRequests;
+		bool _meshesResolved;
+
+		std::shared_ptr<CastModel> _castModel;
+		std::array<int32_t, 4> _skinLayers;
+		size_t _lod;
+
+		// Body part of each part of the merged model, and the model space bounds of every
+		// sub-object over every frame, which the hitboxes never leave.
+		std::array<int, DynamicModel::MaxParts> _partBodyParts;
+		Vector3f _hitBoundsMin;
+		Vector3f _hitBoundsMax;
+
+		HitboxSet _hitboxes;
+		size_t _hitboxFrame;
+		size_t _hitboxNextFrame;
+		float _hitboxDelta;
 
 		FrameAnimator _animator;
 	};
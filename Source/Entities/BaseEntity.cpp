@@ -5,16 +5,29 @@
 namespace Freeking
 {
 	BaseEntity::BaseEntity() :
-		_timeSpawned(0)
+		_timeSpawned(0),
+		_release(nullptr)
 	{
 	}
 
+	void BaseEntity::Release()
+	{
+		if (_release)
+		{
+			_release(this);
+		}
+		else
+		{
+			delete this;
+		}
+	}
+
 	void BaseEntity::InitializeProperties(const EntityProperties& properties)
 	{
-		if (const auto& name = properties.GetNameProperty()) _name = name;
-		if (const auto& classname = properties.GetClassnameProperty()) _classname = classname;
-		if (const auto& targetname = properties.GetTargetnameProperty()) _targetname = targetname;
-		if (const auto& target = properties.GetTargetProperty()) _target = target;
+		if (const auto& name = properties.GetNameProperty()) _name = *name;
+		if (const auto& classname = properties.GetClassnameProperty()) _classname = *classname;
+		if (const auto& targetname = properties.GetTargetnameProperty()) _targetname = *targetname;
+		if (const auto& target = properties.GetTargetProperty()) _target = *target;
 
 		for (const auto& property : properties.GetKeyValues())
 		{
@@ -54,14 +67,11 @@ namespace Freeking
 		TriggerTarget();
 	}
 
-	void BaseEntity::TriggerTarget()
+	void BaseEntity::TriggerTarget(float delay)
 	{
-		if (!_target.empty())
+		if (!_target.IsEmpty())
 		{
-			for (const auto& targetEntity : Map::Current->GetTargetEntities(_target))
-			{
-				targetEntity->Trigger();
-			}
+			Map::Current->TriggerTargets(_handle, delay);
 		}
 	}
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "EntityLump.h"
+#include "EntityHandle.h"
+#include "EntityPool.h"
+#include "Name.h"
 #include "Vector.h"
 #include "Matrix4x4.h"
 #include "Quaternion.h"
@@ -9,12 +12,12 @@
 
 namespace Freeking
 {
+	class PrimitiveEntity;
+
 	class BaseEntity
 	{
 	public:
 
-		using SharedPtr = std::shared_ptr<BaseEntity>;
-
 		BaseEntity();
 		virtual ~BaseEntity() = default;
 
@@ -28,22 +31,39 @@ namespace Freeking
 		virtual void TakeDamage();
 		virtual void Trigger();
 
-		static SharedPtr Make(const std::string_view& classname);
+		virtual PrimitiveEntity* AsPrimitive() { return nullptr; }
+
+		inline const EntityHandle& GetHandle() const { return _handle; }
+		inline const Name& GetClassname() const { return _classname; }
+		inline const Name& GetTargetname() const { return _targetname; }
+		inline const Name& GetTarget() const { return _target; }
+
+		static BaseEntity* Make(const Name& classname);
+
+		void Release();
 
 	protected:
 
-		void TriggerTarget();
+		void TriggerTarget(float delay = 0.0f);
 
 		virtual void OnTakeDamage();
 		virtual void OnTrigger();
 
 		virtual bool SetProperty(const EntityProperty& property);
 
-		std::string _name;
-		std::string _classname;
-		std::string _targetname;
-		std::string _target;
+		Name _name;
+		Name _classname;
+		Name _targetname;
+		Name _target;
 
 		double _timeSpawned;
+
+	private:
+
+		template <typename T> friend class EntityPool;
+		friend class EntityList;
+
+		EntityHandle _handle;
+		void (*_release)(BaseEntity*);
 	};
 }
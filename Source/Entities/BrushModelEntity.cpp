@@ -46,7 +46,7 @@ namespace Freeking
 					screenPosition = Util::ScreenSpaceToPixelPosition(screenPosition, Vector4i(0, 0, (int)Renderer::ViewportWidth, (int)Renderer::ViewportHeight));
 					screenPosition.x = Math::Round(screenPosition.x);
 					screenPosition.y = Math::Round(screenPosition.y);
-					auto text = _classname + " (*" + std::to_string(_modelIndex) + ")";
+					auto text = _classname.ToString() + " (*" + std::to_string(_modelIndex) + ")";
 					SpriteBatch::Debug->DrawText(nullptr, text, screenPosition + Vector2f(2, 2), LinearColor(0, 0, 0, alpha), 0.5f);
 					SpriteBatch::Debug->DrawText(nullptr, text, screenPosition, LinearColor(0.5f, 1, 0.5f, alpha), 0.5f);
 				}
@@ -66,45 +66,19 @@ namespace Freeking
 		_shader = Shader::Library.Lightmapped.get();
 	}
 
-	void BrushModelEntity::PreRender(bool translucent)
+	void BrushModelEntity::Render(RenderQueue& queue)
 	{
-		if (_shader)
+		if (_model)
 		{
-			_shader->Bind();
-
-			if (translucent)
-			{
-				_shader->SetParameterValue("alphaCutOff", 0.0f);
-			}
-			else
-			{
-				_shader->SetParameterValue("alphaMultiply", 1.0f);
-			}
-
-			_shader->SetParameterValue("modelMatrix", GetTransform());
-		}
-	}
-
-	void BrushModelEntity::RenderOpaque()
-	{
-		if (_model && _shader && !HasSurf2Alpha())
-		{
-			_model->RenderOpaque(_shader);
-		}
-	}
-
-	void BrushModelEntity::RenderTranslucent()
-	{
-		if (_model && _shader)
-		{
-			_model->RenderTranslucent(_shader, HasSurf2Alpha());
+			_model->Render(queue, _shader, GetTransform(), HasSurf2Alpha());
 		}
 	}
 
 	bool BrushModelEntity::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("model"))
+		switch (property.GetKeyId())
 		{
+		case "model"_key:
 			return property.ValueAsModelIndex(_modelIndex);
 		}
 
@@ -16,9 +16,7 @@ namespace Freeking
 		virtual void Tick(double dt) override;
 		virtual void PostTick() override;
 
-		virtual void PreRender(bool translucent) override;
-		virtual void RenderOpaque() override;
-		virtual void RenderTranslucent() override;
+		virtual void Render(RenderQueue& queue) override;
 
 		virtual void Trace(const Vector3f& start, const Vector3f& end, const Vector3f& mins, const Vector3f& maxs, TraceResult& trace, const BspContentFlags& brushMask) override;
 
@@ -6,6 +6,8 @@
 
 namespace Freeking
 {
+	static AssetHandle<AudioClip> buttonSound(AudioClip::Library, "sound/world/switches/wheel.wav");
+
 	ButtonEntity::ButtonEntity() : BrushModelEntity(),
 		_speed(40.0f),
 		_angle(0.0f),
@@ -53,13 +55,14 @@ namespace Freeking
 		_pressed = true;
 		_timeToUnpress = Time::Now() + 3.0;
 
-		AudioDevice::Current->Play(AudioClip::Library.Get("sound/world/switches/wheel.wav").get(), GetTransformCenter().Translation());
+		AudioDevice::Current->Play(buttonSound.Get(), GetTransformCenter().Translation());
 	}
 
 	bool ButtonEntity::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("lip"))
+		switch (property.GetKeyId())
 		{
+		case "lip"_key:
 			return property.ValueAsFloat(_lip);
 		}
 
@@ -6,6 +6,8 @@
 
 namespace Freeking
 {
+	static AssetHandle<AudioClip> doorSound(AudioClip::Library, "sound/world/doors/dr5_strt.wav");
+
 	DoorEntity::DoorEntity() : BrushModelEntity(),
 		_speed(100.0f),
 		_angle(0.0f),
@@ -53,24 +55,23 @@ namespace Freeking
 		_open = true;
 		_timeToClose = Time::Now() + _wait;
 
-		AudioDevice::Current->Play(AudioClip::Library.Get("sound/world/doors/dr5_strt.wav").get(), GetTransformCenter().Translation());
+		AudioDevice::Current->Play(doorSound.Get(), GetTransformCenter().Translation());
 	}
 
 	void DoorEntity::Close()
 	{
 		_open = false;
 
-		AudioDevice::Current->Play(AudioClip::Library.Get("sound/world/doors/dr5_strt.wav").get(), GetTransformCenter().Translation());
+		AudioDevice::Current->Play(doorSound.Get(), GetTransformCenter().Translation());
 	}
 
 	bool DoorEntity::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("speed"))
+		switch (property.GetKeyId())
 		{
+		case "speed"_key:
 			return property.ValueAsFloat(_speed);
-		}
-		else if (property.IsKey("wait"))
-		{
+		case "wait"_key:
 			return property.ValueAsFloat(_wait);
 		}
 
@@ -5,6 +5,8 @@
 
 namespace Freeking
 {
+	static AssetHandle<AudioClip> doorSound(AudioClip::Library, "sound/world/doors/dr3_strt.wav");
+
 	DoorRotatingEntity::DoorRotatingEntity() : BrushModelEntity(),
 		_speed(100.0f),
 		_angle(0.0f),
@@ -44,28 +46,25 @@ namespace Freeking
 		_open = true;
 		_timeToClose = Time::Now() + _wait;
 
-		AudioDevice::Current->Play(AudioClip::Library.Get("sound/world/doors/dr3_strt.wav").get(), GetTransformCenter().Translation());
+		AudioDevice::Current->Play(doorSound.Get(), GetTransformCenter().Translation());
 	}
 
 	void DoorRotatingEntity::Close()
 	{
 		_open = false;
 
-		AudioDevice::Current->Play(AudioClip::Library.Get("sound/world/doors/dr3_strt.wav").get(), GetTransformCenter().Translation());
+		AudioDevice::Current->Play(doorSound.Get(), GetTransformCenter().Translation());
 	}
 
 	bool DoorRotatingEntity::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("speed"))
+		switch (property.GetKeyId())
 		{
+		case "speed"_key:
 			return property.ValueAsFloat(_speed);
-		}
-		else if (property.IsKey("distance"))
-		{
+		case "distance"_key:
 			return property.ValueAsFloat(_distance);
-		}
-		else if (property.IsKey("wait"))
-		{
+		case "wait"_key:
 			return property.ValueAsFloat(_wait);
 		}
 
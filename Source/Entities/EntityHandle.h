@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Freeking
+{
+	class EntityHandle
+	{
+	public:
+
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t MaxIndex = (1u << IndexBits) - 1;
+		static constexpr uint32_t MaxGeneration = (1u << (32 - IndexBits)) - 1;
+
+		constexpr EntityHandle() :
+			_value(0)
+		{
+		}
+
+		constexpr EntityHandle(uint32_t index, uint32_t generation) :
+			_value((generation << IndexBits) | (index & MaxIndex))
+		{
+		}
+
+		inline uint32_t GetIndex() const { return _value & MaxIndex; }
+		inline uint32_t GetGeneration() const { return _value >> IndexBits; }
+		inline uint32_t GetValue() const { return _value; }
+
+		inline bool IsValid() const { return _value != 0; }
+		inline explicit operator bool() const { return IsValid(); }
+
+		inline bool operator==(const EntityHandle& other) const { return _value == other._value; }
+		inline bool operator!=(const EntityHandle& other) const { return _value != other._value; }
+
+	private:
+
+		uint32_t _value;
+	};
+}
+
+namespace std
+{
+	template <>
+	struct hash<Freeking::EntityHandle>
+	{
+		size_t operator()(const Freeking::EntityHandle& handle) const
+		{
+			return std::hash<uint32_t>()(handle.GetValue());
+		}
+	};
+}
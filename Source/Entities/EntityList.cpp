@@ -0,0 +1,98 @@
+#include "EntityList.h"
+#include "PrimitiveEntity.h"
+#include <cassert>
+
+namespace Freeking
+{
+	EntityList::~EntityList()
+	{
+		Clear();
+	}
+
+	void EntityList::Reserve(size_t count)
+	{
+		_slots.reserve(count);
+		_freeSlots.reserve(count);
+		_entities.reserve(count);
+		_primitives.reserve(count);
+	}
+
+	EntityHandle EntityList::Add(BaseEntity* entity)
+	{
+		uint32_t index;
+
+		if (!_freeSlots.empty())
+		{
+			index = _freeSlots.back();
+			_freeSlots.pop_back();
+		}
+		else
+		{
+			assert(_slots.size() <= EntityHandle::MaxIndex);
+			index = static_cast<uint32_t>(_slots.size());
+			_slots.push_back({ nullptr, 1, InvalidIndex, InvalidIndex });
+		}
+
+		auto& slot = _slots[index];
+		slot.entity = entity;
+		slot.entityIndex = static_cast<uint32_t>(_entities.size());
+		_entities.push_back(entity);
+
+		if (auto primitive = entity->AsPrimitive())
+		{
+			slot.primitiveIndex = static_cast<uint32_t>(_primitives.size());
+			_primitives.push_back(primitive);
+		}
+
+		entity->_handle = EntityHandle(index, slot.generation);
+
+		return entity->_handle;
+	}
+
+	BaseEntity* EntityList::Remove(const EntityHandle& handle)
+	{
+		BaseEntity* entity = Get(handle);
+		if (!entity)
+		{
+			return nullptr;
+		}
+
+		auto& slot = _slots[handle.GetIndex()];
+
+		BaseEntity* movedEntity = _entities.back();
+		_entities[slot.entityIndex] = movedEntity;
+		_slots[movedEntity->_handle.GetIndex()].entityIndex = slot.entityIndex;
+		_entities.pop_back();
+
+		if (slot.primitiveIndex != InvalidIndex)
+		{
+			PrimitiveEntity* movedPrimitive = _primitives.back();
+			_primitives[slot.primitiveIndex] = movedPrimitive;
+			_slots[movedPrimitive->_handle.GetIndex()].primitiveIndex = slot.primitiveIndex;
+			_primitives.pop_back();
+		}
+
+		slot.entity = nullptr;
+		slot.entityIndex = InvalidIndex;
+		slot.primitiveIndex = InvalidIndex;
+		slot.generation = (slot.generation == EntityHandle::MaxGeneration) ? 1 : slot.generation + 1;
+		_freeSlots.push_back(handle.GetIndex());
+
+		entity->_handle = EntityHandle();
+
+		return entity;
+	}
+
+	void EntityList::Clear()
+	{
+		for (auto entity : _entities)
+		{
+			entity->Release();
+		}
+
+		_slots.clear();
+		_freeSlots.clear();
+		_entities.clear();
+		_primitives.clear();
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "EntityHandle.h"
+#include <vector>
+
+namespace Freeking
+{
+	class BaseEntity;
+	class PrimitiveEntity;
+
+	class EntityList
+	{
+	public:
+
+		EntityList() = default;
+		~EntityList();
+
+		EntityList(const EntityList&) = delete;
+		EntityList& operator=(const EntityList&) = delete;
+
+		void Reserve(size_t count);
+
+		EntityHandle Add(BaseEntity* entity);
+		BaseEntity* Remove(const EntityHandle& handle);
+		void Clear();
+
+		inline BaseEntity* Get(const EntityHandle& handle) const
+		{
+			uint32_t index = handle.GetIndex();
+
+			if (index < _slots.size() && _slots[index].generation == handle.GetGeneration())
+			{
+				return _slots[index].entity;
+			}
+
+			return nullptr;
+		}
+
+		inline const std::vector<BaseEntity*>& GetEntities() const { return _entities; }
+		inline const std::vector<PrimitiveEntity*>& GetPrimitives() const { return _primitives; }
+
+	private:
+
+		static constexpr uint32_t InvalidIndex = ~0u;
+
+		struct Slot
+		{
+			BaseEntity* entity;
+			uint32_t generation;
+			uint32_t entityIndex;
+			uint32_t primitiveIndex;
+		};
+
+		std::vector<Slot> _slots;
+		std::vector<uint32_t> _freeSlots;
+		std::vector<BaseEntity*> _entities;
+		std::vector<PrimitiveEntity*> _primitives;
+	};
+}
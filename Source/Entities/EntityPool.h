@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <new>
+
+namespace Freeking
+{
+	class BaseEntity;
+
+	template <typename T>
+	class EntityPool
+	{
+	public:
+
+		static T* Allocate()
+		{
+			auto& pool = Instance();
+
+			if (!pool._freeList)
+			{
+				pool.Grow(ChunkSize);
+			}
+
+			Slot* slot = pool._freeList;
+			pool._freeList = slot->next;
+			++pool._numAllocated;
+
+			T* entity = new (slot->storage) T();
+			entity->_release = &EntityPool::Release;
+
+			return entity;
+		}
+
+		static void Reserve(size_t count)
+		{
+			auto& pool = Instance();
+			size_t numFree = pool._capacity - pool._numAllocated;
+
+			if (count > numFree)
+			{
+				pool.Grow(count - numFree);
+			}
+		}
+
+		static size_t GetNumAllocated() { return Instance()._numAllocated; }
+		static size_t GetCapacity() { return Instance()._capacity; }
+
+	private:
+
+		static constexpr size_t ChunkSize = 16;
+
+		union Slot
+		{
+			Slot* next;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		EntityPool() :
+			_freeList(nullptr),
+			_numAllocated(0),
+			_capacity(0)
+		{
+		}
+
+		static EntityPool& Instance()
+		{
+			static EntityPool pool;
+			return pool;
+		}
+
+		static void Release(BaseEntity* entity)
+		{
+			auto& pool = Instance();
+
+			T* object = static_cast<T*>(entity);
+			object->~T();
+
+			Slot* slot = reinterpret_cast<Slot*>(object);
+			slot->next = pool._freeList;
+			pool._freeList = slot;
+			--pool._numAllocated;
+		}
+
+		void Grow(size_t count)
+		{
+			auto chunk = std::make_unique<Slot[]>(count);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				chunk[i].next = (i + 1 < count) ? &chunk[i + 1] : _freeList;
+			}
+
+			_freeList = &chunk[0];
+			_capacity += count;
+			_chunks.push_back(std::move(chunk));
+		}
+
+		std::vector<std::unique_ptr<Slot[]>> _chunks;
+		Slot* _freeList;
+		size_t _numAllocated;
+		size_t _capacity;
+	};
+}
@@ -291,291 +291,291 @@
 
 namespace Freeking
 {
-	BaseEntity::SharedPtr make_item_health() { return std::make_shared<Entity::Item::AHealth>(); }
-	BaseEntity::SharedPtr make_item_health_small() { return std::make_shared<Entity::Item::AHealthSmall>(); }
-	BaseEntity::SharedPtr make_item_health_large() { return std::make_shared<Entity::Item::AHealthLarge>(); }
-	BaseEntity::SharedPtr make_item_health_mega() { return std::make_shared<Entity::Item::AHealthMega>(); }
-	BaseEntity::SharedPtr make_info_player_start() { return std::make_shared<Entity::Info::APlayerStart>(); }
-	BaseEntity::SharedPtr make_info_player_deathmatch() { return std::make_shared<Entity::Info::APlayerDeathmatch>(); }
-	BaseEntity::SharedPtr make_info_player_coop() { return std::make_shared<Entity::Info::APlayerCoop>(); }
-	BaseEntity::SharedPtr make_info_player_intermission() { return std::make_shared<Entity::Info::APlayerIntermission>(); }
-	BaseEntity::SharedPtr make_func_plat() { return std::make_shared<Entity::Func::APlat>(); }
-	BaseEntity::SharedPtr make_func_button() { return std::make_shared<Entity::Func::AButton>(); }
-	BaseEntity::SharedPtr make_func_door() { return std::make_shared<Entity::Func::ADoor>(); }
-	BaseEntity::SharedPtr make_func_door_secret() { return std::make_shared<Entity::Func::ADoorSecret>(); }
-	BaseEntity::SharedPtr make_func_door_rotating() { return std::make_shared<Entity::Func::ADoorRotating>(); }
-	BaseEntity::SharedPtr make_func_rotating() { return std::make_shared<Entity::Func::ARotating>(); }
-	BaseEntity::SharedPtr make_func_train() { return std::make_shared<Entity::Func::ATrain>(); }
-	BaseEntity::SharedPtr make_func_water() { return std::make_shared<Entity::Func::AWater>(); }
-	BaseEntity::SharedPtr make_func_conveyor() { return std::make_shared<Entity::Func::AConveyor>(); }
-	BaseEntity::SharedPtr make_func_areaportal() { return std::make_shared<Entity::Func::AAreaportal>(); }
-	BaseEntity::SharedPtr make_func_clock() { return std::make_shared<Entity::Func::AClock>(); }
-	BaseEntity::SharedPtr make_func_wall() { return std::make_shared<Entity::Func::AWall>(); }
-	BaseEntity::SharedPtr make_func_object() { return std::make_shared<Entity::Func::AObject>(); }
-	BaseEntity::SharedPtr make_func_timer() { return std::make_shared<Entity::Func::ATimer>(); }
-	BaseEntity::SharedPtr make_func_explosive() { return std::make_shared<Entity::Func::AExplosive>(); }
-	BaseEntity::SharedPtr make_func_killbox() { return std::make_shared<Entity::Func::AKillbox>(); }
-	BaseEntity::SharedPtr make_func_object_repair() { return std::make_shared<Entity::Func::AObjectRepair>(); }
-	BaseEntity::SharedPtr make_rotating_light() { return std::make_shared<Entity::Rotating::ALight>(); }
-	BaseEntity::SharedPtr make_trigger_always() { return std::make_shared<Entity::Trigger::AAlways>(); }
-	BaseEntity::SharedPtr make_trigger_once() { return std::make_shared<Entity::Trigger::AOnce>(); }
-	BaseEntity::SharedPtr make_trigger_multiple() { return std::make_shared<Entity::Trigger::AMultiple>(); }
-	BaseEntity::SharedPtr make_trigger_relay() { return std::make_shared<Entity::Trigger::ARelay>(); }
-	BaseEntity::SharedPtr make_trigger_push() { return std::make_shared<Entity::Trigger::APush>(); }
-	BaseEntity::SharedPtr make_trigger_hurt() { return std::make_shared<Entity::Trigger::AHurt>(); }
-	BaseEntity::SharedPtr make_trigger_key() { return std::make_shared<Entity::Trigger::AKey>(); }
-	BaseEntity::SharedPtr make_trigger_counter() { return std::make_shared<Entity::Trigger::ACounter>(); }
-	BaseEntity::SharedPtr make_trigger_elevator() { return std::make_shared<Entity::Trigger::AElevator>(); }
-	BaseEntity::SharedPtr make_trigger_gravity() { return std::make_shared<Entity::Trigger::AGravity>(); }
-	BaseEntity::SharedPtr make_trigger_monsterjump() { return std::make_shared<Entity::Trigger::AMonsterjump>(); }
-	BaseEntity::SharedPtr make_target_temp_entity() { return std::make_shared<Entity::Target::ATempEntity>(); }
-	BaseEntity::SharedPtr make_target_speaker() { return std::make_shared<Entity::Target::ASpeaker>(); }
-	BaseEntity::SharedPtr make_target_explosion() { return std::make_shared<Entity::Target::AExplosion>(); }
-	BaseEntity::SharedPtr make_target_changelevel() { return std::make_shared<Entity::Target::AChangelevel>(); }
-	BaseEntity::SharedPtr make_target_secret() { return std::make_shared<Entity::Target::ASecret>(); }
-	BaseEntity::SharedPtr make_target_goal() { return std::make_shared<Entity::Target::AGoal>(); }
-	BaseEntity::SharedPtr make_target_splash() { return std::make_shared<Entity::Target::ASplash>(); }
-	BaseEntity::SharedPtr make_target_spawner() { return std::make_shared<Entity::Target::ASpawner>(); }
-	BaseEntity::SharedPtr make_target_blaster() { return std::make_shared<Entity::Target::ABlaster>(); }
-	BaseEntity::SharedPtr make_target_crosslevel_trigger() { return std::make_shared<Entity::Target::ACrosslevelTrigger>(); }
-	BaseEntity::SharedPtr make_target_crosslevel_target() { return std::make_shared<Entity::Target::ACrosslevelTarget>(); }
-	BaseEntity::SharedPtr make_target_laser() { return std::make_shared<Entity::Target::ALaser>(); }
-	BaseEntity::SharedPtr make_target_lightramp() { return std::make_shared<Entity::Target::ALightramp>(); }
-	BaseEntity::SharedPtr make_target_earthquake() { return std::make_shared<Entity::Target::AEarthquake>(); }
-	BaseEntity::SharedPtr make_target_character() { return std::make_shared<Entity::Target::ACharacter>(); }
-	BaseEntity::SharedPtr make_target_string() { return std::make_shared<Entity::Target::AString>(); }
-	BaseEntity::SharedPtr make_target_mal_laser() { return std::make_shared<Entity::Target::AMalLaser>(); }
-	BaseEntity::SharedPtr make_worldspawn() { return std::make_shared<Entity::AWorldspawn>(); }
-	BaseEntity::SharedPtr make_viewthing() { return std::make_shared<Entity::AViewthing>(); }
-	BaseEntity::SharedPtr make_light() { return std::make_shared<Entity::ALight>(); }
-	BaseEntity::SharedPtr make_light_mine1() { return std::make_shared<Entity::Light::AMine1>(); }
-	BaseEntity::SharedPtr make_light_mine2() { return std::make_shared<Entity::Light::AMine2>(); }
-	BaseEntity::SharedPtr make_info_null() { return std::make_shared<Entity::Info::ANull>(); }
-	BaseEntity::SharedPtr make_func_group() { return std::make_shared<Entity::Func::AGroup>(); }
-	BaseEntity::SharedPtr make_info_notnull() { return std::make_shared<Entity::Info::ANotnull>(); }
-	BaseEntity::SharedPtr make_path_corner() { return std::make_shared<Entity::Path::ACorner>(); }
-	BaseEntity::SharedPtr make_junior() { return std::make_shared<Entity::AJunior>(); }
-	BaseEntity::SharedPtr make_misc_explobox() { return std::make_shared<Entity::Misc::AExplobox>(); }
-	BaseEntity::SharedPtr make_misc_gib_arm() { return std::make_shared<Entity::Misc::AGibArm>(); }
-	BaseEntity::SharedPtr make_misc_gib_leg() { return std::make_shared<Entity::Misc::AGibLeg>(); }
-	BaseEntity::SharedPtr make_misc_gib_head() { return std::make_shared<Entity::Misc::AGibHead>(); }
-	BaseEntity::SharedPtr make_misc_teleporter() { return std::make_shared<Entity::Misc::ATeleporter>(); }
-	BaseEntity::SharedPtr make_misc_teleporter_dest() { return std::make_shared<Entity::Misc::ATeleporterDest>(); }
-	BaseEntity::SharedPtr make_misc_amb4() { return std::make_shared<Entity::Misc::AAmb4>(); }
-	BaseEntity::SharedPtr make_cast_punk() { return std::make_shared<Entity::Cast::APunk>(); }
-	BaseEntity::SharedPtr make_cast_thug() { return std::make_shared<Entity::Cast::AThug>(); }
-	BaseEntity::SharedPtr make_cast_thug_sit() { return std::make_shared<Entity::Cast::AThugSit>(); }
-	BaseEntity::SharedPtr make_cast_bitch() { return std::make_shared<Entity::Cast::ABitch>(); }
-	BaseEntity::SharedPtr make_cast_dog() { return std::make_shared<Entity::Cast::ADog>(); }
-	BaseEntity::SharedPtr make_cast_runt() { return std::make_shared<Entity::Cast::ARunt>(); }
-	BaseEntity::SharedPtr make_cast_bum_sit() { return std::make_shared<Entity::Cast::ABumSit>(); }
-	BaseEntity::SharedPtr make_cast_shorty() { return std::make_shared<Entity::Cast::AShorty>(); }
-	BaseEntity::SharedPtr make_cast_whore() { return std::make_shared<Entity::Cast::AWhore>(); }
-	BaseEntity::SharedPtr make_cast_punk_window() { return std::make_shared<Entity::Cast::APunkWindow>(); }
-	BaseEntity::SharedPtr make_cast_punk2() { return std::make_shared<Entity::Cast::APunk2>(); }
-	BaseEntity::SharedPtr make_cast_rosie() { return std::make_shared<Entity::Cast::ARosie>(); }
-	BaseEntity::SharedPtr make_ai_boundary() { return std::make_shared<Entity::Ai::ABoundary>(); }
-	BaseEntity::SharedPtr make_ai_event_hostile() { return std::make_shared<Entity::Ai::AEventHostile>(); }
-	BaseEntity::SharedPtr make_ai_event_follow() { return std::make_shared<Entity::Ai::AEventFollow>(); }
-	BaseEntity::SharedPtr make_ai_guard() { return std::make_shared<Entity::Ai::AGuard>(); }
-	BaseEntity::SharedPtr make_ai_territory() { return std::make_shared<Entity::Ai::ATerritory>(); }
-	BaseEntity::SharedPtr make_ai_trigger_character() { return std::make_shared<Entity::Ai::ATriggerCharacter>(); }
-	BaseEntity::SharedPtr make_ai_locked_door() { return std::make_shared<Entity::Ai::ALockedDoor>(); }
-	BaseEntity::SharedPtr make_misc_skidrow_radio() { return std::make_shared<Entity::Misc::ASkidrowRadio>(); }
-	BaseEntity::SharedPtr make_misc_skidrow_ambush() { return std::make_shared<Entity::Misc::ASkidrowAmbush>(); }
-	BaseEntity::SharedPtr make_misc_skidrow_radio_repeater() { return std::make_shared<Entity::Misc::ASkidrowRadioRepeater>(); }BaseEntity::SharedPtr make_ai_ty_fuseblown() { return std::make_shared<Entity::Ai::ATyFuseblown>(); }
-	BaseEntity::SharedPtr make_ai_moker_notinoffice() { return std::make_shared<Entity::Ai::AMokerNotinoffice>(); }
-	BaseEntity::SharedPtr make_misc_grunt() { return std::make_shared<Entity::Misc::AGrunt>(); }
-	BaseEntity::SharedPtr make_misc_fidelA() { return std::make_shared<Entity::Misc::AFidela>(); }
-	BaseEntity::SharedPtr make_misc_car() { return std::make_shared<Entity::Misc::ACar>(); }
-	BaseEntity::SharedPtr make_misc_smoke() { return std::make_shared<Entity::Misc::ASmoke>(); }
-	BaseEntity::SharedPtr make_elps() { return std::make_shared<Entity::AElps>(); }
-	BaseEntity::SharedPtr make_misc_alarm() { return std::make_shared<Entity::Misc::AAlarm>(); }
-	BaseEntity::SharedPtr make_trigger_hurt_electric() { return std::make_shared<Entity::Trigger::AHurtElectric>(); }
-	BaseEntity::SharedPtr make_pawn_o_matic() { return std::make_shared<Entity::Pawn::AOMatic>(); }
-	BaseEntity::SharedPtr make_ai_safespot() { return std::make_shared<Entity::Ai::ASafespot>(); }
-	BaseEntity::SharedPtr make_misc_skidrow_ai_reset() { return std::make_shared<Entity::Misc::ASkidrowAiReset>(); }
-	BaseEntity::SharedPtr make_ai_combat_spot() { return std::make_shared<Entity::Ai::ACombatSpot>(); }
-	BaseEntity::SharedPtr make_misc_skidrow_afraid() { return std::make_shared<Entity::Misc::ASkidrowAfraid>(); }
-	BaseEntity::SharedPtr make_misc_steeltown_afraid() { return std::make_shared<Entity::Misc::ASteeltownAfraid>(); }
-	BaseEntity::SharedPtr make_misc_kroker_afraid() { return std::make_shared<Entity::Misc::AKrokerAfraid>(); }
-	BaseEntity::SharedPtr make_rc_initiation_observer() { return std::make_shared<Entity::Rc::AInitiationObserver>(); }
-	BaseEntity::SharedPtr make_rc_initiation_brush() { return std::make_shared<Entity::Rc::AInitiationBrush>(); }
-	BaseEntity::SharedPtr make_misc_pv_afraid() { return std::make_shared<Entity::Misc::APvAfraid>(); }
-	BaseEntity::SharedPtr make_misc_ty_afraid() { return std::make_shared<Entity::Misc::ATyAfraid>(); }
-	BaseEntity::SharedPtr make_ai_ty_mo_boundry() { return std::make_shared<Entity::Ai::ATyMoBoundry>(); }
-	BaseEntity::SharedPtr make_ai_sy_dykes_boundry() { return std::make_shared<Entity::Ai::ASyDykesBoundry>(); }
-	BaseEntity::SharedPtr make_misc_sy_afraid() { return std::make_shared<Entity::Misc::ASyAfraid>(); }
-	BaseEntity::SharedPtr make_ep_skidrow_flag() { return std::make_shared<Entity::Ep::ASkidrowFlag>(); }
-	BaseEntity::SharedPtr make_ai_sy_oilcan() { return std::make_shared<Entity::Ai::ASyOilcan>(); }
-	BaseEntity::SharedPtr make_ai_ty_valvehandle() { return std::make_shared<Entity::Ai::ATyValvehandle>(); }
-	BaseEntity::SharedPtr make_ai_pv_fuseblown1() { return std::make_shared<Entity::Ai::APvFuseblown1>(); }
-	BaseEntity::SharedPtr make_ai_pv_fuseblown2() { return std::make_shared<Entity::Ai::APvFuseblown2>(); }
-	BaseEntity::SharedPtr make_ai_pv_deadlouie() { return std::make_shared<Entity::Ai::APvDeadlouie>(); }
-	BaseEntity::SharedPtr make_ai_sy_blefty() { return std::make_shared<Entity::Ai::ASyBlefty>(); }
-	BaseEntity::SharedPtr make_misc_barry_bitch() { return std::make_shared<Entity::Misc::ABarryBitch>(); }
-	BaseEntity::SharedPtr make_misc_corky_fidel_mdx_pcx() { return std::make_shared<Entity::Misc::ACorkyFidelMdxPcx>(); }
-	BaseEntity::SharedPtr make_misc_corky_fidel_mdx_tga() { return std::make_shared<Entity::Misc::ACorkyFidelMdxTga>(); }
-	BaseEntity::SharedPtr make_misc_cut_scene() { return std::make_shared<Entity::Misc::ACutScene>(); }
-	BaseEntity::SharedPtr make_light_fire_esm() { return std::make_shared<Entity::Light::AFireEsm>(); }
-	BaseEntity::SharedPtr make_light_fire_sm() { return std::make_shared<Entity::Light::AFireSm>(); }
-	BaseEntity::SharedPtr make_light_fire_med() { return std::make_shared<Entity::Light::AFireMed>(); }
-	BaseEntity::SharedPtr make_light_fire_lg() { return std::make_shared<Entity::Light::AFireLg>(); }
-	BaseEntity::SharedPtr make_smoke_esm() { return std::make_shared<Entity::Smoke::AEsm>(); }
-	BaseEntity::SharedPtr make_smoke_sm() { return std::make_shared<Entity::Smoke::ASm>(); }
-	BaseEntity::SharedPtr make_smoke_med() { return std::make_shared<Entity::Smoke::AMed>(); }
-	BaseEntity::SharedPtr make_smoke_lg() { return std::make_shared<Entity::Smoke::ALg>(); }
-	BaseEntity::SharedPtr make_func_train_rotating() { return std::make_shared<Entity::Func::ATrainRotating>(); }
-	BaseEntity::SharedPtr make_func_subdoor_base() { return std::make_shared<Entity::Func::ASubdoorBase>(); }
-	BaseEntity::SharedPtr make_func_subdoor_handle1() { return std::make_shared<Entity::Func::ASubdoorHandle1>(); }
-	BaseEntity::SharedPtr make_func_subdoor_handle2() { return std::make_shared<Entity::Func::ASubdoorHandle2>(); }
-	BaseEntity::SharedPtr make_props_trashcanA() { return std::make_shared<Entity::Props::ATrashcana>(); }
-	BaseEntity::SharedPtr make_props_trashcan_fall() { return std::make_shared<Entity::Props::ATrashcanFall>(); }
-	BaseEntity::SharedPtr make_props_hydrant() { return std::make_shared<Entity::Props::AHydrant>(); }
-	BaseEntity::SharedPtr make_props_antenna1a() { return std::make_shared<Entity::Props::AAntenna1a>(); }
-	BaseEntity::SharedPtr make_props_antenna1b() { return std::make_shared<Entity::Props::AAntenna1b>(); }
-	BaseEntity::SharedPtr make_props_antenna1c() { return std::make_shared<Entity::Props::AAntenna1c>(); }
-	BaseEntity::SharedPtr make_props_antenna2a() { return std::make_shared<Entity::Props::AAntenna2a>(); }
-	BaseEntity::SharedPtr make_props_antenna2b() { return std::make_shared<Entity::Props::AAntenna2b>(); }
-	BaseEntity::SharedPtr make_props_antenna2c() { return std::make_shared<Entity::Props::AAntenna2c>(); }
-	BaseEntity::SharedPtr make_props_antenna3a() { return std::make_shared<Entity::Props::AAntenna3a>(); }
-	BaseEntity::SharedPtr make_props_antenna3b() { return std::make_shared<Entity::Props::AAntenna3b>(); }
-	BaseEntity::SharedPtr make_props_antenna3c() { return std::make_shared<Entity::Props::AAntenna3c>(); }
-	BaseEntity::SharedPtr make_props_fan() { return std::make_shared<Entity::Props::AFan>(); }
-	BaseEntity::SharedPtr make_props_phone() { return std::make_shared<Entity::Props::APhone>(); }
-	BaseEntity::SharedPtr make_props_aircon() { return std::make_shared<Entity::Props::AAircon>(); }
-	BaseEntity::SharedPtr make_props_tablesetA() { return std::make_shared<Entity::Props::ATableseta>(); }
-	BaseEntity::SharedPtr make_props_radio() { return std::make_shared<Entity::Props::ARadio>(); }
-	BaseEntity::SharedPtr make_cast_buma() { return std::make_shared<Entity::Cast::ABuma>(); }
-	BaseEntity::SharedPtr make_cast_bumb() { return std::make_shared<Entity::Cast::ABumb>(); }
-	BaseEntity::SharedPtr make_elements_raincloud() { return std::make_shared<Entity::Elements::ARaincloud>(); }
-	BaseEntity::SharedPtr make_elements_snowcloud() { return std::make_shared<Entity::Elements::ASnowcloud>(); }
-	BaseEntity::SharedPtr make_misc_cutscene_trigger() { return std::make_shared<Entity::Misc::ACutsceneTrigger>(); }
-	BaseEntity::SharedPtr make_misc_cutscene_camera() { return std::make_shared<Entity::Misc::ACutsceneCamera>(); }
-	BaseEntity::SharedPtr make_trigger_unlock() { return std::make_shared<Entity::Trigger::AUnlock>(); }
-	BaseEntity::SharedPtr make_props_chair() { return std::make_shared<Entity::Props::AChair>(); }
-	BaseEntity::SharedPtr make_props_extinguisherA() { return std::make_shared<Entity::Props::AExtinguishera>(); }
-	BaseEntity::SharedPtr make_props_extinguisherB() { return std::make_shared<Entity::Props::AExtinguisherb>(); }
-	BaseEntity::SharedPtr make_light_sconce() { return std::make_shared<Entity::Light::ASconce>(); }
-	BaseEntity::SharedPtr make_props_motorcycle() { return std::make_shared<Entity::Props::AMotorcycle>(); }
-	BaseEntity::SharedPtr make_props_ammocrate_bust() { return std::make_shared<Entity::Props::AAmmocrateBust>(); }
-	BaseEntity::SharedPtr make_props_shelf() { return std::make_shared<Entity::Props::AShelf>(); }
-	BaseEntity::SharedPtr make_props_mattressA() { return std::make_shared<Entity::Props::AMattressa>(); }
-	BaseEntity::SharedPtr make_props_mattressB() { return std::make_shared<Entity::Props::AMattressb>(); }
-	BaseEntity::SharedPtr make_props_mattressC() { return std::make_shared<Entity::Props::AMattressc>(); }
-	BaseEntity::SharedPtr make_trigger_motorcycle() { return std::make_shared<Entity::Trigger::AMotorcycle>(); }
-	BaseEntity::SharedPtr make_props_tv() { return std::make_shared<Entity::Props::ATv>(); }
-	BaseEntity::SharedPtr make_props_steam_machine() { return std::make_shared<Entity::Props::ASteamMachine>(); }
-	BaseEntity::SharedPtr make_light_bulb() { return std::make_shared<Entity::Light::ABulb>(); }
-	BaseEntity::SharedPtr make_props_trash() { return std::make_shared<Entity::Props::ATrash>(); }
-	BaseEntity::SharedPtr make_props_wall_fall() { return std::make_shared<Entity::Props::AWallFall>(); }
-	BaseEntity::SharedPtr make_props_trashbottle() { return std::make_shared<Entity::Props::ATrashbottle>(); }
-	BaseEntity::SharedPtr make_props_trashwall() { return std::make_shared<Entity::Props::ATrashwall>(); }
-	BaseEntity::SharedPtr make_props_trashpaper() { return std::make_shared<Entity::Props::ATrashpaper>(); }
-	BaseEntity::SharedPtr make_props_trashcorner() { return std::make_shared<Entity::Props::ATrashcorner>(); }
-	BaseEntity::SharedPtr make_props_trashbottle_vert() { return std::make_shared<Entity::Props::ATrashbottleVert>(); }
-	BaseEntity::SharedPtr make_props_blimp() { return std::make_shared<Entity::Props::ABlimp>(); }
-	BaseEntity::SharedPtr make_misc_use_cutscene() { return std::make_shared<Entity::Misc::AUseCutscene>(); }
-	BaseEntity::SharedPtr make_props_motorcycle_runaway() { return std::make_shared<Entity::Props::AMotorcycleRunaway>(); }
-	BaseEntity::SharedPtr make_trigger_hurt_fire() { return std::make_shared<Entity::Trigger::AHurtFire>(); }
-	BaseEntity::SharedPtr make_props_shelf_fall() { return std::make_shared<Entity::Props::AShelfFall>(); }
-	BaseEntity::SharedPtr make_target_fire() { return std::make_shared<Entity::Target::AFire>(); }
-	BaseEntity::SharedPtr make_props_rat() { return std::make_shared<Entity::Props::ARat>(); }
-	BaseEntity::SharedPtr make_props_rat_spawner() { return std::make_shared<Entity::Props::ARatSpawner>(); }
-	BaseEntity::SharedPtr make_props_rat_spawner_node() { return std::make_shared<Entity::Props::ARatSpawnerNode>(); }
-	BaseEntity::SharedPtr make_target_flamethrower() { return std::make_shared<Entity::Target::AFlamethrower>(); }
-	BaseEntity::SharedPtr make_light_deco_sconce() { return std::make_shared<Entity::Light::ADecoSconce>(); }
-	BaseEntity::SharedPtr make_light_pendant() { return std::make_shared<Entity::Light::APendant>(); }
-	BaseEntity::SharedPtr make_props_shelfB_fall() { return std::make_shared<Entity::Props::AShelfbFall>(); }
-	BaseEntity::SharedPtr make_func_lift() { return std::make_shared<Entity::Func::ALift>(); }
-	BaseEntity::SharedPtr make_props_roof_vent() { return std::make_shared<Entity::Props::ARoofVent>(); }
-	BaseEntity::SharedPtr make_props_rat_trigger() { return std::make_shared<Entity::Props::ARatTrigger>(); }
-	BaseEntity::SharedPtr make_props2_truck_die() { return std::make_shared<Entity::Props2::ATruckDie>(); }
-	BaseEntity::SharedPtr make_props_cola_machine() { return std::make_shared<Entity::Props::AColaMachine>(); }
-	BaseEntity::SharedPtr make_props_cig_machine() { return std::make_shared<Entity::Props::ACigMachine>(); }
-	BaseEntity::SharedPtr make_props2_barrels_fallA() { return std::make_shared<Entity::Props2::ABarrelsFalla>(); }
-	BaseEntity::SharedPtr make_props2_barrels_fallB() { return std::make_shared<Entity::Props2::ABarrelsFallb>(); }
-	BaseEntity::SharedPtr make_props2_clubcouch() { return std::make_shared<Entity::Props2::AClubcouch>(); }
-	BaseEntity::SharedPtr make_props2_clubchair() { return std::make_shared<Entity::Props2::AClubchair>(); }
-	BaseEntity::SharedPtr make_props2_vaseA() { return std::make_shared<Entity::Props2::AVasea>(); }
-	BaseEntity::SharedPtr make_props2_vaseB() { return std::make_shared<Entity::Props2::AVaseb>(); }
-	BaseEntity::SharedPtr make_props2_chair_conf() { return std::make_shared<Entity::Props2::AChairConf>(); }
-	BaseEntity::SharedPtr make_props2_shelf_metal_A_fall() { return std::make_shared<Entity::Props2::AShelfMetalAFall>(); }
-	BaseEntity::SharedPtr make_props2_shelf_metal_B_fall() { return std::make_shared<Entity::Props2::AShelfMetalBFall>(); }
-	BaseEntity::SharedPtr make_props2_deadguy() { return std::make_shared<Entity::Props2::ADeadguy>(); }
-	BaseEntity::SharedPtr make_props2_chair_push() { return std::make_shared<Entity::Props2::AChairPush>(); }
-	BaseEntity::SharedPtr make_props_crate_bust_32() { return std::make_shared<Entity::Props::ACrateBust32>(); }
-	BaseEntity::SharedPtr make_props_crate_bust_48() { return std::make_shared<Entity::Props::ACrateBust48>(); }
-	BaseEntity::SharedPtr make_props_crate_bust_64() { return std::make_shared<Entity::Props::ACrateBust64>(); }
-	BaseEntity::SharedPtr make_props2_flag() { return std::make_shared<Entity::Props2::AFlag>(); }
-	BaseEntity::SharedPtr make_props2_fish() { return std::make_shared<Entity::Props2::AFish>(); }
-	BaseEntity::SharedPtr make_props2_fish_trigger() { return std::make_shared<Entity::Props2::AFishTrigger>(); }
-	BaseEntity::SharedPtr make_props2_fish_spawner() { return std::make_shared<Entity::Props2::AFishSpawner>(); }
-	BaseEntity::SharedPtr make_props2_fish_spawner_node() { return std::make_shared<Entity::Props2::AFishSpawnerNode>(); }
-	BaseEntity::SharedPtr make_props2_wall_fish() { return std::make_shared<Entity::Props2::AWallFish>(); }
-	BaseEntity::SharedPtr make_props2_barrels_fall_ST() { return std::make_shared<Entity::Props2::ABarrelsFallSt>(); }
-	BaseEntity::SharedPtr make_props2_sign() { return std::make_shared<Entity::Props2::ASign>(); }
-	BaseEntity::SharedPtr make_props2_lighthouse_beam() { return std::make_shared<Entity::Props2::ALighthouseBeam>(); }
-	BaseEntity::SharedPtr make_props2_boat() { return std::make_shared<Entity::Props2::ABoat>(); }
-	BaseEntity::SharedPtr make_props2_buoy() { return std::make_shared<Entity::Props2::ABuoy>(); }
-	BaseEntity::SharedPtr make_props2_buoy_side() { return std::make_shared<Entity::Props2::ABuoySide>(); }
-	BaseEntity::SharedPtr make_props2_deadguy_underwater() { return std::make_shared<Entity::Props2::ADeadguyUnderwater>(); }
-	BaseEntity::SharedPtr make_props2_buoy_animate() { return std::make_shared<Entity::Props2::ABuoyAnimate>(); }
-	BaseEntity::SharedPtr make_props2_gargoyle() { return std::make_shared<Entity::Props2::AGargoyle>(); }
-	BaseEntity::SharedPtr make_props2_clothesline() { return std::make_shared<Entity::Props2::AClothesline>(); }
-	BaseEntity::SharedPtr make_props2_plant_XL() { return std::make_shared<Entity::Props2::APlantXl>(); }
-	BaseEntity::SharedPtr make_props2_plant_SM() { return std::make_shared<Entity::Props2::APlantSm>(); }
-	BaseEntity::SharedPtr make_props2_boatphone() { return std::make_shared<Entity::Props2::ABoatphone>(); }
-	BaseEntity::SharedPtr make_props2_ashtray() { return std::make_shared<Entity::Props2::AAshtray>(); }
-	BaseEntity::SharedPtr make_props2_lunch() { return std::make_shared<Entity::Props2::ALunch>(); }
-	BaseEntity::SharedPtr make_props2_deadgal_headless() { return std::make_shared<Entity::Props2::ADeadgalHeadless>(); }
-	BaseEntity::SharedPtr make_props2_plant_bush() { return std::make_shared<Entity::Props2::APlantBush>(); }
-	BaseEntity::SharedPtr make_props2_boat_animate() { return std::make_shared<Entity::Props2::ABoatAnimate>(); }
-	BaseEntity::SharedPtr make_props2_helicopter_animate() { return std::make_shared<Entity::Props2::AHelicopterAnimate>(); }
-	BaseEntity::SharedPtr make_props2_car_animate() { return std::make_shared<Entity::Props2::ACarAnimate>(); }
-	BaseEntity::SharedPtr make_props2_car_topdown() { return std::make_shared<Entity::Props2::ACarTopdown>(); }
-	BaseEntity::SharedPtr make_props2_car_topup() { return std::make_shared<Entity::Props2::ACarTopup>(); }
-	BaseEntity::SharedPtr make_props2_plant_fern() { return std::make_shared<Entity::Props2::APlantFern>(); }
-	BaseEntity::SharedPtr make_props2_pinball_machine() { return std::make_shared<Entity::Props2::APinballMachine>(); }
-	BaseEntity::SharedPtr make_props2_barrels_PV_A() { return std::make_shared<Entity::Props2::ABarrelsPvA>(); }
-	BaseEntity::SharedPtr make_props2_barrels_PV_C() { return std::make_shared<Entity::Props2::ABarrelsPvC>(); }
-	BaseEntity::SharedPtr make_props2_barrels_PV_D() { return std::make_shared<Entity::Props2::ABarrelsPvD>(); }
-	BaseEntity::SharedPtr make_props2_barrels_PV_E() { return std::make_shared<Entity::Props2::ABarrelsPvE>(); }
-	BaseEntity::SharedPtr make_props2_barrels_PV_F() { return std::make_shared<Entity::Props2::ABarrelsPvF>(); }
-	BaseEntity::SharedPtr make_light_chandelier() { return std::make_shared<Entity::Light::AChandelier>(); }
-	BaseEntity::SharedPtr make_props2_air_train() { return std::make_shared<Entity::Props2::AAirTrain>(); }
-	BaseEntity::SharedPtr make_props3_dead_louie() { return std::make_shared<Entity::Props3::ADeadLouie>(); }
-	BaseEntity::SharedPtr make_props3_cut_boss_player_animate() { return std::make_shared<Entity::Props3::ACutBossPlayerAnimate>(); }
-	BaseEntity::SharedPtr make_props3_deco_fixture() { return std::make_shared<Entity::Props3::ADecoFixture>(); }
-	BaseEntity::SharedPtr make_props3_cut_boss_chick_animate() { return std::make_shared<Entity::Props3::ACutBossChickAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cut_train_run_animate() { return std::make_shared<Entity::Props3::ACutTrainRunAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cut_A_animate() { return std::make_shared<Entity::Props3::ACutAAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cut_B_animate() { return std::make_shared<Entity::Props3::ACutBAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cut_C_animate() { return std::make_shared<Entity::Props3::ACutCAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cut_D_animate() { return std::make_shared<Entity::Props3::ACutDAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cash_counter_animate() { return std::make_shared<Entity::Props3::ACashCounterAnimate>(); }BaseEntity::SharedPtr make_props2_barrels_PV_B() { return std::make_shared<Entity::Props2::ABarrelsPvB>(); }
-	BaseEntity::SharedPtr make_props3_decanter() { return std::make_shared<Entity::Props3::ADecanter>(); }
-	BaseEntity::SharedPtr make_props3_whiskey_glass() { return std::make_shared<Entity::Props3::AWhiskeyGlass>(); }
-	BaseEntity::SharedPtr make_props3_barrels_fall_nikki_A() { return std::make_shared<Entity::Props3::ABarrelsFallNikkiA>(); }
-	BaseEntity::SharedPtr make_props3_barrels_fall_nikki_B() { return std::make_shared<Entity::Props3::ABarrelsFallNikkiB>(); }
-	BaseEntity::SharedPtr make_props3_cut_run_to_car_animate() { return std::make_shared<Entity::Props3::ACutRunToCarAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cut_final_animate() { return std::make_shared<Entity::Props3::ACutFinalAnimate>(); }
-	BaseEntity::SharedPtr make_props3_cash() { return std::make_shared<Entity::Props3::ACash>(); }
-	BaseEntity::SharedPtr make_props3_cut_truck_driver() { return std::make_shared<Entity::Props3::ACutTruckDriver>(); }
-	BaseEntity::SharedPtr make_props3_cut_pinball_guy_animate() { return std::make_shared<Entity::Props3::ACutPinballGuyAnimate>(); }
-	BaseEntity::SharedPtr make_lightflare() { return std::make_shared<Entity::ALightflare>(); }
-	BaseEntity::SharedPtr make_path_corner_cast() { return std::make_shared<Entity::Path::ACornerCast>(); }
-	BaseEntity::SharedPtr make_pistol_mod_damage() { return std::make_shared<Entity::Pistol::AModDamage>(); }
-	BaseEntity::SharedPtr make_pistol_mod_rof() { return std::make_shared<Entity::Pistol::AModRof>(); }
-	BaseEntity::SharedPtr make_pistol_mod_reload() { return std::make_shared<Entity::Pistol::AModReload>(); }
-	BaseEntity::SharedPtr make_hmg_mod_cooling() { return std::make_shared<Entity::Hmg::AModCooling>(); }
-	BaseEntity::SharedPtr make_sfx_beacon() { return std::make_shared<Entity::Sfx::ABeacon>(); }
-	BaseEntity::SharedPtr make_refl() { return std::make_shared<Entity::ARefl>(); }
-	BaseEntity::SharedPtr make_dm_cashspawn() { return std::make_shared<Entity::Dm::ACashspawn>(); }
-	BaseEntity::SharedPtr make_dm_safebag() { return std::make_shared<Entity::Dm::ASafebag>(); }
-	BaseEntity::SharedPtr make_dm_props_banner() { return std::make_shared<Entity::Dm::APropsBanner>(); }
+	BaseEntity* make_item_health() { return EntityPool<Entity::Item::AHealth>::Allocate(); }
+	BaseEntity* make_item_health_small() { return EntityPool<Entity::Item::AHealthSmall>::Allocate(); }
+	BaseEntity* make_item_health_large() { return EntityPool<Entity::Item::AHealthLarge>::Allocate(); }
+	BaseEntity* make_item_health_mega() { return EntityPool<Entity::Item::AHealthMega>::Allocate(); }
+	BaseEntity* make_info_player_start() { return EntityPool<Entity::Info::APlayerStart>::Allocate(); }
+	BaseEntity* make_info_player_deathmatch() { return EntityPool<Entity::Info::APlayerDeathmatch>::Allocate(); }
+	BaseEntity* make_info_player_coop() { return EntityPool<Entity::Info::APlayerCoop>::Allocate(); }
+	BaseEntity* make_info_player_intermission() { return EntityPool<Entity::Info::APlayerIntermission>::Allocate(); }
+	BaseEntity* make_func_plat() { return EntityPool<Entity::Func::APlat>::Allocate(); }
+	BaseEntity* make_func_button() { return EntityPool<Entity::Func::AButton>::Allocate(); }
+	BaseEntity* make_func_door() { return EntityPool<Entity::Func::ADoor>::Allocate(); }
+	BaseEntity* make_func_door_secret() { return EntityPool<Entity::Func::ADoorSecret>::Allocate(); }
+	BaseEntity* make_func_door_rotating() { return EntityPool<Entity::Func::ADoorRotating>::Allocate(); }
+	BaseEntity* make_func_rotating() { return EntityPool<Entity::Func::ARotating>::Allocate(); }
+	BaseEntity* make_func_train() { return EntityPool<Entity::Func::ATrain>::Allocate(); }
+	BaseEntity* make_func_water() { return EntityPool<Entity::Func::AWater>::Allocate(); }
+	BaseEntity* make_func_conveyor() { return EntityPool<Entity::Func::AConveyor>::Allocate(); }
+	BaseEntity* make_func_areaportal() { return EntityPool<Entity::Func::AAreaportal>::Allocate(); }
+	BaseEntity* make_func_clock() { return EntityPool<Entity::Func::AClock>::Allocate(); }
+	BaseEntity* make_func_wall() { return EntityPool<Entity::Func::AWall>::Allocate(); }
+	BaseEntity* make_func_object() { return EntityPool<Entity::Func::AObject>::Allocate(); }
+	BaseEntity* make_func_timer() { return EntityPool<Entity::Func::ATimer>::Allocate(); }
+	BaseEntity* make_func_explosive() { return EntityPool<Entity::Func::AExplosive>::Allocate(); }
+	BaseEntity* make_func_killbox() { return EntityPool<Entity::Func::AKillbox>::Allocate(); }
+	BaseEntity* make_func_object_repair() { return EntityPool<Entity::Func::AObjectRepair>::Allocate(); }
+	BaseEntity* make_rotating_light() { return EntityPool<Entity::Rotating::ALight>::Allocate(); }
+	BaseEntity* make_trigger_always() { return EntityPool<Entity::Trigger::AAlways>::Allocate(); }
+	BaseEntity* make_trigger_once() { return EntityPool<Entity::Trigger::AOnce>::Allocate(); }
+	BaseEntity* make_trigger_multiple() { return EntityPool<Entity::Trigger::AMultiple>::Allocate(); }
+	BaseEntity* make_trigger_relay() { return EntityPool<Entity::Trigger::ARelay>::Allocate(); }
+	BaseEntity* make_trigger_push() { return EntityPool<Entity::Trigger::APush>::Allocate(); }
+	BaseEntity* make_trigger_hurt() { return EntityPool<Entity::Trigger::AHurt>::Allocate(); }
+	BaseEntity* make_trigger_key() { return EntityPool<Entity::Trigger::AKey>::Allocate(); }
+	BaseEntity* make_trigger_counter() { return EntityPool<Entity::Trigger::ACounter>::Allocate(); }
+	BaseEntity* make_trigger_elevator() { return EntityPool<Entity::Trigger::AElevator>::Allocate(); }
+	BaseEntity* make_trigger_gravity() { return EntityPool<Entity::Trigger::AGravity>::Allocate(); }
+	BaseEntity* make_trigger_monsterjump() { return EntityPool<Entity::Trigger::AMonsterjump>::Allocate(); }
+	BaseEntity* make_target_temp_entity() { return EntityPool<Entity::Target::ATempEntity>::Allocate(); }
+	BaseEntity* make_target_speaker() { return EntityPool<Entity::Target::ASpeaker>::Allocate(); }
+	BaseEntity* make_target_explosion() { return EntityPool<Entity::Target::AExplosion>::Allocate(); }
+	BaseEntity* make_target_changelevel() { return EntityPool<Entity::Target::AChangelevel>::Allocate(); }
+	BaseEntity* make_target_secret() { return EntityPool<Entity::Target::ASecret>::Allocate(); }
+	BaseEntity* make_target_goal() { return EntityPool<Entity::Target::AGoal>::Allocate(); }
+	BaseEntity* make_target_splash() { return EntityPool<Entity::Target::ASplash>::Allocate(); }
+	BaseEntity* make_target_spawner() { return EntityPool<Entity::Target::ASpawner>::Allocate(); }
+	BaseEntity* make_target_blaster() { return EntityPool<Entity::Target::ABlaster>::Allocate(); }
+	BaseEntity* make_target_crosslevel_trigger() { return EntityPool<Entity::Target::ACrosslevelTrigger>::Allocate(); }
+	BaseEntity* make_target_crosslevel_target() { return EntityPool<Entity::Target::ACrosslevelTarget>::Allocate(); }
+	BaseEntity* make_target_laser() { return EntityPool<Entity::Target::ALaser>::Allocate(); }
+	BaseEntity* make_target_lightramp() { return EntityPool<Entity::Target::ALightramp>::Allocate(); }
+	BaseEntity* make_target_earthquake() { return EntityPool<Entity::Target::AEarthquake>::Allocate(); }
+	BaseEntity* make_target_character() { return EntityPool<Entity::Target::ACharacter>::Allocate(); }
+	BaseEntity* make_target_string() { return EntityPool<Entity::Target::AString>::Allocate(); }
+	BaseEntity* make_target_mal_laser() { return EntityPool<Entity::Target::AMalLaser>::Allocate(); }
+	BaseEntity* make_worldspawn() { return EntityPool<Entity::AWorldspawn>::Allocate(); }
+	BaseEntity* make_viewthing() { return EntityPool<Entity::AViewthing>::Allocate(); }
+	BaseEntity* make_light() { return EntityPool<Entity::ALight>::Allocate(); }
+	BaseEntity* make_light_mine1() { return EntityPool<Entity::Light::AMine1>::Allocate(); }
+	BaseEntity* make_light_mine2() { return EntityPool<Entity::Light::AMine2>::Allocate(); }
+	BaseEntity* make_info_null() { return EntityPool<Entity::Info::ANull>::Allocate(); }
+	BaseEntity* make_func_group() { return EntityPool<Entity::Func::AGroup>::Allocate(); }
+	BaseEntity* make_info_notnull() { return EntityPool<Entity::Info::ANotnull>::Allocate(); }
+	BaseEntity* make_path_corner() { return EntityPool<Entity::Path::ACorner>::Allocate(); }
+	BaseEntity* make_junior() { return EntityPool<Entity::AJunior>::Allocate(); }
+	BaseEntity* make_misc_explobox() { return EntityPool<Entity::Misc::AExplobox>::Allocate(); }
+	BaseEntity* make_misc_gib_arm() { return EntityPool<Entity::Misc::AGibArm>::Allocate(); }
+	BaseEntity* make_misc_gib_leg() { return EntityPool<Entity::Misc::AGibLeg>::Allocate(); }
+	BaseEntity* make_misc_gib_head() { return EntityPool<Entity::Misc::AGibHead>::Allocate(); }
+	BaseEntity* make_misc_teleporter() { return EntityPool<Entity::Misc::ATeleporter>::Allocate(); }
+	BaseEntity* make_misc_teleporter_dest() { return EntityPool<Entity::Misc::ATeleporterDest>::Allocate(); }
+	BaseEntity* make_misc_amb4() { return EntityPool<Entity::Misc::AAmb4>::Allocate(); }
+	BaseEntity* make_cast_punk() { return EntityPool<Entity::Cast::APunk>::Allocate(); }
+	BaseEntity* make_cast_thug() { return EntityPool<Entity::Cast::AThug>::Allocate(); }
+	BaseEntity* make_cast_thug_sit() { return EntityPool<Entity::Cast::AThugSit>::Allocate(); }
+	BaseEntity* make_cast_bitch() { return EntityPool<Entity::Cast::ABitch>::Allocate(); }
+	BaseEntity* make_cast_dog() { return EntityPool<Entity::Cast::ADog>::Allocate(); }
+	BaseEntity* make_cast_runt() { return EntityPool<Entity::Cast::ARunt>::Allocate(); }
+	BaseEntity* make_cast_bum_sit() { return EntityPool<Entity::Cast::ABumSit>::Allocate(); }
+	BaseEntity* make_cast_shorty() { return EntityPool<Entity::Cast::AShorty>::Allocate(); }
+	BaseEntity* make_cast_whore() { return EntityPool<Entity::Cast::AWhore>::Allocate(); }
+	BaseEntity* make_cast_punk_window() { return EntityPool<Entity::Cast::APunkWindow>::Allocate(); }
+	BaseEntity* make_cast_punk2() { return EntityPool<Entity::Cast::APunk2>::Allocate(); }
+	BaseEntity* make_cast_rosie() { return EntityPool<Entity::Cast::ARosie>::Allocate(); }
+	BaseEntity* make_ai_boundary() { return EntityPool<Entity::Ai::ABoundary>::Allocate(); }
+	BaseEntity* make_ai_event_hostile() { return EntityPool<Entity::Ai::AEventHostile>::Allocate(); }
+	BaseEntity* make_ai_event_follow() { return EntityPool<Entity::Ai::AEventFollow>::Allocate(); }
+	BaseEntity* make_ai_guard() { return EntityPool<Entity::Ai::AGuard>::Allocate(); }
+	BaseEntity* make_ai_territory() { return EntityPool<Entity::Ai::ATerritory>::Allocate(); }
+	BaseEntity* make_ai_trigger_character() { return EntityPool<Entity::Ai::ATriggerCharacter>::Allocate(); }
+	BaseEntity* make_ai_locked_door() { return EntityPool<Entity::Ai::ALockedDoor>::Allocate(); }
+	BaseEntity* make_misc_skidrow_radio() { return EntityPool<Entity::Misc::ASkidrowRadio>::Allocate(); }
+	BaseEntity* make_misc_skidrow_ambush() { return EntityPool<Entity::Misc::ASkidrowAmbush>::Allocate(); }
+	BaseEntity* make_misc_skidrow_radio_repeater() { return EntityPool<Entity::Misc::ASkidrowRadioRepeater>::Allocate(); }BaseEntity* make_ai_ty_fuseblown() { return EntityPool<Entity::Ai::ATyFuseblown>::Allocate(); }
+	BaseEntity* make_ai_moker_notinoffice() { return EntityPool<Entity::Ai::AMokerNotinoffice>::Allocate(); }
+	BaseEntity* make_misc_grunt() { return EntityPool<Entity::Misc::AGrunt>::Allocate(); }
+	BaseEntity* make_misc_fidelA() { return EntityPool<Entity::Misc::AFidela>::Allocate(); }
+	BaseEntity* make_misc_car() { return EntityPool<Entity::Misc::ACar>::Allocate(); }
+	BaseEntity* make_misc_smoke() { return EntityPool<Entity::Misc::ASmoke>::Allocate(); }
+	BaseEntity* make_elps() { return EntityPool<Entity::AElps>::Allocate(); }
+	BaseEntity* make_misc_alarm() { return EntityPool<Entity::Misc::AAlarm>::Allocate(); }
+	BaseEntity* make_trigger_hurt_electric() { return EntityPool<Entity::Trigger::AHurtElectric>::Allocate(); }
+	BaseEntity* make_pawn_o_matic() { return EntityPool<Entity::Pawn::AOMatic>::Allocate(); }
+	BaseEntity* make_ai_safespot() { return EntityPool<Entity::Ai::ASafespot>::Allocate(); }
+	BaseEntity* make_misc_skidrow_ai_reset() { return EntityPool<Entity::Misc::ASkidrowAiReset>::Allocate(); }
+	BaseEntity* make_ai_combat_spot() { return EntityPool<Entity::Ai::ACombatSpot>::Allocate(); }
+	BaseEntity* make_misc_skidrow_afraid() { return EntityPool<Entity::Misc::ASkidrowAfraid>::Allocate(); }
+	BaseEntity* make_misc_steeltown_afraid() { return EntityPool<Entity::Misc::ASteeltownAfraid>::Allocate(); }
+	BaseEntity* make_misc_kroker_afraid() { return EntityPool<Entity::Misc::AKrokerAfraid>::Allocate(); }
+	BaseEntity* make_rc_initiation_observer() { return EntityPool<Entity::Rc::AInitiationObserver>::Allocate(); }
+	BaseEntity* make_rc_initiation_brush() { return EntityPool<Entity::Rc::AInitiationBrush>::Allocate(); }
+	BaseEntity* make_misc_pv_afraid() { return EntityPool<Entity::Misc::APvAfraid>::Allocate(); }
+	BaseEntity* make_misc_ty_afraid() { return EntityPool<Entity::Misc::ATyAfraid>::Allocate(); }
+	BaseEntity* make_ai_ty_mo_boundry() { return EntityPool<Entity::Ai::ATyMoBoundry>::Allocate(); }
+	BaseEntity* make_ai_sy_dykes_boundry() { return EntityPool<Entity::Ai::ASyDykesBoundry>::Allocate(); }
+	BaseEntity* make_misc_sy_afraid() { return EntityPool<Entity::Misc::ASyAfraid>::Allocate(); }
+	BaseEntity* make_ep_skidrow_flag() { return EntityPool<Entity::Ep::ASkidrowFlag>::Allocate(); }
+	BaseEntity* make_ai_sy_oilcan() { return EntityPool<Entity::Ai::ASyOilcan>::Allocate(); }
+	BaseEntity* make_ai_ty_valvehandle() { return EntityPool<Entity::Ai::ATyValvehandle>::Allocate(); }
+	BaseEntity* make_ai_pv_fuseblown1() { return EntityPool<Entity::Ai::APvFuseblown1>::Allocate(); }
+	BaseEntity* make_ai_pv_fuseblown2() { return EntityPool<Entity::Ai::APvFuseblown2>::Allocate(); }
+	BaseEntity* make_ai_pv_deadlouie() { return EntityPool<Entity::Ai::APvDeadlouie>::Allocate(); }
+	BaseEntity* make_ai_sy_blefty() { return EntityPool<Entity::Ai::ASyBlefty>::Allocate(); }
+	BaseEntity* make_misc_barry_bitch() { return EntityPool<Entity::Misc::ABarryBitch>::Allocate(); }
+	BaseEntity* make_misc_corky_fidel_mdx_pcx() { return EntityPool<Entity::Misc::ACorkyFidelMdxPcx>::Allocate(); }
+	BaseEntity* make_misc_corky_fidel_mdx_tga() { return EntityPool<Entity::Misc::ACorkyFidelMdxTga>::Allocate(); }
+	BaseEntity* make_misc_cut_scene() { return EntityPool<Entity::Misc::ACutScene>::Allocate(); }
+	BaseEntity* make_light_fire_esm() { return EntityPool<Entity::Light::AFireEsm>::Allocate(); }
+	BaseEntity* make_light_fire_sm() { return EntityPool<Entity::Light::AFireSm>::Allocate(); }
+	BaseEntity* make_light_fire_med() { return EntityPool<Entity::Light::AFireMed>::Allocate(); }
+	BaseEntity* make_light_fire_lg() { return EntityPool<Entity::Light::AFireLg>::Allocate(); }
+	BaseEntity* make_smoke_esm() { return EntityPool<Entity::Smoke::AEsm>::Allocate(); }
+	BaseEntity* make_smoke_sm() { return EntityPool<Entity::Smoke::ASm>::Allocate(); }
+	BaseEntity* make_smoke_med() { return EntityPool<Entity::Smoke::AMed>::Allocate(); }
+	BaseEntity* make_smoke_lg() { return EntityPool<Entity::Smoke::ALg>::Allocate(); }
+	BaseEntity* make_func_train_rotating() { return EntityPool<Entity::Func::ATrainRotating>::Allocate(); }
+	BaseEntity* make_func_subdoor_base() { return EntityPool<Entity::Func::ASubdoorBase>::Allocate(); }
+	BaseEntity* make_func_subdoor_handle1() { return EntityPool<Entity::Func::ASubdoorHandle1>::Allocate(); }
+	BaseEntity* make_func_subdoor_handle2() { return EntityPool<Entity::Func::ASubdoorHandle2>::Allocate(); }
+	BaseEntity* make_props_trashcanA() { return EntityPool<Entity::Props::ATrashcana>::Allocate(); }
+	BaseEntity* make_props_trashcan_fall() { return EntityPool<Entity::Props::ATrashcanFall>::Allocate(); }
+	BaseEntity* make_props_hydrant() { return EntityPool<Entity::Props::AHydrant>::Allocate(); }
+	BaseEntity* make_props_antenna1a() { return EntityPool<Entity::Props::AAntenna1a>::Allocate(); }
+	BaseEntity* make_props_antenna1b() { return EntityPool<Entity::Props::AAntenna1b>::Allocate(); }
+	BaseEntity* make_props_antenna1c() { return EntityPool<Entity::Props::AAntenna1c>::Allocate(); }
+	BaseEntity* make_props_antenna2a() { return EntityPool<Entity::Props::AAntenna2a>::Allocate(); }
+	BaseEntity* make_props_antenna2b() { return EntityPool<Entity::Props::AAntenna2b>::Allocate(); }
+	BaseEntity* make_props_antenna2c() { return EntityPool<Entity::Props::AAntenna2c>::Allocate(); }
+	BaseEntity* make_props_antenna3a() { return EntityPool<Entity::Props::AAntenna3a>::Allocate(); }
+	BaseEntity* make_props_antenna3b() { return EntityPool<Entity::Props::AAntenna3b>::Allocate(); }
+	BaseEntity* make_props_antenna3c() { return EntityPool<Entity::Props::AAntenna3c>::Allocate(); }
+	BaseEntity* make_props_fan() { return EntityPool<Entity::Props::AFan>::Allocate(); }
+	BaseEntity* make_props_phone() { return EntityPool<Entity::Props::APhone>::Allocate(); }
+	BaseEntity* make_props_aircon() { return EntityPool<Entity::Props::AAircon>::Allocate(); }
+	BaseEntity* make_props_tablesetA() { return EntityPool<Entity::Props::ATableseta>::Allocate(); }
+	BaseEntity* make_props_radio() { return EntityPool<Entity::Props::ARadio>::Allocate(); }
+	BaseEntity* make_cast_buma() { return EntityPool<Entity::Cast::ABuma>::Allocate(); }
+	BaseEntity* make_cast_bumb() { return EntityPool<Entity::Cast::ABumb>::Allocate(); }
+	BaseEntity* make_elements_raincloud() { return EntityPool<Entity::Elements::ARaincloud>::Allocate(); }
+	BaseEntity* make_elements_snowcloud() { return EntityPool<Entity::Elements::ASnowcloud>::Allocate(); }
+	BaseEntity* make_misc_cutscene_trigger() { return EntityPool<Entity::Misc::ACutsceneTrigger>::Allocate(); }
+	BaseEntity* make_misc_cutscene_camera() { return EntityPool<Entity::Misc::ACutsceneCamera>::Allocate(); }
+	BaseEntity* make_trigger_unlock() { return EntityPool<Entity::Trigger::AUnlock>::Allocate(); }
+	BaseEntity* make_props_chair() { return EntityPool<Entity::Props::AChair>::Allocate(); }
+	BaseEntity* make_props_extinguisherA() { return EntityPool<Entity::Props::AExtinguishera>::Allocate(); }
+	BaseEntity* make_props_extinguisherB() { return EntityPool<Entity::Props::AExtinguisherb>::Allocate(); }
+	BaseEntity* make_light_sconce() { return EntityPool<Entity::Light::ASconce>::Allocate(); }
+	BaseEntity* make_props_motorcycle() { return EntityPool<Entity::Props::AMotorcycle>::Allocate(); }
+	BaseEntity* make_props_ammocrate_bust() { return EntityPool<Entity::Props::AAmmocrateBust>::Allocate(); }
+	BaseEntity* make_props_shelf() { return EntityPool<Entity::Props::AShelf>::Allocate(); }
+	BaseEntity* make_props_mattressA() { return EntityPool<Entity::Props::AMattressa>::Allocate(); }
+	BaseEntity* make_props_mattressB() { return EntityPool<Entity::Props::AMattressb>::Allocate(); }
+	BaseEntity* make_props_mattressC() { return EntityPool<Entity::Props::AMattressc>::Allocate(); }
+	BaseEntity* make_trigger_motorcycle() { return EntityPool<Entity::Trigger::AMotorcycle>::Allocate(); }
+	BaseEntity* make_props_tv() { return EntityPool<Entity::Props::ATv>::Allocate(); }
+	BaseEntity* make_props_steam_machine() { return EntityPool<Entity::Props::ASteamMachine>::Allocate(); }
+	BaseEntity* make_light_bulb() { return EntityPool<Entity::Light::ABulb>::Allocate(); }
+	BaseEntity* make_props_trash() { return EntityPool<Entity::Props::ATrash>::Allocate(); }
+	BaseEntity* make_props_wall_fall() { return EntityPool<Entity::Props::AWallFall>::Allocate(); }
+	BaseEntity* make_props_trashbottle() { return EntityPool<Entity::Props::ATrashbottle>::Allocate(); }
+	BaseEntity* make_props_trashwall() { return EntityPool<Entity::Props::ATrashwall>::Allocate(); }
+	BaseEntity* make_props_trashpaper() { return EntityPool<Entity::Props::ATrashpaper>::Allocate(); }
+	BaseEntity* make_props_trashcorner() { return EntityPool<Entity::Props::ATrashcorner>::Allocate(); }
+	BaseEntity* make_props_trashbottle_vert() { return EntityPool<Entity::Props::ATrashbottleVert>::Allocate(); }
+	BaseEntity* make_props_blimp() { return EntityPool<Entity::Props::ABlimp>::Allocate(); }
+	BaseEntity* make_misc_use_cutscene() { return EntityPool<Entity::Misc::AUseCutscene>::Allocate(); }
+	BaseEntity* make_props_motorcycle_runaway() { return EntityPool<Entity::Props::AMotorcycleRunaway>::Allocate(); }
+	BaseEntity* make_trigger_hurt_fire() { return EntityPool<Entity::Trigger::AHurtFire>::Allocate(); }
+	BaseEntity* make_props_shelf_fall() { return EntityPool<Entity::Props::AShelfFall>::Allocate(); }
+	BaseEntity* make_target_fire() { return EntityPool<Entity::Target::AFire>::Allocate(); }
+	BaseEntity* make_props_rat() { return EntityPool<Entity::Props::ARat>::Allocate(); }
+	BaseEntity* make_props_rat_spawner() { return EntityPool<Entity::Props::ARatSpawner>::Allocate(); }
+	BaseEntity* make_props_rat_spawner_node() { return EntityPool<Entity::Props::ARatSpawnerNode>::Allocate(); }
+	BaseEntity* make_target_flamethrower() { return EntityPool<Entity::Target::AFlamethrower>::Allocate(); }
+	BaseEntity* make_light_deco_sconce() { return EntityPool<Entity::Light::ADecoSconce>::Allocate(); }
+	BaseEntity* make_light_pendant() { return EntityPool<Entity::Light::APendant>::Allocate(); }
+	BaseEntity* make_props_shelfB_fall() { return EntityPool<Entity::Props::AShelfbFall>::Allocate(); }
+	BaseEntity* make_func_lift() { return EntityPool<Entity::Func::ALift>::Allocate(); }
+	BaseEntity* make_props_roof_vent() { return EntityPool<Entity::Props::ARoofVent>::Allocate(); }
+	BaseEntity* make_props_rat_trigger() { return EntityPool<Entity::Props::ARatTrigger>::Allocate(); }
+	BaseEntity* make_props2_truck_die() { return EntityPool<Entity::Props2::ATruckDie>::Allocate(); }
+	BaseEntity* make_props_cola_machine() { return EntityPool<Entity::Props::AColaMachine>::Allocate(); }
+	BaseEntity* make_props_cig_machine() { return EntityPool<Entity::Props::ACigMachine>::Allocate(); }
+	BaseEntity* make_props2_barrels_fallA() { return EntityPool<Entity::Props2::ABarrelsFalla>::Allocate(); }
+	BaseEntity* make_props2_barrels_fallB() { return EntityPool<Entity::Props2::ABarrelsFallb>::Allocate(); }
+	BaseEntity* make_props2_clubcouch() { return EntityPool<Entity::Props2::AClubcouch>::Allocate(); }
+	BaseEntity* make_props2_clubchair() { return EntityPool<Entity::Props2::AClubchair>::Allocate(); }
+	BaseEntity* make_props2_vaseA() { return EntityPool<Entity::Props2::AVasea>::Allocate(); }
+	BaseEntity* make_props2_vaseB() { return EntityPool<Entity::Props2::AVaseb>::Allocate(); }
+	BaseEntity* make_props2_chair_conf() { return EntityPool<Entity::Props2::AChairConf>::Allocate(); }
+	BaseEntity* make_props2_shelf_metal_A_fall() { return EntityPool<Entity::Props2::AShelfMetalAFall>::Allocate(); }
+	BaseEntity* make_props2_shelf_metal_B_fall() { return EntityPool<Entity::Props2::AShelfMetalBFall>::Allocate(); }
+	BaseEntity* make_props2_deadguy() { return EntityPool<Entity::Props2::ADeadguy>::Allocate(); }
+	BaseEntity* make_props2_chair_push() { return EntityPool<Entity::Props2::AChairPush>::Allocate(); }
+	BaseEntity* make_props_crate_bust_32() { return EntityPool<Entity::Props::ACrateBust32>::Allocate(); }
+	BaseEntity* make_props_crate_bust_48() { return EntityPool<Entity::Props::ACrateBust48>::Allocate(); }
+	BaseEntity* make_props_crate_bust_64() { return EntityPool<Entity::Props::ACrateBust64>::Allocate(); }
+	BaseEntity* make_props2_flag() { return EntityPool<Entity::Props2::AFlag>::Allocate(); }
+	BaseEntity* make_props2_fish() { return EntityPool<Entity::Props2::AFish>::Allocate(); }
+	BaseEntity* make_props2_fish_trigger() { return EntityPool<Entity::Props2::AFishTrigger>::Allocate(); }
+	BaseEntity* make_props2_fish_spawner() { return EntityPool<Entity::Props2::AFishSpawner>::Allocate(); }
+	BaseEntity* make_props2_fish_spawner_node() { return EntityPool<Entity::Props2::AFishSpawnerNode>::Allocate(); }
+	BaseEntity* make_props2_wall_fish() { return EntityPool<Entity::Props2::AWallFish>::Allocate(); }
+	BaseEntity* make_props2_barrels_fall_ST() { return EntityPool<Entity::Props2::ABarrelsFallSt>::Allocate(); }
+	BaseEntity* make_props2_sign() { return EntityPool<Entity::Props2::ASign>::Allocate(); }
+	BaseEntity* make_props2_lighthouse_beam() { return EntityPool<Entity::Props2::ALighthouseBeam>::Allocate(); }
+	BaseEntity* make_props2_boat() { return EntityPool<Entity::Props2::ABoat>::Allocate(); }
+	BaseEntity* make_props2_buoy() { return EntityPool<Entity::Props2::ABuoy>::Allocate(); }
+	BaseEntity* make_props2_buoy_side() { return EntityPool<Entity::Props2::ABuoySide>::Allocate(); }
+	BaseEntity* make_props2_deadguy_underwater() { return EntityPool<Entity::Props2::ADeadguyUnderwater>::Allocate(); }
+	BaseEntity* make_props2_buoy_animate() { return EntityPool<Entity::Props2::ABuoyAnimate>::Allocate(); }
+	BaseEntity* make_props2_gargoyle() { return EntityPool<Entity::Props2::AGargoyle>::Allocate(); }
+	BaseEntity* make_props2_clothesline() { return EntityPool<Entity::Props2::AClothesline>::Allocate(); }
+	BaseEntity* make_props2_plant_XL() { return EntityPool<Entity::Props2::APlantXl>::Allocate(); }
+	BaseEntity* make_props2_plant_SM() { return EntityPool<Entity::Props2::APlantSm>::Allocate(); }
+	BaseEntity* make_props2_boatphone() { return EntityPool<Entity::Props2::ABoatphone>::Allocate(); }
+	BaseEntity* make_props2_ashtray() { return EntityPool<Entity::Props2::AAshtray>::Allocate(); }
+	BaseEntity* make_props2_lunch() { return EntityPool<Entity::Props2::ALunch>::Allocate(); }
+	BaseEntity* make_props2_deadgal_headless() { return EntityPool<Entity::Props2::ADeadgalHeadless>::Allocate(); }
+	BaseEntity* make_props2_plant_bush() { return EntityPool<Entity::Props2::APlantBush>::Allocate(); }
+	BaseEntity* make_props2_boat_animate() { return EntityPool<Entity::Props2::ABoatAnimate>::Allocate(); }
+	BaseEntity* make_props2_helicopter_animate() { return EntityPool<Entity::Props2::AHelicopterAnimate>::Allocate(); }
+	BaseEntity* make_props2_car_animate() { return EntityPool<Entity::Props2::ACarAnimate>::Allocate(); }
+	BaseEntity* make_props2_car_topdown() { return EntityPool<Entity::Props2::ACarTopdown>::Allocate(); }
+	BaseEntity* make_props2_car_topup() { return EntityPool<Entity::Props2::ACarTopup>::Allocate(); }
+	BaseEntity* make_props2_plant_fern() { return EntityPool<Entity::Props2::APlantFern>::Allocate(); }
+	BaseEntity* make_props2_pinball_machine() { return EntityPool<Entity::Props2::APinballMachine>::Allocate(); }
+	BaseEntity* make_props2_barrels_PV_A() { return EntityPool<Entity::Props2::ABarrelsPvA>::Allocate(); }
+	BaseEntity* make_props2_barrels_PV_C() { return EntityPool<Entity::Props2::ABarrelsPvC>::Allocate(); }
+	BaseEntity* make_props2_barrels_PV_D() { return EntityPool<Entity::Props2::ABarrelsPvD>::Allocate(); }
+	BaseEntity* make_props2_barrels_PV_E() { return EntityPool<Entity::Props2::ABarrelsPvE>::Allocate(); }
+	BaseEntity* make_props2_barrels_PV_F() { return EntityPool<Entity::Props2::ABarrelsPvF>::Allocate(); }
+	BaseEntity* make_light_chandelier() { return EntityPool<Entity::Light::AChandelier>::Allocate(); }
+	BaseEntity* make_props2_air_train() { return EntityPool<Entity::Props2::AAirTrain>::Allocate(); }
+	BaseEntity* make_props3_dead_louie() { return EntityPool<Entity::Props3::ADeadLouie>::Allocate(); }
+	BaseEntity* make_props3_cut_boss_player_animate() { return EntityPool<Entity::Props3::ACutBossPlayerAnimate>::Allocate(); }
+	BaseEntity* make_props3_deco_fixture() { return EntityPool<Entity::Props3::ADecoFixture>::Allocate(); }
+	BaseEntity* make_props3_cut_boss_chick_animate() { return EntityPool<Entity::Props3::ACutBossChickAnimate>::Allocate(); }
+	BaseEntity* make_props3_cut_train_run_animate() { return EntityPool<Entity::Props3::ACutTrainRunAnimate>::Allocate(); }
+	BaseEntity* make_props3_cut_A_animate() { return EntityPool<Entity::Props3::ACutAAnimate>::Allocate(); }
+	BaseEntity* make_props3_cut_B_animate() { return EntityPool<Entity::Props3::ACutBAnimate>::Allocate(); }
+	BaseEntity* make_props3_cut_C_animate() { return EntityPool<Entity::Props3::ACutCAnimate>::Allocate(); }
+	BaseEntity* make_props3_cut_D_animate() { return EntityPool<Entity::Props3::ACutDAnimate>::Allocate(); }
+	BaseEntity* make_props3_cash_counter_animate() { return EntityPool<Entity::Props3::ACashCounterAnimate>::Allocate(); }BaseEntity* make_props2_barrels_PV_B() { return EntityPool<Entity::Props2::ABarrelsPvB>::Allocate(); }
+	BaseEntity* make_props3_decanter() { return EntityPool<Entity::Props3::ADecanter>::Allocate(); }
+	BaseEntity* make_props3_whiskey_glass() { return EntityPool<Entity::Props3::AWhiskeyGlass>::Allocate(); }
+	BaseEntity* make_props3_barrels_fall_nikki_A() { return EntityPool<Entity::Props3::ABarrelsFallNikkiA>::Allocate(); }
+	BaseEntity* make_props3_barrels_fall_nikki_B() { return EntityPool<Entity::Props3::ABarrelsFallNikkiB>::Allocate(); }
+	BaseEntity* make_props3_cut_run_to_car_animate() { return EntityPool<Entity::Props3::ACutRunToCarAnimate>::Allocate(); }
+	BaseEntity* make_props3_cut_final_animate() { return EntityPool<Entity::Props3::ACutFinalAnimate>::Allocate(); }
+	BaseEntity* make_props3_cash() { return EntityPool<Entity::Props3::ACash>::Allocate(); }
+	BaseEntity* make_props3_cut_truck_driver() { return EntityPool<Entity::Props3::ACutTruckDriver>::Allocate(); }
+	BaseEntity* make_props3_cut_pinball_guy_animate() { return EntityPool<Entity::Props3::ACutPinballGuyAnimate>::Allocate(); }
+	BaseEntity* make_lightflare() { return EntityPool<Entity::ALightflare>::Allocate(); }
+	BaseEntity* make_path_corner_cast() { return EntityPool<Entity::Path::ACornerCast>::Allocate(); }
+	BaseEntity* make_pistol_mod_damage() { return EntityPool<Entity::Pistol::AModDamage>::Allocate(); }
+	BaseEntity* make_pistol_mod_rof() { return EntityPool<Entity::Pistol::AModRof>::Allocate(); }
+	BaseEntity* make_pistol_mod_reload() { return EntityPool<Entity::Pistol::AModReload>::Allocate(); }
+	BaseEntity* make_hmg_mod_cooling() { return EntityPool<Entity::Hmg::AModCooling>::Allocate(); }
+	BaseEntity* make_sfx_beacon() { return EntityPool<Entity::Sfx::ABeacon>::Allocate(); }
+	BaseEntity* make_refl() { return EntityPool<Entity::ARefl>::Allocate(); }
+	BaseEntity* make_dm_cashspawn() { return EntityPool<Entity::Dm::ACashspawn>::Allocate(); }
+	BaseEntity* make_dm_safebag() { return EntityPool<Entity::Dm::ASafebag>::Allocate(); }
+	BaseEntity* make_dm_props_banner() { return EntityPool<Entity::Dm::APropsBanner>::Allocate(); }
 
-	static const std::unordered_map<std::string_view, BaseEntity::SharedPtr(*)()> classes =
+	static const std::unordered_map<Name, BaseEntity*(*)()> classes =
 	{
 		{ "item_health", make_item_health },
 		{ "item_health_small", make_item_health_small },
@@ -864,7 +864,7 @@ namespace Freeking
 		{ "dm_props_banner", make_dm_props_banner }
 	};
 
-	BaseEntity::SharedPtr BaseEntity::Make(const std::string_view& classname)
+	BaseEntity* BaseEntity::Make(const Name& classname)
 	{
 		if (auto it = classes.find(classname); it != classes.end())
 		{
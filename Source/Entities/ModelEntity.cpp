@@ -1,23 +1,65 @@
 #include "ModelEntity.h"
 #include "DynamicModel.h"
 #include "Texture2D.h"
+#include "TextureStreamer.h"
+#include "Map.h"
 
 namespace Freeking
 {
-	ModelEntity::ModelEntity() : PrimitiveEntity()
+	ModelEntity::ModelEntity() : PrimitiveEntity(),
+		_staticBatch(nullptr),
+		_staticHandle(StaticModelBatch::InvalidHandle),
+		_staticHidden(false)
 	{
 	}
 
+	ModelEntity::~ModelEntity()
+	{
+		// The owning map clears its entities before its batch goes, but Map::Current may
+		// already be the next map by then.
+		if (_staticBatch && _staticHandle != StaticModelBatch::InvalidHandle)
+		{
+			_staticBatch->Remove(_staticHandle);
+		}
+	}
+
 	void ModelEntity::Tick(double dt)
 	{
 		PrimitiveEntity::Tick(dt);
+
+		if (!_staticBatch || _staticHandle == StaticModelBatch::InvalidHandle)
+		{
+			return;
+		}
+
+		auto& batch = *_staticBatch;
+
+		if (_hidden != _staticHidden)
+		{
+			_staticHidden = _hidden;
+			batch.SetHidden(_staticHandle, _hidden);
+		}
+
+		if (GetTransform() != _staticTransform)
+		{
+			Vector3f center;
+			float radius;
+			GetRenderBounds(center, radius);
+
+			_staticTransform = GetTransform();
+			batch.Move(_staticHandle, _staticTransform, center);
+		}
+	}
+
+	void ModelEntity::GetRenderBounds(Vector3f& center, float& radius) const
+	{
+		center = GetPosition() + (GetLocalMinBounds() + GetLocalMaxBounds()) * 0.5f;
+		radius = (GetLocalMaxBounds() - GetLocalMinBounds()).Length() * 0.5f;
 	}
 
 	void ModelEntity::Initialize()
 	{
 		PrimitiveEntity::Initialize();
-
-		_shader = Shader::Library.DynamicModel.get();
 		_model = DynamicModel::Library.Get(_modelName);
 
 		auto skin = _skinName.empty() ? ((_model && !_model->Skins.empty()) ? _model->Skins[0] : "") : _skinName;
@@ -30,40 +72,32 @@ namespace Freeking
 		{
 			_texture = Texture2D::Library.Get(skin);
 		}
-	}
 
-	void ModelEntity::PreRender(bool translucent)
-	{
-		if (_shader && _model && _texture)
+		if (_model && _texture)
 		{
-			_shader->Bind();
-
-			int frame = 0;
-			
-			_shader->SetParameterValue("modelMatrix", GetTransform());
-			_shader->SetParameterValue("delta", 0.0f);
-			_shader->SetParameterValue("normalBuffer", DynamicModel::GetNormalBuffer().get());
-			_shader->SetParameterValue("diffuse", _texture.get());
-			_shader->SetParameterValue("frameVertexBuffer", _model->GetFrameVertexBuffer().get());
-			_shader->SetParameterValue("frames[0].index", (int)(frame * _model->GetFrameVertexCount()));
-			_shader->SetParameterValue("frames[0].translate", _model->FrameTransforms[frame].translate);
-			_shader->SetParameterValue("frames[0].scale", _model->FrameTransforms[frame].scale);
-			_shader->SetParameterValue("frames[1].index", (int)(frame * _model->GetFrameVertexCount()));
-			_shader->SetParameterValue("frames[1].translate", _model->FrameTransforms[frame].translate);
-			_shader->SetParameterValue("frames[1].scale", _model->FrameTransforms[frame].scale);
+			Vector3f center;
+			float radius;
+			GetRenderBounds(center, radius);
+
+			_staticTransform = GetTransform();
+			_staticHidden = _hidden;
+			_staticBatch = &Map::Current->GetStaticModelBatch();
+			_staticHandle = _staticBatch->Add(_model.get(), _texture.get(), _staticTransform, 0, center, radius);
+			_staticBatch->SetHidden(_staticHandle, _staticHidden);
 		}
 	}
 
-	void ModelEntity::RenderOpaque()
+	void ModelEntity::Render(RenderQueue& queue)
 	{
-		if (_shader && _model && _texture)
+		// The static batch draws the prop, so only its texture is requested here.
+		if (_texture)
 		{
-			_model->Draw();
-		}
-	}
+			Vector3f center;
+			float radius;
+			GetRenderBounds(center, radius);
 
-	void ModelEntity::RenderTranslucent()
-	{
+			TextureStreamer::RequestForRadius(_texture.get(), center, radius);
+		}
 	}
 
 	bool ModelEntity::SetProperty(const EntityProperty& property)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PrimitiveEntity.h"
+#include "StaticModelBatch.h"
 
 namespace Freeking
 {
@@ -12,13 +13,12 @@ namespace Freeking
 	public:
 
 		ModelEntity();
+		virtual ~ModelEntity();
 
 		virtual void Initialize() override;
 		virtual void Tick(double dt) override;
 
-		virtual void PreRender(bool translucent) override;
-		virtual void RenderOpaque() override;
-		virtual void RenderTranslucent() override;
+		virtual void Render(RenderQueue& queue) override;
 
 	protected:
 
@@ -29,7 +29,15 @@ namespace Freeking
 
 	private:
 
+		void GetRenderBounds(Vector3f& center, float& radius) const;
+
 		std::shared_ptr<DynamicModel> _model;
 		std::shared_ptr<Texture2D> _texture;
+
+		// Props are drawn by the map's static batch, which is told when they move or hide.
+		StaticModelBatch* _staticBatch;
+		StaticModelBatch::Handle _staticHandle;
+		Matrix4x4 _staticTransform;
+		bool _staticHidden;
 	};
 }
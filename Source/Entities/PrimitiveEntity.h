@@ -6,6 +6,7 @@
 namespace Freeking
 {
 	class PrimitiveEntity;
+	class RenderQueue;
 
 	struct TraceResult
 	{
@@ -20,7 +21,8 @@ namespace Freeking
 			axisU(0),
 			axisV(0),
 			startPosition(0),
-			endPosition(0)
+			endPosition(0),
+			hitPart(-1)
 		{
 		}
 
@@ -35,6 +37,9 @@ namespace Freeking
 		Vector3f startPosition;
 		Vector3f endPosition;
 		PrimitiveEntity* entity;
+
+		// The part of the entity that was hit, for entities with more than one hitbox.
+		int hitPart;
 	};
 
 	class PrimitiveEntity : public SceneEntity
@@ -46,9 +51,9 @@ namespace Freeking
 		virtual void Tick(double dt) override;
 		virtual void PostTick() override;
 
-		virtual void PreRender(bool translucent) {};
-		virtual void RenderOpaque() {};
-		virtual void RenderTranslucent() {};
+		virtual PrimitiveEntity* AsPrimitive() override { return this; }
+
+		virtual void Render(RenderQueue& queue) {};
 
 		inline bool IsHidden() const { return _hidden; }
 		inline bool IsCollisionEnabled() const { return _collisionEnabled; }
@@ -27,8 +27,9 @@ namespace Freeking
 
 	bool RotatingEntity::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("speed"))
+		switch (property.GetKeyId())
 		{
+		case "speed"_key:
 			return property.ValueAsFloat(_speed);
 		}
 
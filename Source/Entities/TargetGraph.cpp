@@ -0,0 +1,106 @@
+#include "TargetGraph.h"
+#include "EntityList.h"
+#include "BaseEntity.h"
+
+namespace Freeking
+{
+	TargetGraph::TargetGraph() :
+		_dirty(true)
+	{
+	}
+
+	void TargetGraph::Build(const EntityList& entities)
+	{
+		_groupIndices.clear();
+		_groups.clear();
+		_links.clear();
+		_sourceGroups.clear();
+
+		uint32_t numSlots = 0;
+
+		for (auto entity : entities.GetEntities())
+		{
+			numSlots = std::max(numSlots, entity->GetHandle().GetIndex() + 1);
+
+			const auto& targetname = entity->GetTargetname();
+			if (targetname.IsEmpty())
+			{
+				continue;
+			}
+
+			auto [it, inserted] = _groupIndices.try_emplace(targetname, static_cast<uint32_t>(_groups.size()));
+			if (inserted)
+			{
+				_groups.push_back({ 0, 0 });
+			}
+
+			_groups[it->second].count++;
+		}
+
+		uint32_t offset = 0;
+
+		for (auto& group : _groups)
+		{
+			group.offset = offset;
+			offset += group.count;
+			group.count = 0;
+		}
+
+		_links.resize(offset);
+		_sourceGroups.resize(numSlots, InvalidGroup);
+
+		for (auto entity : entities.GetEntities())
+		{
+			if (const auto& targetname = entity->GetTargetname(); !targetname.IsEmpty())
+			{
+				auto& group = _groups[_groupIndices[targetname]];
+				_links[group.offset + group.count++] = entity->GetHandle();
+			}
+
+			if (const auto& target = entity->GetTarget(); !target.IsEmpty())
+			{
+				if (auto it = _groupIndices.find(target); it != _groupIndices.end())
+				{
+					_sourceGroups[entity->GetHandle().GetIndex()] = it->second;
+				}
+			}
+		}
+
+		_dirty = false;
+	}
+
+	TargetGraph::Targets TargetGraph::GetTargets(const EntityHandle& source) const
+	{
+		uint32_t index = source.GetIndex();
+
+		if (index < _sourceGroups.size())
+		{
+			return GetGroupTargets(_sourceGroups[index]);
+		}
+
+		return GetGroupTargets(InvalidGroup);
+	}
+
+	TargetGraph::Targets TargetGraph::GetTargets(const Name& targetName) const
+	{
+		if (auto it = _groupIndices.find(targetName); it != _groupIndices.end())
+		{
+			return GetGroupTargets(it->second);
+		}
+
+		return GetGroupTargets(InvalidGroup);
+	}
+
+	TargetGraph::Targets TargetGraph::GetGroupTargets(uint32_t group) const
+	{
+		if (group == InvalidGroup)
+		{
+			return { nullptr, nullptr };
+		}
+
+		const auto& range = _groups[group];
+		const EntityHandle* first = _links.data() + range.offset;
+
+		return { first, first + range.count };
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EntityHandle.h"
+#include "Name.h"
+#include <vector>
+#include <unordered_map>
+
+namespace Freeking
+{
+	class EntityList;
+
+	class TargetGraph
+	{
+	public:
+
+		struct Targets
+		{
+			const EntityHandle* first;
+			const EntityHandle* last;
+
+			inline const EntityHandle* begin() const { return first; }
+			inline const EntityHandle* end() const { return last; }
+			inline bool empty() const { return first == last; }
+			inline size_t size() const { return last - first; }
+		};
+
+		TargetGraph();
+
+		void Build(const EntityList& entities);
+
+		inline void MarkDirty() { _dirty = true; }
+		inline bool IsDirty() const { return _dirty; }
+
+		Targets GetTargets(const EntityHandle& source) const;
+		Targets GetTargets(const Name& targetName) const;
+
+	private:
+
+		static constexpr uint32_t InvalidGroup = ~0u;
+
+		struct Group
+		{
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		Targets GetGroupTargets(uint32_t group) const;
+
+		std::unordered_map<Name, uint32_t> _groupIndices;
+		std::vector<Group> _groups;
+		std::vector<EntityHandle> _links;
+		std::vector<uint32_t> _sourceGroups;
+		bool _dirty;
+	};
+}
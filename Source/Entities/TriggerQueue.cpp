@@ -0,0 +1,85 @@
+#include "TriggerQueue.h"
+#include "EntityList.h"
+#include "BaseEntity.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+namespace Freeking
+{
+	TriggerQueue::TriggerQueue() :
+		_sequence(0),
+		_current(NoParent)
+	{
+	}
+
+	void TriggerQueue::Reserve(size_t count)
+	{
+		_events.reserve(count);
+		_dispatched.reserve(count);
+	}
+
+	void TriggerQueue::Enqueue(const EntityHandle& target, double time, double delay)
+	{
+		uint32_t parent = (delay <= 0.0) ? _current : NoParent;
+
+		if (parent != NoParent && IsCycle(target, parent))
+		{
+			std::cout << "Trigger cycle detected, dropping event for entity " << target.GetIndex() << std::endl;
+			return;
+		}
+
+		_events.push_back({ time + std::max(delay, 0.0), _sequence++, parent, target });
+		std::push_heap(_events.begin(), _events.end(), std::greater<Event>());
+	}
+
+	void TriggerQueue::Dispatch(const EntityList& entities, double time)
+	{
+		while (!_events.empty() && _events.front().time <= time)
+		{
+			std::pop_heap(_events.begin(), _events.end(), std::greater<Event>());
+			Event event = _events.back();
+			_events.pop_back();
+
+			auto entity = entities.Get(event.target);
+			if (!entity)
+			{
+				continue;
+			}
+
+			_current = static_cast<uint32_t>(_dispatched.size());
+			_dispatched.push_back({ event.target, event.parent });
+
+			entity->Trigger();
+		}
+
+		_current = NoParent;
+		_dispatched.clear();
+
+		if (_events.empty())
+		{
+			_sequence = 0;
+		}
+	}
+
+	void TriggerQueue::Clear()
+	{
+		_events.clear();
+		_dispatched.clear();
+		_sequence = 0;
+		_current = NoParent;
+	}
+
+	bool TriggerQueue::IsCycle(const EntityHandle& target, uint32_t parent) const
+	{
+		for (uint32_t i = parent; i != NoParent; i = _dispatched[i].parent)
+		{
+			if (_dispatched[i].target == target)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
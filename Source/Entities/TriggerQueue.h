@@ -0,0 +1,53 @@
+#pragma once
+
+#include "EntityHandle.h"
+#include <vector>
+
+namespace Freeking
+{
+	class EntityList;
+
+	class TriggerQueue
+	{
+	public:
+
+		TriggerQueue();
+
+		void Reserve(size_t count);
+		void Enqueue(const EntityHandle& target, double time, double delay);
+		void Dispatch(const EntityList& entities, double time);
+		void Clear();
+
+		inline size_t GetNumPending() const { return _events.size(); }
+
+	private:
+
+		static constexpr uint32_t NoParent = ~0u;
+
+		struct Event
+		{
+			double time;
+			uint32_t sequence;
+			uint32_t parent;
+			EntityHandle target;
+
+			inline bool operator>(const Event& other) const
+			{
+				return (time != other.time) ? (time > other.time) : (sequence > other.sequence);
+			}
+		};
+
+		struct Dispatched
+		{
+			EntityHandle target;
+			uint32_t parent;
+		};
+
+		bool IsCycle(const EntityHandle& target, uint32_t parent) const;
+
+		std::vector<Event> _events;
+		std::vector<Dispatched> _dispatched;
+		uint32_t _sequence;
+		uint32_t _current;
+	};
+}
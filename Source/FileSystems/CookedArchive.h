@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Hash.h"
+#include <cstdint>
+#include <string_view>
+
+namespace Freeking
+{
+	// Layout: header, bucket seeds[NumBuckets], slots[NumSlots], entries[NumEntries],
+	// names, then page-aligned file data in the order a recorded session first read it.
+	struct CookedArchiveHeader
+	{
+		uint32_t Ident;
+		uint32_t Version;
+		uint32_t NumEntries;
+		uint32_t NumBuckets;
+		uint32_t NumSlots;
+		uint32_t NamesOffset;
+		uint32_t NamesSize;
+		uint32_t DataOffset;
+	};
+
+	struct CookedArchiveEntry
+	{
+		uint64_t Offset;
+		uint64_t Size;
+		uint32_t NameOffset;
+		uint32_t NameLength;
+	};
+
+	struct CookedArchive
+	{
+		static constexpr uint32_t Ident = 0x41434B46; // "FKCA"
+		static constexpr uint32_t Version = 1;
+		static constexpr uint32_t Alignment = 4096;
+		static constexpr uint32_t EmptySlot = 0xFFFFFFFF;
+
+		// Paths are hashed after FileSystem::NormalisePath. The bucket hash picks a seed,
+		// and the seeded hash maps every path in the archive to its own slot.
+		static constexpr uint32_t BucketHash(std::string_view path) { return Hash::Fnv1a(path); }
+		static constexpr uint32_t SlotHash(std::string_view path, uint32_t seed) { return Hash::Fnv1a(path, seed); }
+	};
+}
@@ -0,0 +1,150 @@
+#include "CookedFileSystem.h"
+#include <iostream>
+
+namespace Freeking
+{
+	std::unique_ptr<CookedFileSystem> CookedFileSystem::Create(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		if (!std::filesystem::exists(path, error))
+		{
+			return nullptr;
+		}
+
+		if (auto fileSystem = std::make_unique<CookedFileSystem>(MappedFile::Open(path)); fileSystem->IsValid())
+		{
+			return fileSystem;
+		}
+
+		std::cout << "Ignoring invalid cooked archive " << path.string() << std::endl;
+
+		return nullptr;
+	}
+
+	CookedFileSystem::CookedFileSystem(std::shared_ptr<MappedFile> file) :
+		_file(std::move(file)),
+		_header(nullptr),
+		_seeds(nullptr),
+		_slots(nullptr),
+		_entries(nullptr),
+		_names(nullptr)
+	{
+		if (!_file || _file->GetSize() < sizeof(CookedArchiveHeader))
+		{
+			return;
+		}
+
+		const uint8_t* data = _file->GetData();
+		const size_t size = _file->GetSize();
+		const auto& header = *reinterpret_cast<const CookedArchiveHeader*>(data);
+
+		if (header.Ident != CookedArchive::Ident || header.Version != CookedArchive::Version || header.NumBuckets == 0 || header.NumSlots < header.NumEntries)
+		{
+			return;
+		}
+
+		size_t seedsOffset = sizeof(CookedArchiveHeader);
+		size_t slotsOffset = seedsOffset + (size_t)header.NumBuckets * sizeof(uint32_t);
+		size_t entriesOffset = slotsOffset + (size_t)header.NumSlots * sizeof(uint32_t);
+		size_t entriesEnd = entriesOffset + (size_t)header.NumEntries * sizeof(CookedArchiveEntry);
+
+		if (entriesEnd > header.NamesOffset || (size_t)header.NamesOffset + header.NamesSize > size)
+		{
+			return;
+		}
+
+		auto entries = reinterpret_cast<const CookedArchiveEntry*>(data + entriesOffset);
+
+		for (uint32_t i = 0; i < header.NumEntries; ++i)
+		{
+			const auto& entry = entries[i];
+
+			if (entry.Offset + entry.Size > size || (size_t)entry.NameOffset + entry.NameLength > header.NamesSize)
+			{
+				return;
+			}
+		}
+
+		_header = &header;
+		_seeds = reinterpret_cast<const uint32_t*>(data + seedsOffset);
+		_slots = reinterpret_cast<const uint32_t*>(data + slotsOffset);
+		_entries = entries;
+		_names = reinterpret_cast<const char*>(data + header.NamesOffset);
+	}
+
+	std::string_view CookedFileSystem::GetEntryName(const CookedArchiveEntry& entry) const
+	{
+		return std::string_view(_names + entry.NameOffset, entry.NameLength);
+	}
+
+	const CookedArchiveEntry* CookedFileSystem::FindEntry(const std::string& filename) const
+	{
+		if (!_header)
+		{
+			return nullptr;
+		}
+
+		auto path = FileSystem::NormalisePath(filename);
+		auto seed = _seeds[CookedArchive::BucketHash(path) % _header->NumBuckets];
+		auto index = _slots[CookedArchive::SlotHash(path, seed) % _header->NumSlots];
+
+		if (index >= _header->NumEntries)
+		{
+			return nullptr;
+		}
+
+		const auto& entry = _entries[index];
+
+		return (GetEntryName(entry) == path) ? &entry : nullptr;
+	}
+
+	bool CookedFileSystem::FileExists(const std::string& filename)
+	{
+		return FindEntry(filename) != nullptr;
+	}
+
+	std::vector<uint8_t> CookedFileSystem::GetFileData(const std::string& filename)
+	{
+		auto view = GetFileView(filename);
+
+		return std::vector<uint8_t>(view.begin(), view.end());
+	}
+
+	FileView CookedFileSystem::GetFileView(const std::string& filename)
+	{
+		if (auto entry = FindEntry(filename))
+		{
+			return FileView(_file->GetData() + entry->Offset, (size_t)entry->Size, _file);
+		}
+
+		return {};
+	}
+
+	void CookedFileSystem::FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& files)
+	{
+		if (!_header)
+		{
+			return;
+		}
+
+		auto prefix = FileSystem::NormalisePath(directory);
+		if (!prefix.empty() && prefix.back() != '/')
+		{
+			prefix += '/';
+		}
+
+		auto suffix = FileSystem::NormalisePath(extension);
+
+		for (uint32_t i = 0; i < _header->NumEntries; ++i)
+		{
+			auto name = GetEntryName(_entries[i]);
+
+			if (name.size() >= prefix.size() + suffix.size() &&
+				name.compare(0, prefix.size(), prefix) == 0 &&
+				name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+			{
+				files.emplace_back(name);
+			}
+		}
+	}
+}
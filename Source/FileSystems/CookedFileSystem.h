@@ -0,0 +1,37 @@
+#pragma once
+
+#include "FileSystem.h"
+#include "MappedFile.h"
+#include "CookedArchive.h"
+#include <filesystem>
+
+namespace Freeking
+{
+	class CookedFileSystem : public IFileSystem
+	{
+	public:
+
+		static std::unique_ptr<CookedFileSystem> Create(const std::filesystem::path& path);
+
+		CookedFileSystem(std::shared_ptr<MappedFile> file);
+
+		virtual bool FileExists(const std::string& filename) override;
+		virtual std::vector<uint8_t> GetFileData(const std::string& filename) override;
+		virtual FileView GetFileView(const std::string& filename) override;
+		virtual void FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& files) override;
+
+		inline bool IsValid() const { return _header != nullptr; }
+
+	private:
+
+		const CookedArchiveEntry* FindEntry(const std::string& filename) const;
+		std::string_view GetEntryName(const CookedArchiveEntry& entry) const;
+
+		std::shared_ptr<MappedFile> _file;
+		const CookedArchiveHeader* _header;
+		const uint32_t* _seeds;
+		const uint32_t* _slots;
+		const CookedArchiveEntry* _entries;
+		const char* _names;
+	};
+}
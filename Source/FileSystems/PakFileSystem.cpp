@@ -1,4 +1,5 @@
 #include "PakFileSystem.h"
+#include <cstring>
 
 namespace Freeking
 {
@@ -12,48 +13,55 @@ namespace Freeking
 		return nullptr;
 	}
 
-	PakFileSystem::PakFileSystem(const std::filesystem::path& path)
+	PakFileSystem::PakFileSystem(const std::filesystem::path& path) :
+		_file(MappedFile::Open(path))
 	{
-		_stream.open(path, std::ios::binary | std::ios::ate);
+		if (!_file || _file->GetSize() < sizeof(PakHeader))
+		{
+			_file.reset();
+			return;
+		}
 
-		PakHeader header;
-		_stream.seekg(0);
-		_stream.read((char*)&header, sizeof(header));
+		const auto& header = *reinterpret_cast<const PakHeader*>(_file->GetData());
 
-		if (header.id == Id)
+		if (header.id != Id ||
+			header.offset < 0 ||
+			header.size < 0 ||
+			(size_t)header.offset + (size_t)header.size > _file->GetSize())
 		{
-			int numFiles = header.size / sizeof(PakFileItem);
-			std::vector<PakFileItem> fileItems(numFiles);
+			_file.reset();
+			return;
+		}
 
-			_stream.seekg(header.offset);
-			_stream.read((char*)fileItems.data(), header.size);
+		int numFiles = header.size / sizeof(PakFileItem);
+		auto fileItems = reinterpret_cast<const PakFileItem*>(_file->GetData() + header.offset);
 
-			_fileItems.reserve(numFiles);
+		_fileItems.reserve(numFiles);
 
-			for (const PakFileItem& fileItem : fileItems)
+		for (int i = 0; i < numFiles; ++i)
+		{
+			const PakFileItem& fileItem = fileItems[i];
+
+			if (fileItem.offset < 0 ||
+				fileItem.size < 0 ||
+				(size_t)fileItem.offset + (size_t)fileItem.size > _file->GetSize())
 			{
-				_fileItems.emplace(
-					std::string(fileItem.name),
-					FileItem{ fileItem.offset, fileItem.size });
+				continue;
 			}
-		}
-		else
-		{
-			_stream.close();
+
+			_fileItems.emplace(
+				std::string(fileItem.name, strnlen(fileItem.name, sizeof(fileItem.name))),
+				FileItem{ fileItem.offset, fileItem.size });
 		}
 	}
 
 	PakFileSystem::~PakFileSystem()
 	{
-		if (_stream.is_open())
-		{
-			_stream.close();
-		}
 	}
 
 	bool PakFileSystem::FileExists(const std::string& filename)
 	{
-		if (!_stream.is_open())
+		if (!_file)
 		{
 			return false;
 		}
@@ -63,7 +71,14 @@ namespace Freeking
 
 	std::vector<uint8_t> PakFileSystem::GetFileData(const std::string& filename)
 	{
-		if (!_stream.is_open())
+		auto view = GetFileView(filename);
+
+		return std::vector<uint8_t>(view.begin(), view.end());
+	}
+
+	FileView PakFileSystem::GetFileView(const std::string& filename)
+	{
+		if (!_file)
 		{
 			return {};
 		}
@@ -75,10 +90,22 @@ namespace Freeking
 		}
 
 		const auto& fileItem = it->second;
-		std::vector<uint8_t> fileData(fileItem.size);
-		_stream.seekg(fileItem.offset);
-		_stream.read((char*)fileData.data(), fileItem.size);
 
-		return fileData;
+		return FileView(_file->GetData() + fileItem.offset, fileItem.size, _file);
+	}
+
+	void PakFileSystem::FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& files)
+	{
+		std::string prefix = directory.empty() ? directory : directory + "/";
+
+		for (const auto& [name, fileItem] : _fileItems)
+		{
+			if (name.size() >= prefix.size() + extension.size() &&
+				name.compare(0, prefix.size(), prefix) == 0 &&
+				name.compare(name.size() - extension.size(), extension.size(), extension) == 0)
+			{
+				files.push_back(name);
+			}
+		}
 	}
 }
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "FileSystem.h"
+#include "MappedFile.h"
 #include <filesystem>
-#include <fstream>
 #include <unordered_map>
 
 namespace Freeking
@@ -32,6 +32,8 @@ namespace Freeking
 
 		virtual bool FileExists(const std::string& filename) override;
 		virtual std::vector<uint8_t> GetFileData(const std::string& filename) override;
+		virtual FileView GetFileView(const std::string& filename) override;
+		virtual void FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& files) override;
 
 	private:
 
@@ -43,7 +45,7 @@ namespace Freeking
 
 		static const int Id = 0x4B434150;
 
-		std::ifstream _stream;
+		std::shared_ptr<MappedFile> _file;
 		std::unordered_map<std::string, FileItem> _fileItems;
 	};
 }
@@ -1,4 +1,5 @@
 #include "PhysicalFileSystem.h"
+#include "MappedFile.h"
 #include <fstream>
 
 namespace Freeking
@@ -15,12 +16,17 @@ namespace Freeking
 
 	bool PhysicalFileSystem::FileExists(const std::string& filename)
 	{
+		FileSystem::AddSyscalls(1);
+
 		return std::filesystem::exists(_path / filename);
 	}
 
 	std::vector<uint8_t> PhysicalFileSystem::GetFileData(const std::string& filename)
 	{
 		auto filepath = _path / filename;
+
+		FileSystem::AddSyscalls(3);
+
 		if (!std::filesystem::exists(_path / filename))
 		{
 			return {};
@@ -40,4 +46,34 @@ namespace Freeking
 
 		return buffer;
 	}
+
+	FileView PhysicalFileSystem::GetFileView(const std::string& filename)
+	{
+		// A failed open is the existence check, so a miss costs a single syscall.
+		if (auto file = MappedFile::Open(_path / filename))
+		{
+			return FileView(file->GetData(), file->GetSize(), file);
+		}
+
+		return {};
+	}
+
+	void PhysicalFileSystem::FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& files)
+	{
+		std::error_code error;
+		auto path = _path / directory;
+
+		if (!std::filesystem::is_directory(path, error))
+		{
+			return;
+		}
+
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(path, error))
+		{
+			if (entry.is_regular_file(error) && (extension.empty() || entry.path().extension() == extension))
+			{
+				files.push_back(entry.path().lexically_relative(_path).generic_string());
+			}
+		}
+	}
 }
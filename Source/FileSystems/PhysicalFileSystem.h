@@ -15,6 +15,8 @@ namespace Freeking
 
 		virtual bool FileExists(const std::string& filename) override;
 		virtual std::vector<uint8_t> GetFileData(const std::string& filename) override;
+		virtual FileView GetFileView(const std::string& filename) override;
+		virtual void FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& files) override;
 
 	private:
 
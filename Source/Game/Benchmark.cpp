@@ -0,0 +1,38 @@
+#include "Benchmark.h"
+#include <iostream>
+
+namespace Freeking
+{
+	Benchmark::Registrar::Registrar(const char* name, Function function)
+	{
+		GetBenchmarks().emplace(name, function);
+	}
+
+	std::map<std::string, Benchmark::Function>& Benchmark::GetBenchmarks()
+	{
+		static std::map<std::string, Function> benchmarks;
+		return benchmarks;
+	}
+
+	bool Benchmark::Run(const std::string& name)
+	{
+		const auto& benchmarks = GetBenchmarks();
+
+		if (auto it = benchmarks.find(name); it != benchmarks.end())
+		{
+			std::cout << "Running benchmark \"" << name << "\"" << std::endl;
+			it->second();
+
+			return true;
+		}
+
+		std::cout << "Unknown benchmark \"" << name << "\", available benchmarks:" << std::endl;
+
+		for (const auto& [benchmarkName, function] : benchmarks)
+		{
+			std::cout << "  " << benchmarkName << std::endl;
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <map>
+
+namespace Freeking
+{
+	class Benchmark
+	{
+	public:
+
+		using Function = void(*)();
+
+		struct Registrar
+		{
+			Registrar(const char* name, Function function);
+		};
+
+		Benchmark() = delete;
+		~Benchmark() = delete;
+
+		static bool Run(const std::string& name);
+
+	private:
+
+		static std::map<std::string, Function>& GetBenchmarks();
+	};
+}
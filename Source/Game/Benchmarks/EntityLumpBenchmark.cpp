@@ -0,0 +1,64 @@
+#include "Benchmark.h"
+#include "FileSystem.h"
+#include "BspFile.h"
+#include "EntityLump.h"
+#include "AllocationCounter.h"
+#include <chrono>
+#include <iostream>
+
+namespace Freeking
+{
+	static void EntityLumpBenchmark()
+	{
+		static const int iterations = 100;
+
+		if (!AllocationCounter::IsEnabled())
+		{
+			std::cout << "Allocation counts need FREEKING_TRACK_ALLOCATIONS" << std::endl;
+		}
+
+		double totalSeconds = 0.0;
+		size_t totalAllocations = 0;
+		size_t numMaps = 0;
+
+		for (const auto& mapPath : FileSystem::FindFiles("maps", ".bsp"))
+		{
+			auto fileData = FileSystem::GetFileView(mapPath);
+			auto bspFile = BspFile::Create(fileData.data(), fileData.size());
+			if (!bspFile)
+			{
+				continue;
+			}
+
+			auto entities = bspFile->GetLumpArray<char>(bspFile->Header.Entities);
+			std::string_view entityString(entities.Data(), entities.Num());
+
+			size_t numEntities = 0;
+			size_t allocations = AllocationCounter::GetCount();
+			auto begin = std::chrono::steady_clock::now();
+
+			for (int i = 0; i < iterations; ++i)
+			{
+				EntityLump lump;
+				lump.Parse(entityString);
+				numEntities = lump.GetEntities().size();
+			}
+
+			auto end = std::chrono::steady_clock::now();
+			allocations = AllocationCounter::GetCount() - allocations;
+
+			double seconds = std::chrono::duration<double>(end - begin).count() / iterations;
+
+			std::cout << mapPath << ": " << numEntities << " entities, " << entityString.size() << " bytes, " <<
+				seconds * 1e6 << "us, " << allocations / iterations << " allocations" << std::endl;
+
+			totalSeconds += seconds;
+			totalAllocations += allocations / iterations;
+			numMaps++;
+		}
+
+		std::cout << numMaps << " maps: " << totalSeconds * 1e3 << "ms, " << totalAllocations << " allocations" << std::endl;
+	}
+
+	static Benchmark::Registrar registrar("entitylump", EntityLumpBenchmark);
+}
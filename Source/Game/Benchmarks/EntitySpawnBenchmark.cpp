@@ -0,0 +1,78 @@
+#include "Benchmark.h"
+#include "Map.h"
+#include "EntityPool.h"
+#include "AllocationCounter.h"
+#include "Entities/Props/ARat.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace Freeking
+{
+	// Spawns and despawns rounds of entities in a loaded map through their pool, then checks
+	// the despawned handles no longer resolve. Once the pool is reserved, a round should not
+	// allocate and the pool should not grow.
+	static void EntitySpawnBenchmark()
+	{
+		static const int rounds = 100;
+		static const size_t spawnsPerRound = 64;
+
+		if (!AllocationCounter::IsEnabled())
+		{
+			std::cout << "Allocation counts need FREEKING_TRACK_ALLOCATIONS" << std::endl;
+		}
+
+		Map map("sr1");
+
+		EntityPool<Entity::Props::ARat>::Reserve(spawnsPerRound);
+		size_t capacity = EntityPool<Entity::Props::ARat>::GetCapacity();
+
+		std::vector<EntityHandle> handles;
+		handles.reserve(spawnsPerRound);
+
+		size_t numSpawned = 0;
+		size_t numStale = 0;
+		size_t allocations = AllocationCounter::GetCount();
+		auto begin = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < rounds; ++i)
+		{
+			handles.clear();
+
+			for (size_t j = 0; j < spawnsPerRound; ++j)
+			{
+				handles.push_back(map.SpawnEntity<Entity::Props::ARat>([](Entity::Props::ARat&) {}));
+			}
+
+			for (const auto& handle : handles)
+			{
+				map.DespawnEntity(handle);
+			}
+
+			// Despawned entities are released at the end of the tick.
+			map.Tick(0.0);
+
+			for (const auto& handle : handles)
+			{
+				if (!map.GetEntity(handle))
+				{
+					numStale++;
+				}
+			}
+
+			numSpawned += handles.size();
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		allocations = AllocationCounter::GetCount() - allocations;
+
+		double seconds = std::chrono::duration<double>(end - begin).count() / rounds;
+
+		std::cout << spawnsPerRound << " spawns per round: " << seconds * 1e6 << "us, " <<
+			allocations / rounds << " allocations, including a map tick" << std::endl;
+		std::cout << numStale << " of " << numSpawned << " despawned handles no longer resolve" << std::endl;
+		std::cout << "Pool capacity " << capacity << " -> " << EntityPool<Entity::Props::ARat>::GetCapacity() << std::endl;
+	}
+
+	static Benchmark::Registrar registrar("entityspawn", EntitySpawnBenchmark);
+}
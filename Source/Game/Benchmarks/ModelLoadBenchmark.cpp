@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+#include "FileSystem.h"
+#include "DynamicModelData.h"
+#include "MdxFile.h"
+#include "Md2File.h"
+#include "AssetLoadQueue.h"
+#include "AllocationCounter.h"
+#include <chrono>
+#include <iostream>
+
+namespace Freeking
+{
+	// Decodes every model from its source and from the cooked form the loaders prefer. LOD
+	// generation is timed on its own, as the cooked form skips it.
+	static void ModelLoadBenchmark()
+	{
+		using Clock = std::chrono::steady_clock;
+
+		if (!AllocationCounter::IsEnabled())
+		{
+			std::cout << "Allocation counts need FREEKING_TRACK_ALLOCATIONS" << std::endl;
+		}
+
+		AssetLoadQueue::Start();
+
+		std::vector<std::string> modelPaths = FileSystem::FindFiles("models", ".mdx");
+		for (auto& path : FileSystem::FindFiles("models", ".md2"))
+		{
+			modelPaths.push_back(std::move(path));
+		}
+
+		double parseSeconds = 0.0;
+		double lodSeconds = 0.0;
+		double cookedSeconds = 0.0;
+		size_t parseAllocations = 0;
+		size_t cookedAllocations = 0;
+		size_t numModels = 0;
+		size_t numFrameVertices = 0;
+
+		for (const auto& modelPath : modelPaths)
+		{
+			auto fileData = FileSystem::GetFileView(modelPath);
+			bool mdx = modelPath.size() >= 4 && modelPath.compare(modelPath.size() - 4, 4, ".mdx") == 0;
+
+			size_t allocations = AllocationCounter::GetCount();
+			auto begin = Clock::now();
+
+			DynamicModelData model;
+			BinaryReader reader(fileData);
+			if (!(mdx ? MDXFile::Read(reader, model) : MD2File::Read(reader, model)))
+			{
+				continue;
+			}
+
+			model.BuildFrameAnimations();
+
+			auto parsed = Clock::now();
+			parseAllocations += AllocationCounter::GetCount() - allocations;
+
+			model.GenerateLods();
+
+			auto end = Clock::now();
+			auto cooked = model.WriteCooked();
+
+			allocations = AllocationCounter::GetCount();
+			auto cookedBegin = Clock::now();
+
+			DynamicModelData cookedModel;
+			if (!cookedModel.ReadCooked(cooked.data(), cooked.size()))
+			{
+				std::cout << modelPath << ": cooked copy failed to read back" << std::endl;
+				continue;
+			}
+
+			auto cookedEnd = Clock::now();
+			cookedAllocations += AllocationCounter::GetCount() - allocations;
+
+			parseSeconds += std::chrono::duration<double>(parsed - begin).count();
+			lodSeconds += std::chrono::duration<double>(end - parsed).count();
+			cookedSeconds += std::chrono::duration<double>(cookedEnd - cookedBegin).count();
+			numFrameVertices += model.FrameVertices.size();
+			numModels++;
+		}
+
+		std::cout << numModels << " models, " << numFrameVertices << " frame vertices" << std::endl;
+		std::cout << "Source: " << parseSeconds * 1e3 << "ms parse, " << lodSeconds * 1e3 << "ms LODs, " << parseAllocations << " allocations" << std::endl;
+		std::cout << "Cooked: " << cookedSeconds * 1e3 << "ms, " << cookedAllocations << " allocations" << std::endl;
+	}
+
+	static Benchmark::Registrar registrar("modelload", ModelLoadBenchmark);
+}
@@ -0,0 +1,127 @@
+#include "Benchmark.h"
+#include "FileSystem.h"
+#include "Name.h"
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+
+namespace Freeking
+{
+	template <typename Function>
+	static void TimeLookups(const char* label, size_t numLookups, Function function)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		size_t found = function();
+		auto end = std::chrono::steady_clock::now();
+
+		double nanoseconds = std::chrono::duration<double, std::nano>(end - begin).count() / numLookups;
+		std::cout << label << ": " << nanoseconds << "ns per lookup (" << found << " found)" << std::endl;
+	}
+
+	static void NameBenchmark()
+	{
+		static const int iterations = 100;
+
+		std::vector<std::string> strings;
+
+		for (const auto& directory : { "models", "textures", "sound", "sprites" })
+		{
+			auto files = FileSystem::FindFiles(directory, "");
+			strings.insert(strings.end(), files.begin(), files.end());
+		}
+
+		if (strings.empty())
+		{
+			for (int i = 0; i < 4096; ++i)
+			{
+				strings.push_back("models/props/prop" + std::to_string(i) + "/skin.tga");
+			}
+		}
+
+		std::unordered_map<std::string, int> stringMap;
+		std::unordered_map<Name, int> nameMap;
+		std::vector<Name> names;
+
+		for (size_t i = 0; i < strings.size(); ++i)
+		{
+			stringMap.emplace(strings[i], static_cast<int>(i));
+			nameMap.emplace(Name(strings[i]), static_cast<int>(i));
+			names.push_back(Name(strings[i]));
+		}
+
+		size_t numLookups = strings.size() * iterations;
+		std::cout << strings.size() << " strings, " << Name::GetCount() << " names interned" << std::endl;
+
+		TimeLookups("std::string key from const char*", numLookups, [&]()
+		{
+			size_t found = 0;
+			for (int i = 0; i < iterations; ++i)
+			{
+				for (const auto& string : strings)
+				{
+					found += stringMap.count(std::string(string.c_str()));
+				}
+			}
+			return found;
+		});
+
+		TimeLookups("std::filesystem::path key with slash rewrite", numLookups, [&]()
+		{
+			size_t found = 0;
+			for (int i = 0; i < iterations; ++i)
+			{
+				for (const auto& string : strings)
+				{
+					auto path = (std::filesystem::path("") / string).string();
+					std::replace(path.begin(), path.end(), '\\', '/');
+					found += stringMap.count(path);
+				}
+			}
+			return found;
+		});
+
+		TimeLookups("Name interned from const char*", numLookups, [&]()
+		{
+			size_t found = 0;
+			for (int i = 0; i < iterations; ++i)
+			{
+				for (const auto& string : strings)
+				{
+					found += nameMap.count(Name(string.c_str()));
+				}
+			}
+			return found;
+		});
+
+		TimeLookups("Name resolved up front", numLookups, [&]()
+		{
+			size_t found = 0;
+			for (int i = 0; i < iterations; ++i)
+			{
+				for (const auto& name : names)
+				{
+					found += nameMap.count(name);
+				}
+			}
+			return found;
+		});
+
+		TimeLookups("Name equality", numLookups, [&]()
+		{
+			size_t found = 0;
+			for (int i = 0; i < iterations; ++i)
+			{
+				for (const auto& name : names)
+				{
+					found += (name == names[i % names.size()]);
+				}
+			}
+			return found;
+		});
+	}
+
+	static Benchmark::Registrar registrar("names", NameBenchmark);
+}
@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+#include "FileSystem.h"
+#include "FilePrefetcher.h"
+#include <filesystem>
+#include <iostream>
+
+namespace Freeking
+{
+	// Cold load timings with and without prefetch for every map with a read recording,
+	// made by running the game once with -recordreads. Before each pass the recorded files
+	// are dropped from the page cache. The pass then reads them in recorded order and sums
+	// every byte, which stands in for the loaders' decoding. Dropping pages is best effort;
+	// for a strict cold start, drop the system caches before running instead.
+	static void PrefetchBenchmark()
+	{
+		std::error_code error;
+		auto cacheDirectory = std::filesystem::current_path() / "Cache";
+		bool prefetchEnabled = FilePrefetcher::IsEnabled();
+		bool recording = FilePrefetcher::IsRecording();
+		size_t numMaps = 0;
+
+		FilePrefetcher::SetRecording(false);
+
+		for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory, error))
+		{
+			if (entry.path().extension() != ".reads")
+			{
+				continue;
+			}
+
+			auto name = entry.path().stem().string();
+			auto reads = FilePrefetcher::GetRecordedReads(name);
+			if (reads.empty())
+			{
+				continue;
+			}
+
+			double loadTimes[2] = {};
+			uint64_t checksum = 0;
+			size_t evictedBytes = 0;
+
+			for (int prefetch = 0; prefetch < 2; ++prefetch)
+			{
+				evictedBytes = 0;
+				for (const auto& read : reads)
+				{
+					evictedBytes += FileSystem::Evict(read.path, read.offset, read.size);
+				}
+
+				FilePrefetcher::SetEnabled(prefetch != 0);
+				FilePrefetcher::BeginLoad(name);
+
+				for (const auto& read : reads)
+				{
+					auto view = FileSystem::GetFileView(read.path);
+					for (auto byte : view)
+					{
+						checksum += byte;
+					}
+				}
+
+				FilePrefetcher::EndLoad();
+				loadTimes[prefetch] = FilePrefetcher::GetLastLoadTime();
+			}
+
+			std::cout << name << ": " << reads.size() << " files, " << evictedBytes / (1024 * 1024) << " MB evicted, "
+				<< "cold " << loadTimes[0] * 1e3 << "ms without prefetch, " << loadTimes[1] * 1e3 << "ms with prefetch"
+				<< " (checksum " << checksum << ")" << std::endl;
+
+			numMaps++;
+		}
+
+		if (numMaps == 0)
+		{
+			std::cout << "No read recordings in " << cacheDirectory << ", run a map load with -recordreads first" << std::endl;
+		}
+
+		FilePrefetcher::SetEnabled(prefetchEnabled);
+		FilePrefetcher::SetRecording(recording);
+	}
+
+	static Benchmark::Registrar registrar("prefetch", PrefetchBenchmark);
+}
@@ -14,8 +14,9 @@ namespace Freeking::Entity::Func
 
 	bool AExplosive::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("spawnflags"))
+		switch (property.GetKeyId())
 		{
+		case "spawnflags"_key:
 			return property.ValueAsFlags(_spawnFlags);
 		}
 
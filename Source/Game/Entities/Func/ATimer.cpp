@@ -37,12 +37,11 @@ namespace Freeking::Entity::Func
 
 	bool ATimer::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("wait"))
+		switch (property.GetKeyId())
 		{
+		case "wait"_key:
 			return property.ValueAsFloat(_wait);
-		}
-		else if (property.IsKey("random"))
-		{
+		case "random"_key:
 			return property.ValueAsFloat(_random);
 		}
 
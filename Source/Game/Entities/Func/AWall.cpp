@@ -24,8 +24,9 @@ namespace Freeking::Entity::Func
 
 	bool AWall::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("spawnflags"))
+		switch (property.GetKeyId())
 		{
+		case "spawnflags"_key:
 			return property.ValueAsFlags(_spawnFlags);
 		}
 
@@ -1,4 +1,5 @@
 #include "AChangelevel.h"
+#include "Map.h"
 
 namespace Freeking::Entity::Target
 {
@@ -14,8 +15,35 @@ namespace Freeking::Entity::Target
 	{
 	}
 
+	void AChangelevel::OnTrigger()
+	{
+		// Unit changes are written "*map" and spawn points "map$spawn"; neither is
+		// needed to load the map itself.
+		auto mapName = _map.substr(0, _map.find('$'));
+
+		if (!mapName.empty() && mapName.front() == '*')
+		{
+			mapName.erase(0, 1);
+		}
+
+		if (!mapName.empty())
+		{
+			Map::Current->ChangeLevel(mapName);
+		}
+	}
+
 	bool AChangelevel::SetProperty(const EntityProperty& property)
 	{
-		return false;
+		switch (property.GetKeyId())
+		{
+		case "map"_key:
+		{
+			_map = property.Value();
+
+			return true;
+		}
+		}
+
+		return BaseEntity::SetProperty(property);
 	}
 }
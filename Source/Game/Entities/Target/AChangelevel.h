@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BaseEntity.h"
+#include <string>
 
 namespace Freeking::Entity::Target
 {
@@ -15,9 +16,12 @@ namespace Freeking::Entity::Target
 
 	protected:
 
+		virtual void OnTrigger() override;
+
 		virtual bool SetProperty(const EntityProperty& property) override;
 
     private:
 
+		std::string _map;
     };
 }
@@ -10,8 +10,7 @@ namespace Freeking::Entity::Target
 		_spawnFlags(SpawnFlags::None),
 		_noise(""),
 		_attenuation(1),
-		_volume(1.0f),
-		_audioClip(nullptr)
+		_volume(1.0f)
 	{
 	}
 
@@ -22,14 +21,11 @@ namespace Freeking::Entity::Target
 		auto noisePath = std::filesystem::path("sound") / _noise;
 		noisePath.replace_extension("wav");
 
-		if (const auto& audioClip = AudioClip::Library.Get(noisePath.string()))
+		if (_audioClip = AudioClip::Library.Get(noisePath.string()); _audioClip)
 		{
-			if (_audioClip = audioClip.get(); _audioClip)
+			if (_spawnFlags[SpawnFlags::LoopedOn])
 			{
-				if (_spawnFlags[SpawnFlags::LoopedOn])
-				{
-					AudioDevice::Current->Play(_audioClip, GetPosition(), true, false, true);
-				}
+				AudioDevice::Current->Play(_audioClip.get(), GetPosition(), true, false, true);
 			}
 		}
 	}
@@ -43,28 +39,25 @@ namespace Freeking::Entity::Target
 	{
 		if (_audioClip)
 		{
-			AudioDevice::Current->Play(_audioClip, GetPosition(), false, _attenuation == -1);
+			AudioDevice::Current->Play(_audioClip.get(), GetPosition(), false, _attenuation == -1);
 		}
 	}
 
 	bool ASpeaker::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("spawnflags"))
+		switch (property.GetKeyId())
 		{
+		case "spawnflags"_key:
 			return property.ValueAsFlags(_spawnFlags);
-		}
-		else if (property.IsKey("noise"))
+		case "noise"_key:
 		{
 			_noise = property.Value();
 
 			return true;
 		}
-		else if (property.IsKey("attenuation"))
-		{
+		case "attenuation"_key:
 			return property.ValueAsInt(_attenuation);
-		}
-		else if (property.IsKey("volume"))
-		{
+		case "volume"_key:
 			return property.ValueAsFloat(_volume);
 		}
 
@@ -2,7 +2,8 @@
 
 namespace Freeking::Entity::Trigger
 {
-	ACounter::ACounter() : BaseEntity()
+	ACounter::ACounter() : BaseEntity(),
+		_count(2)
 	{
 	}
 
@@ -14,8 +15,28 @@ namespace Freeking::Entity::Trigger
 	{
 	}
 
+	void ACounter::Trigger()
+	{
+		if (_count <= 0)
+		{
+			return;
+		}
+
+		if (--_count == 0)
+		{
+			OnTrigger();
+			TriggerTarget();
+		}
+	}
+
 	bool ACounter::SetProperty(const EntityProperty& property)
 	{
-		return false;
+		switch (property.GetKeyId())
+		{
+		case "count"_key:
+			return property.ValueAsInt(_count);
+		}
+
+		return BaseEntity::SetProperty(property);
 	}
 }
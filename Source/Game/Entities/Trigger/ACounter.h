@@ -15,9 +15,12 @@ namespace Freeking::Entity::Trigger
 
 	protected:
 
+        virtual void Trigger() override;
+
 		virtual bool SetProperty(const EntityProperty& property) override;
 
     private:
 
+        int _count;
     };
 }
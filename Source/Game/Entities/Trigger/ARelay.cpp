@@ -1,38 +1,23 @@
 #include "ARelay.h"
-#include "TimeUtil.h"
 
 namespace Freeking::Entity::Trigger
 {
 	ARelay::ARelay() : BaseEntity(),
-		_delay(0.0f),
-		_timeToTrigger(0.0),
-		_triggered(false)
+		_delay(0.0f)
 	{
 	}
 
-	void ARelay::Tick(double dt)
-	{
-		BaseEntity::Tick(dt);
-
-		if (_triggered && _timeToTrigger < Time::Now())
-		{
-			_triggered = false;
-			_timeToTrigger = 0.0;
-
-			TriggerTarget();
-		}
-	}
-
 	void ARelay::Trigger()
 	{
-		_triggered = true;
-		_timeToTrigger = Time::Now() + _delay;
+		OnTrigger();
+		TriggerTarget(_delay);
 	}
 
 	bool ARelay::SetProperty(const EntityProperty& property)
 	{
-		if (property.IsKey("delay"))
+		switch (property.GetKeyId())
 		{
+		case "delay"_key:
 			return property.ValueAsFloat(_delay);
 		}
 
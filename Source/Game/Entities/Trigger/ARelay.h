@@ -10,8 +10,6 @@ namespace Freeking::Entity::Trigger
 
         ARelay();
 
-		virtual void Tick(double dt) override;
-
 	protected:
 
         virtual void Trigger() override;
@@ -21,7 +19,5 @@ namespace Freeking::Entity::Trigger
     private:
 
         float _delay;
-        double _timeToTrigger;
-        bool _triggered;
     };
 }
@@ -18,20 +18,30 @@
 #include "SpriteBatch.h"
 #include "Font.h"
 #include "DynamicModel.h"
+#include "DynamicModelBatch.h"
+#include "CastModel.h"
+#include "AnimationScheduler.h"
 #include "Util.h"
 #include "Map.h"
 #include "Paths.h"
 #include "Nav/NavFile.h"
 #include "PakFileSystem.h"
 #include "PhysicalFileSystem.h"
+#include "CookedFileSystem.h"
 #include "Renderer.h"
 #include "TimeUtil.h"
 #include "Audio/AudioClip.h"
 #include "Audio/AudioDevice.h"
 #include "Skybox.h"
 #include "BillboardBatch.h"
+#include "StreamingBuffer.h"
 #include "RenderTarget.h"
+#include "Benchmark.h"
+#include "AssetLoadQueue.h"
+#include "FilePrefetcher.h"
+#include "TextureStreamer.h"
 #include <glad/gl.h>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <memory>
@@ -44,9 +54,54 @@
 
 namespace Freeking
 {
-	Game::Game(int argc, char** argv)
+	Game::Game(int argc, char** argv) :
+		_startMap("sr1")
 	{
+		for (int i = 1; i < argc; ++i)
+		{
+			if (std::string(argv[i]) == "-benchmark" && (i + 1) < argc)
+			{
+				_benchmark = argv[++i];
+			}
+			else if (std::string(argv[i]) == "-recordaccess" && (i + 1) < argc)
+			{
+				FileSystem::StartAccessLog(argv[++i]);
+			}
+			else if (std::string(argv[i]) == "-noprefetch")
+			{
+				FilePrefetcher::SetEnabled(false);
+			}
+			else if (std::string(argv[i]) == "-recordreads")
+			{
+				FilePrefetcher::SetRecording(true);
+			}
+			else if (std::string(argv[i]) == "-nostreaming")
+			{
+				TextureStreamer::SetEnabled(false);
+			}
+			else if (std::string(argv[i]) == "-texturebudget" && (i + 1) < argc)
+			{
+				// Budget in megabytes. Values that don't parse are ignored.
+				if (int megabytes; Util::TryParseInt(argv[++i], megabytes) && megabytes > 0)
+				{
+					TextureStreamer::SetBudget((size_t)megabytes * 1024 * 1024);
+				}
+			}
+			else if (std::string(argv[i]) == "-assetbudget" && (i + 1) < argc)
+			{
+				if (int megabytes; Util::TryParseInt(argv[++i], megabytes) && megabytes > 0)
+				{
+					AssetLibraryBase::SetResidencyBudget((size_t)megabytes * 1024 * 1024);
+				}
+			}
+			else if (std::string(argv[i]) == "-map" && (i + 1) < argc)
+			{
+				_startMap = argv[++i];
+			}
+		}
+
 		FileSystem::AddFileSystem(PhysicalFileSystem::Create(std::filesystem::current_path() / "Assets"));
+		FileSystem::AddFileSystem(CookedFileSystem::Create(Paths::KingpinDir() / "main/Pak0.fka"));
 		FileSystem::AddFileSystem(PhysicalFileSystem::Create(Paths::KingpinDir() / "main"));
 		FileSystem::AddFileSystem(PakFileSystem::Create(Paths::KingpinDir() / "main/Pak0.pak"));
 
@@ -99,6 +154,41 @@ namespace Freeking
 		Input::ResetMouseDelta();
 	}
 
+	static const std::array<std::pair<const char*, const AssetLibraryBase*>, 3>& GetResidencyLibraries()
+	{
+		static const std::array<std::pair<const char*, const AssetLibraryBase*>, 3> libraries =
+		{ {
+			{ "Textures", &Texture2D::Library },
+			{ "Models", &DynamicModel::Library },
+			{ "Sounds", &AudioClip::Library },
+		} };
+
+		return libraries;
+	}
+
+	static void PrintResidencyReport()
+	{
+		constexpr double megabyte = 1024.0 * 1024.0;
+
+		for (const auto& [label, library] : GetResidencyLibraries())
+		{
+			const auto& report = library->GetResidencyReport();
+
+			std::cout << label << ": "
+				<< report.retained.size() << " retained (" << report.numShared << " shared, " << (report.retainedBytes / megabyte) << " MB), "
+				<< report.evicted.size() << " evicted (" << (report.evictedBytes / megabyte) << " MB), "
+				<< report.reloaded.size() << " reloaded (" << (report.reloadedBytes / megabyte) << " MB)" << std::endl;
+
+			for (const auto& name : report.reloaded)
+			{
+				std::cout << "  reloaded " << name.ToStringView() << std::endl;
+			}
+		}
+
+		std::cout << "Resident assets: " << (AssetLibraryBase::GetTotalResidentBytes() / megabyte) << " MB, budget "
+			<< (AssetLibraryBase::GetResidencyBudget() / megabyte) << " MB" << std::endl;
+	}
+
 	static void ImGuiDebugAssetLibrary()
 	{
 		ImGui::SetNextWindowSize(ImVec2(800, 1000), ImGuiCond_Once);
@@ -111,8 +201,10 @@ namespace Freeking
 			int lineWidth = 0;
 			int i = 0;
 
-			for (auto const& [name, texture] : Texture2D::Library.GetPathAssets())
+			for (auto const& [name, resident] : Texture2D::Library.GetPathAssets())
 			{
+				const auto& texture = resident.asset;
+
 				if ((lineWidth + texture->GetWidth()) < windowWidth)
 				{
 					lineWidth += (texture->GetWidth() + 10);
@@ -134,7 +226,7 @@ namespace Freeking
 
 				if (ImGui::IsItemHovered())
 				{
-					ImGui::SetTooltip("%s", name.c_str());
+					ImGui::SetTooltip("%s", name.ToStringView().data());
 				}
 
 				ImGui::SameLine();
@@ -145,6 +237,186 @@ namespace Freeking
 			ImGui::EndTabItem();
 		}
 
+		if (ImGui::BeginTabItem("Names"))
+		{
+			ImGui::Text("Names: %zu", Name::GetCount());
+			ImGui::Text("Table capacity: %zu", Name::GetCapacity());
+			ImGui::Text("String bytes: %zu", Name::GetStringBytes());
+			ImGui::Text("Hash collisions: %zu", Name::GetHashCollisions());
+
+			ImGui::EndTabItem();
+		}
+
+		if (ImGui::BeginTabItem("Loading"))
+		{
+			ImGui::Text("Indexed files: %zu", FileSystem::GetNumIndexedFiles());
+			ImGui::SameLine();
+
+			// Picks up files added to the directory mounts since startup. Workers look files up
+			// in the index while loading, so it is only rebuilt when nothing is loading.
+			if (ImGui::Button("Refresh") && AssetLoadQueue::GetNumPendingDecodes() == 0 && !FilePrefetcher::IsLoading())
+			{
+				FileSystem::Refresh();
+				Texture2D::Library.ClearMissingAssets();
+				DynamicModel::Library.ClearMissingAssets();
+				AudioClip::Library.ClearMissingAssets();
+			}
+
+			ImGui::Text("File system syscalls: %zu", FileSystem::GetNumSyscalls());
+			ImGui::Text("Workers: %zu", AssetLoadQueue::GetNumWorkers());
+			ImGui::Text("Pending decodes: %zu", AssetLoadQueue::GetNumPendingDecodes());
+			ImGui::Text("Pending uploads: %zu", AssetLoadQueue::GetNumPendingUploads());
+			ImGui::Text("Pending textures: %zu", Texture2D::Library.GetNumPendingAssets());
+			ImGui::Text("Texture memory: %.1f MB", Texture2D::GetTotalBytes() / (1024.0 * 1024.0));
+			ImGui::Text("Pending models: %zu", DynamicModel::Library.GetNumPendingAssets());
+			ImGui::Text("Pending sounds: %zu", AudioClip::Library.GetNumPendingAssets());
+			ImGui::Separator();
+			ImGui::Text("Texture gets/loads per frame: %zu/%zu", Texture2D::Library.GetFrameGets(), Texture2D::Library.GetFrameLoads());
+			ImGui::Text("Model gets/loads per frame: %zu/%zu", DynamicModel::Library.GetFrameGets(), DynamicModel::Library.GetFrameLoads());
+			ImGui::Text("Sound gets/loads per frame: %zu/%zu", AudioClip::Library.GetFrameGets(), AudioClip::Library.GetFrameLoads());
+			ImGui::Text("Shader gets/loads per frame: %zu/%zu", Shader::Library.GetFrameGets(), Shader::Library.GetFrameLoads());
+			ImGui::Text("Missing textures: %zu", Texture2D::Library.GetNumMissingAssets());
+			ImGui::Text("Missing sounds: %zu", AudioClip::Library.GetNumMissingAssets());
+			ImGui::Separator();
+			ImGui::Text("Prefetch: %s", FilePrefetcher::IsEnabled() ? "on" : "off");
+			ImGui::Text("Read recording: %s", FilePrefetcher::IsRecording() ? "on" : "off");
+			ImGui::Text("Prefetched files: %zu (%.1f MB)", FilePrefetcher::GetNumPrefetchedFiles(), FilePrefetcher::GetNumPrefetchedBytes() / (1024.0 * 1024.0));
+			ImGui::Text("Last load time: %.3fs", FilePrefetcher::GetLastLoadTime());
+
+			ImGui::EndTabItem();
+		}
+
+		if (ImGui::BeginTabItem("Streaming"))
+		{
+			int budgetMegabytes = (int)(TextureStreamer::GetBudget() / (1024 * 1024));
+			if (ImGui::SliderInt("Budget (MB)", &budgetMegabytes, 16, 4096))
+			{
+				TextureStreamer::SetBudget((size_t)budgetMegabytes * 1024 * 1024);
+			}
+
+			ImGui::Text("Texture memory: %.1f MB", Texture2D::GetTotalBytes() / (1024.0 * 1024.0));
+			ImGui::Text("Cast skin memory: %.1f MB", CastModel::GetTotalSkinBytes() / (1024.0 * 1024.0));
+			ImGui::Text("Streamed textures: %zu", TextureStreamer::GetNumTextures());
+			ImGui::Text("Pending loads: %zu", TextureStreamer::GetNumPendingLoads());
+			ImGui::Text("Evictions: %zu", TextureStreamer::GetNumEvictions());
+			ImGui::Separator();
+
+			auto textures = TextureStreamer::GetTextureInfo();
+			std::sort(textures.begin(), textures.end(), [](const auto& a, const auto& b) { return a.numBytes > b.numBytes; });
+
+			ImGui::Columns(5, "streaming");
+			ImGui::Text("Texture"); ImGui::NextColumn();
+			ImGui::Text("Size"); ImGui::NextColumn();
+			ImGui::Text("Resident"); ImGui::NextColumn();
+			ImGui::Text("Requested"); ImGui::NextColumn();
+			ImGui::Text("KB"); ImGui::NextColumn();
+			ImGui::Separator();
+
+			ImGuiListClipper clipper((int)textures.size());
+			while (clipper.Step())
+			{
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+				{
+					const auto& texture = textures[i];
+					bool missing = texture.requestedLevel < texture.residentLevel;
+
+					ImGui::Text("%s", texture.name.c_str()); ImGui::NextColumn();
+					ImGui::Text("%ux%u", texture.width, texture.height); ImGui::NextColumn();
+					ImGui::Text("%u/%u%s", texture.residentLevel, texture.numLevels, texture.pending ? " (loading)" : ""); ImGui::NextColumn();
+					ImGui::TextColored(missing ? ImVec4(1, 0.5f, 0, 1) : ImVec4(1, 1, 1, 1), "%u (%llu frames ago)", texture.requestedLevel, (unsigned long long)texture.framesUnused); ImGui::NextColumn();
+					ImGui::Text("%zu", texture.numBytes / 1024); ImGui::NextColumn();
+				}
+			}
+
+			ImGui::Columns(1);
+			ImGui::EndTabItem();
+		}
+
+		if (ImGui::BeginTabItem("Residency"))
+		{
+			static char mapName[64] = "";
+			ImGui::InputText("Map", mapName, sizeof(mapName));
+			ImGui::SameLine();
+			if (ImGui::Button("Change level") && mapName[0] != '\0' && Map::Current)
+			{
+				Map::Current->ChangeLevel(mapName);
+			}
+
+			int budgetMegabytes = (int)(AssetLibraryBase::GetResidencyBudget() / (1024 * 1024));
+			if (ImGui::SliderInt("Budget (MB)", &budgetMegabytes, 0, 4096))
+			{
+				AssetLibraryBase::SetResidencyBudget((size_t)budgetMegabytes * 1024 * 1024);
+			}
+
+			ImGui::Text("Resident assets: %.1f MB", AssetLibraryBase::GetTotalResidentBytes() / (1024.0 * 1024.0));
+			ImGui::Separator();
+
+			for (const auto& [label, library] : GetResidencyLibraries())
+			{
+				const auto& report = library->GetResidencyReport();
+
+				if (!ImGui::TreeNode(label, "%s: %zu retained (%zu shared), %zu evicted, %zu reloaded",
+					label, report.retained.size(), report.numShared, report.evicted.size(), report.reloaded.size()))
+				{
+					continue;
+				}
+
+				for (const auto& [heading, names] : { std::make_pair("Evicted", &report.evicted), std::make_pair("Reloaded", &report.reloaded) })
+				{
+					if (ImGui::TreeNode(heading, "%s (%zu)", heading, names->size()))
+					{
+						for (const auto& name : *names)
+						{
+							ImGui::Text("%s", name.ToStringView().data());
+						}
+
+						ImGui::TreePop();
+					}
+				}
+
+				ImGui::TreePop();
+			}
+
+			ImGui::EndTabItem();
+		}
+
+		if (ImGui::BeginTabItem("Models"))
+		{
+			if (Map::Current)
+			{
+				const auto& batch = Map::Current->GetDynamicModelBatch();
+				ImGui::Text("Instances: %zu", batch.GetNumInstances());
+				ImGui::Text("Draw calls: %zu", batch.GetNumDrawCalls());
+				ImGui::Text("Triangles: %zu", batch.GetNumTriangles());
+
+				const auto& staticBatch = Map::Current->GetStaticModelBatch();
+				ImGui::Separator();
+				ImGui::Text("Static instances: %zu", staticBatch.GetNumInstances());
+				ImGui::Text("Static draw calls: %zu", staticBatch.GetNumDrawCalls());
+				ImGui::Text("Static triangles: %zu", staticBatch.GetNumTriangles());
+				ImGui::Text("Static rebuilds: %zu", staticBatch.GetNumRebuilds());
+
+				const auto& queue = Map::Current->GetRenderQueue();
+				ImGui::Separator();
+				ImGui::Text("Render packets: %zu", queue.GetNumPackets());
+				ImGui::Text("Program switches: %zu", queue.GetNumProgramSwitches());
+				ImGui::Text("Texture switches: %zu", queue.GetNumTextureSwitches());
+				ImGui::Text("Binding switches: %zu", queue.GetNumBindingSwitches());
+				ImGui::Text("Uniform calls: %zu", Shader::GetNumUniformCalls());
+			}
+
+			ImGui::Separator();
+			ImGui::Text("Animators: %zu", AnimationScheduler::GetNumAnimators());
+			ImGui::Text("Poses evaluated: %zu", AnimationScheduler::GetNumEvaluated());
+			ImGui::Text("Clock only: %zu", AnimationScheduler::GetNumClockOnly());
+
+			ImGui::Separator();
+			ImGui::Text("Streaming buffer: %.2f / %.2f MB per frame", StreamingBuffer::GetBytesUsed() / (1024.0f * 1024.0f), StreamingBuffer::GetFrameBytes() / (1024.0f * 1024.0f));
+			ImGui::Text("Streaming stalls: %zu (%.2f ms)", StreamingBuffer::GetNumStalls(), StreamingBuffer::GetStallTime());
+
+			ImGui::EndTabItem();
+		}
+
 		ImGui::EndTabBar();
 
 		ImGui::End();
@@ -170,6 +442,7 @@ namespace Freeking
 		_window->Swap();
 
 		Shader::Initialize();
+		StreamingBuffer::Initialize(4 * 1024 * 1024);
 
 		ImGui::CreateContext();
 		ImGui_ImplSDL2_InitForOpenGL(static_cast<SDL_Window*>(*_window), static_cast<SDL_GLContext*>(*_window));
@@ -178,6 +451,13 @@ namespace Freeking
 
 		AudioDevice audio;
 
+		if (!_benchmark.empty())
+		{
+			Benchmark::Run(_benchmark);
+
+			return;
+		}
+
 		auto crosshair = Texture2D::Library.Get("Textures/crosshair.tga");
 
 		BillboardBatch billboards;
@@ -185,6 +465,9 @@ namespace Freeking
 
 		auto viewmodel = DynamicModel::Library.Get("models/weapons/shotgun/shotgun.mdx");
 		auto viewmodel2 = DynamicModel::Library.Get("models/weapons/shotgun/hand.mdx");
+		AssetHandle<Texture2D> viewmodelSkin(Texture2D::Library, viewmodel->Skins[0]);
+		AssetHandle<Texture2D> viewmodel2Skin(Texture2D::Library, viewmodel2->Skins[0]);
+		DynamicModelBatch viewmodelBatch;
 		FrameAnimator animator;
 		animator.SetAnimation(6);
 
@@ -193,38 +476,53 @@ namespace Freeking
 			animator.AddAnimation(frameAnimation.name, frameAnimation.firstFrame, frameAnimation.numFrames);
 		}
 
-		std::string mapName("sr1");
-
-		auto lineRenderer = std::make_shared<LineRenderer>(2000000);
-		auto spriteBatch = std::make_shared<SpriteBatch>(10000);
+		auto lineRenderer = std::make_shared<LineRenderer>();
+		auto spriteBatch = std::make_shared<SpriteBatch>();
 		SpriteBatch::Debug = spriteBatch;
 		LineRenderer::Debug = lineRenderer;
 		FreeCamera camera;
 		camera.MoveTo(Vector3f::Up * 100.0f);
 		auto font = Font::Library.Get("Fonts/Roboto-Bold.json");
-		auto map = std::make_shared<Map>(mapName);
 
+		std::shared_ptr<Map> map;
 		std::unique_ptr<Skybox> skybox;
+		std::vector<NavNode> navNodes;
+		bool mapLoading = false;
 
-		auto navData = FileSystem::GetFileData("navdata/" + mapName + ".nav");
-		auto navNodes = NavFile::ReadNodes(navData.data());
-
-		for (const auto& entDef : map->GetEntityProperties())
+		auto loadMap = [&](const std::string& mapName)
 		{
-			std::string classname = entDef.GetClassnameProperty();
+			FilePrefetcher::BeginLoad(mapName);
+
+			map = std::make_shared<Map>(mapName);
+			skybox.reset();
 
-			if (classname == "worldspawn")
+			auto navData = FileSystem::GetFileView("navdata/" + mapName + ".nav");
+			navNodes = NavFile::ReadNodes(navData.data(), navData.size());
+
+			for (const auto& entDef : map->GetEntityProperties())
 			{
-				std::string skyname;
-				if (entDef.TryGetString("sky", skyname))
+				std::string_view classname = entDef.GetClassnameProperty();
+
+				if (classname == "worldspawn")
 				{
-					skybox = std::make_unique<Skybox>(skyname);
+					std::string skyname;
+					if (entDef.TryGetString("sky"_key, skyname))
+					{
+						skybox = std::make_unique<Skybox>(skyname);
+					}
 				}
 			}
-		}
+
+			mapLoading = true;
+		};
+
+		loadMap(_startMap);
 
 		TraceResult tr;
 
+		// Milliseconds per frame spent creating GL/AL objects for assets decoded in the background.
+		const double assetUploadBudget = 2.0;
+
 		while (running)
 		{
 			Time::Update();
@@ -256,6 +554,35 @@ namespace Freeking
 				Input::HandleEvent(e);
 			}
 
+			if (!map->GetNextMapName().empty())
+			{
+				auto mapName = map->GetNextMapName();
+				std::cout << "Changing level to " << mapName << std::endl;
+
+				// The old map's assets stay in their libraries until the new map has
+				// loaded, so anything the two share is picked up again without a reload.
+				AssetLibraryBase::BeginTransition();
+				audio.StopAll();
+				billboards.Clear();
+				tr = {};
+				map.reset();
+
+				loadMap(mapName);
+			}
+
+			AssetLoadQueue::ProcessUploads(assetUploadBudget);
+
+			// The load is over once everything requested while spawning the map has been uploaded.
+			if (mapLoading && AssetLoadQueue::GetNumPendingDecodes() == 0 && AssetLoadQueue::GetNumPendingUploads() == 0)
+			{
+				FilePrefetcher::EndLoad();
+				// -recordaccess covers startup and the first map load, nothing played after it.
+				FileSystem::StopAccessLog();
+				AssetLibraryBase::EndTransition();
+				PrintResidencyReport();
+				mapLoading = false;
+			}
+
 			LockMouse(Input::IsDown(Button::MouseRight));
 
 			float mouseDeltaX = Input::GetMouseDeltaX();
@@ -305,6 +632,8 @@ namespace Freeking
 			}
 			ImGui::End();
 
+			Shader::ResetStats();
+
 			glEnable(GL_DEPTH_TEST);
 			glEnable(GL_BLEND);
 			glEnable(GL_CULL_FACE);
@@ -335,7 +664,7 @@ namespace Freeking
 
 				if (tr.hit && tr.entity)
 				{
-					tr.entity->Trigger();
+					map->TriggerEntity(tr.entity->GetHandle(), 0.0f);
 				}
 			}
 
@@ -391,32 +720,16 @@ namespace Freeking
 				Shader::GlobalUniforms.Uniforms.viewProjectionMatrix = viewmodelProjectionMatrix;
 				Shader::GlobalUniforms.Update();
 
-				shader->SetParameterValue("delta", animator.GetFrameDelta());
-				shader->SetParameterValue("modelMatrix", Matrix4x4::Translation(camera.GetViewModelOffset()) * Matrix3x3::RotationY(Math::DegreesToRadians(90)).ToMatrix4x4());
-				shader->SetParameterValue("normalBuffer", DynamicModel::GetNormalBuffer().get());
 				shader->SetParameterValue("cubemap", skybox->GetCubemap(), TextureSampler::Library.Get({ TextureWrapMode::ClampEdge, TextureFilterMode::Linear }).get());
 
-				shader->SetParameterValue("diffuse", Texture2D::Library.Get(viewmodel->Skins[0]).get());
-				shader->SetParameterValue("frameVertexBuffer", viewmodel->GetFrameVertexBuffer().get());
-				shader->SetParameterValue("frames[0].index", (int)(frame * viewmodel->GetFrameVertexCount()));
-				shader->SetParameterValue("frames[0].translate", viewmodel->FrameTransforms[frame].translate);
-				shader->SetParameterValue("frames[0].scale", viewmodel->FrameTransforms[frame].scale);
-				shader->SetParameterValue("frames[1].index", (int)(nextFrame * viewmodel->GetFrameVertexCount()));
-				shader->SetParameterValue("frames[1].translate", viewmodel->FrameTransforms[nextFrame].translate);
-				shader->SetParameterValue("frames[1].scale", viewmodel->FrameTransforms[nextFrame].scale);
+				auto viewmodelMatrix = Matrix4x4::Translation(camera.GetViewModelOffset()) * Matrix3x3::RotationY(Math::DegreesToRadians(90)).ToMatrix4x4();
 
-				viewmodel->Draw();
+				if (viewmodelSkin) viewmodelSkin->RequestLevel(0);
+				if (viewmodel2Skin) viewmodel2Skin->RequestLevel(0);
 
-				shader->SetParameterValue("diffuse", Texture2D::Library.Get(viewmodel2->Skins[0]).get());
-				shader->SetParameterValue("frameVertexBuffer", viewmodel2->GetFrameVertexBuffer().get());
-				shader->SetParameterValue("frames[0].index", (int)(frame * viewmodel2->GetFrameVertexCount()));
-				shader->SetParameterValue("frames[0].translate", viewmodel2->FrameTransforms[frame].translate);
-				shader->SetParameterValue("frames[0].scale", viewmodel2->FrameTransforms[frame].scale);
-				shader->SetParameterValue("frames[1].index", (int)(nextFrame * viewmodel2->GetFrameVertexCount()));
-				shader->SetParameterValue("frames[1].translate", viewmodel2->FrameTransforms[nextFrame].translate);
-				shader->SetParameterValue("frames[1].scale", viewmodel2->FrameTransforms[nextFrame].scale);
-
-				viewmodel2->Draw();
+				viewmodelBatch.Add(viewmodel.get(), viewmodelSkin.Get(), viewmodelMatrix, frame, nextFrame, animator.GetFrameDelta());
+				viewmodelBatch.Add(viewmodel2.get(), viewmodel2Skin.Get(), viewmodelMatrix, frame, nextFrame, animator.GetFrameDelta());
+				viewmodelBatch.Flush(shader.get());
 
 				Shader::GlobalUniforms.Uniforms.projectionMatrix = viewProjectionMatrix;
 				Shader::GlobalUniforms.Uniforms.viewProjectionMatrix = viewProjectionMatrix;
@@ -449,7 +762,7 @@ namespace Freeking
 						screenPosition = Util::ScreenSpaceToPixelPosition(screenPosition, Vector4i(0, 0, _viewportWidth, _viewportHeight));
 						screenPosition.x = Math::Round(screenPosition.x);
 						screenPosition.y = Math::Round(screenPosition.y);
-						auto text = *entDef.GetClassnameProperty() + " (" + *entDef.GetNameProperty() + ")";
+						auto text = std::string(*entDef.GetClassnameProperty()) + " (" + std::string(*entDef.GetNameProperty()) + ")";
 						spriteBatch->DrawText(font.get(), text, screenPosition + Vector2f(2, 2), LinearColor(0, 0, 0, alpha), 0.5f);
 						spriteBatch->DrawText(font.get(), text, screenPosition, LinearColor(1, 1, 1, alpha), 0.5f);
 					}
@@ -516,6 +829,14 @@ namespace Freeking
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
 			_window->Swap();
+
+			StreamingBuffer::EndFrame();
+			CastModel::Update();
+			TextureStreamer::Update();
+			AssetLibraryBase::EndFrame();
 		}
+
+		FilePrefetcher::EndLoad();
+		AssetLoadQueue::Stop();
 	}
 }
@@ -26,5 +26,8 @@ namespace Freeking
 		int _viewportHeight;
 
 		bool _mouseLocked;
+
+		std::string _benchmark;
+		std::string _startMap;
 	};
 }
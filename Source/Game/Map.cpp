@@ -1,15 +1,19 @@
 #include "Map.h"
 #include "Lightmap.h"
 #include "Texture2D.h"
+#include "TextureStreamer.h"
 #include "Shader.h"
 #include "BspFlags.h"
 #include "DynamicModel.h"
+#include "AnimationScheduler.h"
 #include "Paths.h"
 #include "Profiler.h"
 #include "LineRenderer.h"
 #include "Util.h"
+#include "Renderer.h"
 #include "ThirdParty/rectpack2d/finders_interface.h"
 #include <array>
+#include <cstring>
 
 namespace Freeking
 {
@@ -27,6 +31,14 @@ namespace Freeking
 			return;
 		}
 
+		BoundsMin = BoundsMax = Vertices.front().Position;
+
+		for (const auto& vertex : Vertices)
+		{
+			BoundsMin = Vector3f(Math::Min(BoundsMin.x, vertex.Position.x), Math::Min(BoundsMin.y, vertex.Position.y), Math::Min(BoundsMin.z, vertex.Position.z));
+			BoundsMax = Vector3f(Math::Max(BoundsMax.x, vertex.Position.x), Math::Max(BoundsMax.y, vertex.Position.y), Math::Max(BoundsMax.z, vertex.Position.z));
+		}
+
 		static const int vertexSize = sizeof(Vertex);
 		_vertexBuffer = std::make_unique<VertexBuffer>(Vertices.data(), Vertices.size(), vertexSize, GL_STATIC_DRAW);
 		_indexBuffer = std::make_unique<IndexBuffer>(Indices.data(), Indices.size(), GL_UNSIGNED_INT);
@@ -192,51 +204,44 @@ namespace Freeking
 		std::vector<LightStyle> _styles;
 	};
 
-	void BrushModel::RenderOpaque(Shader* shader)
+	void BrushModel::Render(RenderQueue& queue, Shader* shader, const Matrix4x4& transform, bool forceTranslucent)
 	{
 		if (!shader)
 		{
 			return;
 		}
 
+		auto viewPosition = Renderer::ViewMatrix.InverseTranslation();
+
 		for (const auto& mesh : Meshes)
 		{
-			if (mesh.second->Translucent)
+			auto binding = mesh.second->GetBinding();
+			if (!binding)
 			{
 				continue;
 			}
 
-			float brightness = Map::LightStyles.GetSample(mesh.second->LightStyles[1]);
-			shader->SetParameterValue("brightness", brightness * 2.0f);
-			shader->SetParameterValue("alphaCutOff", mesh.second->AlphaCutOff);
-			shader->SetParameterValue("diffuse", mesh.second->GetDiffuse().get());
-			shader->SetParameterValue("lightmap", mesh.second->GetLightmap().get());
+			const auto& diffuse = mesh.second->GetDiffuse();
+			const auto& lightmap = mesh.second->GetLightmap();
+			bool translucent = mesh.second->Translucent || forceTranslucent;
 
-			mesh.second->Draw();
-		}
-	}
+			RenderQueue::Packet packet;
+			packet.shader = shader;
+			packet.binding = binding;
+			packet.diffuse = diffuse.get();
+			packet.lightmap = lightmap.get();
+			packet.modelMatrix = &transform;
+			packet.brightness = Map::LightStyles.GetSample(mesh.second->LightStyles[1]) * 2.0f;
+			packet.alphaCutOff = translucent ? 0.0f : mesh.second->AlphaCutOff;
+			packet.alphaMultiply = translucent ? mesh.second->AlphaMultiply : 1.0f;
 
-	void BrushModel::RenderTranslucent(Shader* shader, bool forceTranslucent)
-	{
-		if (!shader)
-		{
-			return;
-		}
-
-		for (auto& mesh : Meshes)
-		{
-			if (!mesh.second->Translucent && !forceTranslucent)
-			{
-				continue;
-			}
+			TextureStreamer::RequestForBounds(diffuse.get(), mesh.second->BoundsMin, mesh.second->BoundsMax, mesh.second->TexelDensity);
 
-			float brightness = Map::LightStyles.GetSample(mesh.second->LightStyles[1]);
-			shader->SetParameterValue("brightness", brightness * 2.0f);
-			shader->SetParameterValue("alphaMultiply", mesh.second->AlphaMultiply);
-			shader->SetParameterValue("diffuse", mesh.second->GetDiffuse().get());
-			shader->SetParameterValue("lightmap", mesh.second->GetLightmap().get());
+			auto center = transform.TransformPoint((mesh.second->BoundsMin + mesh.second->BoundsMax) * 0.5f);
+			auto pass = translucent ? RenderQueue::Pass::Translucent : RenderQueue::Pass::Opaque;
+			auto key = RenderQueue::MakeKey(pass, shader, diffuse ? diffuse->GetId() : 0, binding->GetHandle(), center.LengthBetween(viewPosition));
 
-			mesh.second->Draw();
+			queue.Add(key, packet);
 		}
 	}
 
@@ -245,40 +250,47 @@ namespace Freeking
 		Time += dt;
 		LightStyles.Update(Time);
 
-		for (const auto& entity : _entities)
+		const auto& entities = _entities.GetEntities();
+
+		for (size_t i = 0; i < entities.size(); ++i)
 		{
-			entity->Tick(dt);
-			entity->PostTick();
+			entities[i]->Tick(dt);
+			entities[i]->PostTick();
 		}
+
+		AnimationScheduler::Update(dt);
+
+		_triggerQueue.Dispatch(_entities, Time);
+
+		FlushDespawnedEntities();
 	}
 
 	void Map::Render()
 	{
 		glDisable(GL_BLEND);
 
-		for (const auto& entity : _worldEntities)
+		for (auto entity : _entities.GetPrimitives())
 		{
 			if (entity->IsHidden())
 			{
 				continue;
 			}
 
-			entity->PreRender(false);
-			entity->RenderOpaque();
+			entity->Render(_renderQueue);
 		}
 
-		glEnable(GL_BLEND);
-
-		for (const auto& entity : _worldEntities)
+		// The model batches draw in one go with their own state, sorted in with the other
+		// opaque draws by their shader.
+		auto modelShader = Shader::Library.DynamicModel.get();
+		_renderQueue.Add(RenderQueue::MakeKey(RenderQueue::Pass::Opaque, modelShader, 0, 0, 0.0f), [this, modelShader]()
 		{
-			if (entity->IsHidden())
-			{
-				continue;
-			}
+			_dynamicModelBatch.Flush(modelShader);
+			_staticModelBatch.Draw(modelShader);
+		});
 
-			entity->PreRender(true);
-			entity->RenderTranslucent();
-		}
+		_renderQueue.Submit();
+
+		glEnable(GL_BLEND);
 	}
 
 	Map* Map::Current = nullptr;
@@ -290,6 +302,38 @@ namespace Freeking
 		return LightStyles.GetSample(index);
 	}
 
+	static bool IsValidFace(
+		const BspFace& face,
+		const LumpArray<BspTextureInfo>& textureInfo,
+		const LumpArray<BspPlane>& planes,
+		const LumpArray<int32_t>& faceEdges,
+		const LumpArray<BspEdge>& edges,
+		const LumpArray<Vector3f>& vertices)
+	{
+		if (!textureInfo.IsValidIndex(face.TextureInfo) || !planes.IsValidIndex(face.Plane) || face.NumEdges < 3)
+		{
+			return false;
+		}
+
+		if ((size_t)face.FirstEdge + face.NumEdges > (size_t)faceEdges.Num())
+		{
+			return false;
+		}
+
+		for (int edgeIndex = 0; edgeIndex < face.NumEdges; ++edgeIndex)
+		{
+			auto faceEdge = faceEdges[face.FirstEdge + edgeIndex];
+			auto edge = (faceEdge < 0) ? -(int64_t)faceEdge : faceEdge;
+
+			if (edge >= edges.Num() || !vertices.IsValidIndex(faceEdge < 0 ? edges[(int)edge].A : edges[(int)edge].B))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	Map::Map(const std::string& mapName)
 	{
 		Map::Current = this;
@@ -300,9 +344,17 @@ namespace Freeking
 		}
 
 		Profiler pf;
+		auto numSyscalls = FileSystem::GetNumSyscalls();
 
-		_fileData = std::move(FileSystem::GetFileData("maps/" + mapName + ".bsp"));
-		const BspFile& bspFile = BspFile::Create(_fileData.data());
+		_fileData = FileSystem::GetFileView("maps/" + mapName + ".bsp");
+		auto bspFilePtr = BspFile::Create(_fileData.data(), _fileData.size());
+		if (!bspFilePtr)
+		{
+			std::cout << "Invalid map " << mapName << std::endl;
+			return;
+		}
+
+		const BspFile& bspFile = *bspFilePtr;
 
 		auto entities = bspFile.GetLumpArray<char>(bspFile.Header.Entities);
 		auto vertices = bspFile.GetLumpArray<Vector3f>(bspFile.Header.Vertices);
@@ -322,8 +374,7 @@ namespace Freeking
 
 		pf.Start();
 
-		std::string entityString(entities.Data(), entities.Num());
-		if (!EntityLump::Parse(entityString, _entityKeyValues))
+		if (!_entityLump.Parse(std::string_view(entities.Data(), entities.Num())))
 		{
 			std::cout << "Error parsing entity lump" << std::endl;
 		}
@@ -337,7 +388,7 @@ namespace Freeking
 		for (int i = 0; i < _textureInfo.Num(); ++i)
 		{
 			const auto& texInfo = _textureInfo[i];
-			auto textureName = std::string(texInfo.TextureName);
+			auto textureName = std::string(texInfo.TextureName, strnlen(texInfo.TextureName, sizeof(texInfo.TextureName)));
 
 			if (textureIds.find(textureName) == textureIds.end())
 			{
@@ -369,6 +420,11 @@ namespace Freeking
 
 			for (int faceIndex = model.FirstFace; faceIndex < (model.FirstFace + model.NumFaces); ++faceIndex)
 			{
+				if (!faces.IsValidIndex(faceIndex) || !IsValidFace(faces[faceIndex], _textureInfo, planes, faceEdges, edges, vertices))
+				{
+					continue;
+				}
+
 				const auto& face = faces[faceIndex];
 				const auto& faceTextureInfo = _textureInfo[face.TextureInfo];
 
@@ -384,7 +440,7 @@ namespace Freeking
 					continue;
 				}
 
-				std::string textureName(faceTextureInfo.TextureName);
+				std::string textureName(faceTextureInfo.TextureName, strnlen(faceTextureInfo.TextureName, sizeof(faceTextureInfo.TextureName)));
 				auto masked = (faceTextureInfo.Flags[BspSurfaceFlags::Masked]);
 				auto trans = (faceTextureInfo.Flags[BspSurfaceFlags::Trans33]) || (faceTextureInfo.Flags[BspSurfaceFlags::Trans66]);
 				auto textureId = textureIds[textureName];
@@ -412,6 +468,8 @@ namespace Freeking
 					mesh->Translucent = trans;
 				}
 
+				mesh->TexelDensity = Math::Max(mesh->TexelDensity, Math::Max(faceTextureInfo.AxisU.Length(), faceTextureInfo.AxisV.Length()));
+
 				auto textureWidth = texture->GetWidth();
 				auto textureHeight = texture->GetHeight();
 
@@ -475,6 +533,11 @@ namespace Freeking
 						if (packingNode.has_value())
 						{
 							auto lightmapOffset = face.LightmapOffset + (((lwidth * lheight) * 3) * lightStyleIndex);
+							if (lightmapOffset + (lwidth * lheight * 3) > lightmapData.Num())
+							{
+								continue;
+							}
+
 							lightmapImage->Insert(packingNode->x, packingNode->y, lwidth, lheight, lightmapData.Data() + lightmapOffset);
 
 							auto uvIndex = lightStyleIndex + 1;
@@ -549,50 +612,128 @@ namespace Freeking
 
 		pf.Start();
 
-		for (const auto& entityProperties : _entityKeyValues)
+		const auto& entityProperties = _entityLump.GetEntities();
+
+		// Room for the entities spawned at runtime as well, so spawning them does not grow the lists.
+		size_t maxEntities = entityProperties.size() + MaxRuntimeEntities;
+
+		_entities.Reserve(maxEntities);
+		_despawnedEntities.reserve(maxEntities);
+		_triggerQueue.Reserve(maxEntities);
+
+		for (const auto& properties : entityProperties)
+		{
+			SpawnEntity(properties);
+		}
+
+		pf.Stop("Create entities");
+
+		std::cout << (FileSystem::GetNumSyscalls() - numSyscalls) << " file system syscalls" << std::endl;
+	}
+
+	Map::~Map()
+	{
+		_entities.Clear();
+
+		if (Map::Current == this)
+		{
+			Map::Current = nullptr;
+		}
+	}
+
+	EntityHandle Map::SpawnEntity(const EntityProperties& properties)
+	{
+		Name classname(*properties.GetClassnameProperty());
+		if (classname.IsEmpty())
+		{
+			return {};
+		}
+
+		auto entity = BaseEntity::Make(classname);
+		if (!entity)
+		{
+			std::cout << "Could not make entity \"" << classname.ToStringView() << "\"" << std::endl;
+			return {};
+		}
+
+		entity->InitializeProperties(properties);
+
+		return AddEntity(entity);
+	}
+
+	EntityHandle Map::AddEntity(BaseEntity* entity)
+	{
+		auto handle = _entities.Add(entity);
+
+		if (!entity->GetTargetname().IsEmpty() || !entity->GetTarget().IsEmpty())
+		{
+			_targetGraph.MarkDirty();
+		}
+
+		entity->Initialize();
+		entity->PostInitialize();
+		entity->Spawn();
+
+		return handle;
+	}
+
+	void Map::DespawnEntity(const EntityHandle& handle)
+	{
+		if (_entities.Get(handle))
 		{
-			std::string classname = entityProperties.GetClassnameProperty();
-			if (classname.empty())
+			_despawnedEntities.push_back(handle);
+		}
+	}
+
+	void Map::FlushDespawnedEntities()
+	{
+		for (const auto& handle : _despawnedEntities)
+		{
+			auto entity = _entities.Remove(handle);
+			if (!entity)
 			{
 				continue;
 			}
 
-			if (auto newEntity = BaseEntity::Make(classname))
+			if (!entity->GetTargetname().IsEmpty() || !entity->GetTarget().IsEmpty())
 			{
-				if (const auto& targetname = entityProperties.GetTargetnameProperty())
-				{
-					_targetEntities[targetname].push_back(newEntity);
-				}
+				_targetGraph.MarkDirty();
+			}
 
-				newEntity->InitializeProperties(entityProperties);
-				newEntity->Initialize();
-				newEntity->PostInitialize();
-				newEntity->Spawn();
+			entity->Release();
+		}
 
-				_entities.push_back(newEntity);
+		_despawnedEntities.clear();
+	}
 
-				if (auto worldEntity = std::dynamic_pointer_cast<PrimitiveEntity>(newEntity))
-				{
-					_worldEntities.push_back(worldEntity);
-				}
-			}
-			else
-			{
-				std::cout << "Could not make entity \"" << classname << "\"" << std::endl;
-			}
+	void Map::UpdateTargetGraph()
+	{
+		if (_targetGraph.IsDirty())
+		{
+			_targetGraph.Build(_entities);
 		}
+	}
 
-		pf.Stop("Create entities");
+	TargetGraph::Targets Map::GetTargetEntities(const Name& targetName)
+	{
+		UpdateTargetGraph();
+
+		return _targetGraph.GetTargets(targetName);
 	}
 
-	std::vector<std::shared_ptr<BaseEntity>> Map::GetTargetEntities(const std::string& targetName)
+	void Map::TriggerTargets(const EntityHandle& source, float delay)
 	{
-		if (auto it = _targetEntities.find(targetName); it != _targetEntities.end())
+		UpdateTargetGraph();
+
+		for (const auto& target : _targetGraph.GetTargets(source))
 		{
-			return it->second;
+			_triggerQueue.Enqueue(target, Time, delay);
 		}
+	}
 
-		return {};
+	void Map::TriggerEntity(const EntityHandle& target, float delay)
+	{
+		_triggerQueue.Enqueue(target, Time, delay);
 	}
 
 	void Map::RecursiveHullCheck(int num, float p1f, float p2f, const Vector3f& mins, const Vector3f& maxs, const Vector3f& p1, const Vector3f& p2, TraceResult& trace, bool isPoint, const Vector3f& extents, const BspContentFlags& contents)
@@ -901,7 +1042,7 @@ namespace Freeking
 
 	void Map::ClipBoxToEntities(const Vector3f& start, const Vector3f& end, const Vector3f& mins, const Vector3f& maxs, TraceResult& tr, const BspContentFlags& brushMask)
 	{
-		for (const auto& entity : _worldEntities)
+		for (auto entity : _entities.GetPrimitives())
 		{
 			if (tr.allSolid)
 			{
@@ -921,7 +1062,7 @@ namespace Freeking
 				continue;
 			}
 
-			trace.entity = entity.get();
+			trace.entity = entity;
 
 			if (trace.allSolid || trace.startSolid || trace.fraction < tr.fraction)
 			{
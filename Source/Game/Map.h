@@ -2,11 +2,18 @@
 
 #include "BspFile.h"
 #include "DynamicModel.h"
+#include "DynamicModelBatch.h"
+#include "StaticModelBatch.h"
+#include "RenderQueue.h"
 #include "EntityLump.h"
+#include "FileView.h"
 #include "TextureSampler.h"
 #include "Vector.h"
 #include "Quaternion.h"
 #include "PrimitiveEntity.h"
+#include "EntityList.h"
+#include "TargetGraph.h"
+#include "TriggerQueue.h"
 #include <string>
 #include <memory>
 #include <charconv>
@@ -37,6 +44,7 @@ namespace Freeking
 			AlphaCutOff(0.0f),
 			AlphaMultiply(0.0f),
 			Translucent(false),
+			TexelDensity(0.0f),
 			LightStyles({ {255, 255, 255, 255} })
 		{
 		}
@@ -52,6 +60,7 @@ namespace Freeking
 
 		inline size_t GetNumVertices() const { return Vertices.size(); }
 		inline size_t GetNumIndices() const { return Indices.size(); }
+		inline VertexBinding* GetBinding() const { return _vertexBinding.get(); }
 
 		std::vector<Vertex> Vertices;
 		std::vector<uint32_t> Indices;
@@ -60,6 +69,12 @@ namespace Freeking
 		float AlphaMultiply;
 		bool Translucent;
 
+		// Bounds are filled in by Commit. Texel density is the most texels per world unit
+		// of any face in the mesh, used to pick the mip level to stream.
+		Vector3f BoundsMin;
+		Vector3f BoundsMax;
+		float TexelDensity;
+
 		std::array<uint8_t, 4> LightStyles;
 
 	private:
@@ -75,8 +90,9 @@ namespace Freeking
 	{
 	public:
 
-		void RenderOpaque(Shader* shader);
-		void RenderTranslucent(Shader* shader, bool forceTranslucent);
+		// Adds a packet per mesh. Translucent meshes, or every mesh if forceTranslucent is
+		// set, go in the translucent pass.
+		void Render(RenderQueue& queue, Shader* shader, const Matrix4x4& transform, bool forceTranslucent);
 
 		struct MeshKey
 		{
@@ -108,6 +124,7 @@ namespace Freeking
 	public:
 
 		Map(const std::string& mapName);
+		~Map();
 
 		void Tick(double dt);
 		void Render();
@@ -125,7 +142,7 @@ namespace Freeking
 			const Vector3f& origin,
 			const Quaternion& angles);
 
-		const std::vector<EntityProperties>& GetEntityProperties() { return _entityKeyValues; }
+		const std::vector<EntityProperties>& GetEntityProperties() const { return _entityLump.GetEntities(); }
 		const std::shared_ptr<BrushModel>& GetBrushModel(uint32_t index) const { return _models.at(index); }
 
 		static Map* Current;
@@ -136,7 +153,31 @@ namespace Freeking
 
 		int GetModelHeadNode(int modelIndex) { return _brushModels[modelIndex].RootNode; };
 
-		std::vector<std::shared_ptr<BaseEntity>> GetTargetEntities(const std::string& targetName);
+		TargetGraph::Targets GetTargetEntities(const Name& targetName);
+
+		void TriggerTargets(const EntityHandle& source, float delay);
+		void TriggerEntity(const EntityHandle& target, float delay);
+
+		inline BaseEntity* GetEntity(const EntityHandle& handle) const { return _entities.Get(handle); }
+		inline DynamicModelBatch& GetDynamicModelBatch() { return _dynamicModelBatch; }
+		inline StaticModelBatch& GetStaticModelBatch() { return _staticModelBatch; }
+		inline const RenderQueue& GetRenderQueue() const { return _renderQueue; }
+
+		EntityHandle SpawnEntity(const EntityProperties& properties);
+		void DespawnEntity(const EntityHandle& handle);
+
+		template <typename T, typename SetupFunction>
+		EntityHandle SpawnEntity(SetupFunction&& setup)
+		{
+			T* entity = EntityPool<T>::Allocate();
+			setup(*entity);
+
+			return AddEntity(entity);
+		}
+
+		// Set by target_changelevel. The game switches maps at the start of the next frame.
+		inline void ChangeLevel(const std::string& mapName) { _nextMapName = mapName; }
+		inline const std::string& GetNextMapName() const { return _nextMapName; }
 
 		bool SlideMove(float time, Vector3f& origin, Vector3f& velocity, const Vector3f& mins, const Vector3f& maxs, const BspContentFlags& mask, bool gravity, bool grounded, const Vector3f& groundPlane);
 
@@ -149,15 +190,26 @@ namespace Freeking
 		void ClipBoxToBrush(const Vector3f& start, const Vector3f& end, const Vector3f& mins, const Vector3f& maxs, TraceResult& trace, const BspBrush& brush, bool isPoint);
 		void ClipBoxToEntities(const Vector3f& start, const Vector3f& end, const Vector3f& mins, const Vector3f& maxs, TraceResult& tr, const BspContentFlags& brushMask);
 
+		EntityHandle AddEntity(BaseEntity* entity);
+		void FlushDespawnedEntities();
+		void UpdateTargetGraph();
+
+		static constexpr size_t MaxRuntimeEntities = 256;
+
 		std::vector<std::shared_ptr<BrushModel>> _models;
 		std::shared_ptr<Texture2D> _lightmapTexture;
 		std::vector<std::shared_ptr<Texture2D>> _textures;
-		std::vector<std::shared_ptr<BaseEntity>> _entities;
-		std::vector<std::shared_ptr<PrimitiveEntity>> _worldEntities;
-		std::unordered_map<std::string, std::vector<std::shared_ptr<BaseEntity>>> _targetEntities;
-		std::vector<EntityProperties> _entityKeyValues;
-
-		std::vector<uint8_t> _fileData;
+		EntityList _entities;
+		std::vector<EntityHandle> _despawnedEntities;
+		TargetGraph _targetGraph;
+		TriggerQueue _triggerQueue;
+		EntityLump _entityLump;
+		DynamicModelBatch _dynamicModelBatch;
+		StaticModelBatch _staticModelBatch;
+		RenderQueue _renderQueue;
+		std::string _nextMapName;
+
+		FileView _fileData;
 		LumpArray<BspBrush> _brushes;
 		LumpArray<BspBrushSide> _brushSides;
 		LumpArray<BspPlane> _planes;
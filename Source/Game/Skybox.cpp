@@ -24,8 +24,8 @@ namespace Freeking
 				const auto& side = sides[i];
 				auto filename = "env/" + name + side;
 
-				auto buffer = FileSystem::GetFileData(filename + ".tga");
-				if (buffer.empty()) buffer = FileSystem::GetFileData(filename + ".TGA");
+				auto buffer = FileSystem::GetFileView(filename + ".tga");
+				if (buffer.empty()) buffer = FileSystem::GetFileView(filename + ".TGA");
 				if (!buffer.empty())
 				{
 					int imageWidth, imageHeight, imageChannels;
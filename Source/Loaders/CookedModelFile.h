@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Freeking
+{
+	struct CookedModelHeader
+	{
+		uint32_t Ident;
+		uint32_t Version;
+		uint32_t NumVertices;
+		uint32_t NumIndices;
+		uint32_t NumFrames;
+		uint32_t NumFrameVertices;
+		uint32_t NumSkins;
+		uint32_t NumSubObjects;
+		uint32_t NumBoundsSubObjects;
+		uint32_t NumLods;
+		uint32_t NumAnimations;
+	};
+
+	struct CookedModelVertex
+	{
+		float U;
+		float V;
+		int32_t VertexIndex;
+	};
+
+	struct CookedModelFrame
+	{
+		std::array<char, 16> Name;
+		float Translate[3];
+		float Scale[3];
+	};
+
+	struct CookedModelBounds
+	{
+		float Min[3];
+		float Max[3];
+	};
+
+	struct CookedModelAnimation
+	{
+		std::array<char, 16> Name;
+		uint32_t FirstFrame;
+		uint32_t NumFrames;
+	};
+
+	// A decoded MD2 or MDX model stored next to its source as "<source>.fkmdl", with its
+	// LODs and animation ranges already built. The header is followed, in order, by the
+	// vertices, indices, frames, frame vertices (NumFrames * NumFrameVertices), skin paths,
+	// sub-objects, frame bounds (NumBoundsSubObjects * NumFrames), LODs and animations.
+	// Every record is a multiple of four bytes, so every section stays aligned.
+	struct CookedModelFile
+	{
+		static constexpr uint32_t Ident = 0x444D4B46; // "FKMD"
+		static constexpr uint32_t Version = 1;
+		static constexpr size_t SkinPathLength = 64;
+		static constexpr const char* Extension = ".fkmdl";
+	};
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Freeking
+{
+	enum class CookedTextureFormat : uint32_t
+	{
+		RGBA8 = 0,
+		RGB8 = 1,
+		BC1 = 2,
+		BC3 = 3,
+		RGB565 = 4,
+		RGBA4 = 5
+	};
+
+	struct CookedTextureLevel
+	{
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t Offset;
+		uint32_t Size;
+	};
+
+	struct CookedTextureHeader
+	{
+		uint32_t Ident;
+		uint32_t Version;
+		uint32_t Width;
+		uint32_t Height;
+		CookedTextureFormat Format;
+		uint32_t NumLevels;
+	};
+
+	// Pre-decoded texture stored next to its source as "<source>.fktex". The header is
+	// followed by NumLevels level descriptors, largest first, then the level data.
+	struct CookedTextureFile
+	{
+		static const CookedTextureFile* Create(const uint8_t* data, size_t size)
+		{
+			if (size < sizeof(CookedTextureHeader))
+			{
+				return nullptr;
+			}
+
+			const auto& file = (const CookedTextureFile&)*data;
+			const auto& header = file.Header;
+
+			if (header.Ident != Ident || header.Version != Version || header.NumLevels == 0 || header.NumLevels > MaxLevels)
+			{
+				return nullptr;
+			}
+
+			if (header.Format > CookedTextureFormat::RGBA4)
+			{
+				return nullptr;
+			}
+
+			if (sizeof(CookedTextureHeader) + header.NumLevels * sizeof(CookedTextureLevel) > size)
+			{
+				return nullptr;
+			}
+
+			for (uint32_t i = 0; i < header.NumLevels; ++i)
+			{
+				const auto& level = file.GetLevel(i);
+				if ((size_t)level.Offset + level.Size > size ||
+					GetLevelSize(header.Format, level.Width, level.Height) > level.Size)
+				{
+					return nullptr;
+				}
+			}
+
+			return &file;
+		}
+
+		static inline bool IsBlockCompressed(CookedTextureFormat format)
+		{
+			return format == CookedTextureFormat::BC1 || format == CookedTextureFormat::BC3;
+		}
+
+		// Block compressed levels are stored as whole 4x4 blocks.
+		static inline uint64_t GetLevelSize(CookedTextureFormat format, uint32_t width, uint32_t height)
+		{
+			switch (format)
+			{
+			case CookedTextureFormat::RGBA8: return (uint64_t)width * height * 4;
+			case CookedTextureFormat::RGB8: return (uint64_t)width * height * 3;
+			case CookedTextureFormat::BC1: return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * 8;
+			case CookedTextureFormat::BC3: return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * 16;
+			case CookedTextureFormat::RGB565: return (uint64_t)width * height * 2;
+			case CookedTextureFormat::RGBA4: return (uint64_t)width * height * 2;
+			}
+
+			return 0;
+		}
+
+		inline const CookedTextureLevel& GetLevel(uint32_t index) const
+		{
+			return reinterpret_cast<const CookedTextureLevel*>(this + 1)[index];
+		}
+
+		inline const uint8_t* GetLevelData(uint32_t index) const
+		{
+			return reinterpret_cast<const uint8_t*>(this) + GetLevel(index).Offset;
+		}
+
+		static constexpr uint32_t Ident = 0x58544B46; // "FKTX"
+		static constexpr uint32_t Version = 2;
+		static constexpr uint32_t MaxLevels = 16;
+		static constexpr const char* Extension = ".fktex";
+
+		CookedTextureHeader Header;
+	};
+}
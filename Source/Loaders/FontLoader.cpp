@@ -21,14 +21,14 @@ namespace Freeking
 		Profiler pf;
 		pf.Start();
 
-		auto buffer = FileSystem::GetFileData(name);
+		auto buffer = FileSystem::GetFileView(name);
 		if (buffer.empty())
 		{
 			return nullptr;
 		}
 
-		auto j = json::parse(buffer);
-		if (!j.is_object())
+		auto j = json::parse(buffer.begin(), buffer.end(), nullptr, false);
+		if (j.is_discarded() || !j.is_object())
 		{
 			return nullptr;
 		}
@@ -12,7 +12,7 @@ namespace Freeking
 
 	ShaderLoader::AssetPtr ShaderLoader::Load(const std::string& name) const
 	{
-		auto source = FileSystem::GetFileData(name);
+		auto source = FileSystem::GetFileView(name);
 
 		if (source.empty())
 		{
@@ -1,9 +1,28 @@
 #include "TextureLoader.h"
 #include "Texture2D.h"
+#include "CookedTextureFile.h"
+#include "TextureStreamer.h"
 #include "stb_image.h"
 
 namespace Freeking
 {
+	struct TextureLoadData : public AssetLoadData
+	{
+		~TextureLoadData()
+		{
+			stbi_image_free(image);
+		}
+
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		uint8_t* image = nullptr;
+
+		std::string name;
+		FileView cookedView;
+		const CookedTextureFile* cookedFile = nullptr;
+	};
+
 	bool TextureLoader::CanLoadExtension(const std::string& extension) const
 	{
 		if (extension == ".png") return true;
@@ -16,27 +35,59 @@ namespace Freeking
 		return false;
 	};
 
-	TextureLoader::AssetPtr TextureLoader::Load(const std::string& name) const
+	std::unique_ptr<AssetLoadData> TextureLoader::Decode(const std::string& name) const
 	{
-		if (auto buffer = FileSystem::GetFileData(name); !buffer.empty())
+		// A cooked archive may carry a pre-decoded copy of the texture next to the source.
+		if (auto cooked = FileSystem::GetFileView(name + CookedTextureFile::Extension); !cooked.empty())
 		{
-			int imageWidth, imageHeight, imageChannels;
-			if (uint8_t* image = stbi_load_from_memory(
-				(uint8_t*)buffer.data(), (std::int32_t)buffer.size(),
-				&imageWidth, &imageHeight, &imageChannels, 0))
+			auto cookedFile = CookedTextureFile::Create(cooked.data(), cooked.size());
+
+			// Fall back to the source image on drivers without S3TC.
+			if (cookedFile && CookedTextureFile::IsBlockCompressed(cookedFile->Header.Format) && !GLAD_GL_EXT_texture_compression_s3tc)
 			{
-				auto texture = std::make_shared<Texture2D>(
-					imageWidth, imageHeight,
-					GL_RGBA8, imageChannels == 3 ? GL_RGB : GL_RGBA,
-					GL_UNSIGNED_BYTE,
-					image);
+				cookedFile = nullptr;
+			}
 
-				stbi_image_free(image);
+			if (cookedFile)
+			{
+				auto data = std::make_unique<TextureLoadData>();
+				data->name = name;
+				data->cookedView = std::move(cooked);
+				data->cookedFile = cookedFile;
 
-				return texture;
+				return data;
+			}
+		}
+
+		if (auto buffer = FileSystem::GetFileView(name); !buffer.empty())
+		{
+			auto data = std::make_unique<TextureLoadData>();
+			data->image = stbi_load_from_memory(
+				(uint8_t*)buffer.data(), (std::int32_t)buffer.size(),
+				&data->width, &data->height, &data->channels, 0);
+
+			if (data->image)
+			{
+				return data;
 			}
 		}
 
 		return nullptr;
 	}
+
+	TextureLoader::AssetPtr TextureLoader::Upload(AssetLoadData& data) const
+	{
+		auto& textureData = static_cast<TextureLoadData&>(data);
+
+		if (const auto cookedFile = textureData.cookedFile)
+		{
+			return TextureStreamer::CreateTexture(textureData.name, std::move(textureData.cookedView), *cookedFile);
+		}
+
+		return std::make_shared<Texture2D>(
+			textureData.width, textureData.height,
+			textureData.channels == 3 ? GL_RGB8 : GL_RGBA8, textureData.channels == 3 ? GL_RGB : GL_RGBA,
+			GL_UNSIGNED_BYTE,
+			textureData.image);
+	}
 }
@@ -1,10 +1,21 @@
 #include "WavLoader.h"
-#include "MemoryStream.h"
+#include "BinaryReader.h"
+#include <algorithm>
 
 namespace Freeking
 {
 	AudioClipLibrary AudioClip::Library;
 
+	struct WavLoadData : public AssetLoadData
+	{
+		uint32_t channelCount;
+		uint32_t bitsPerSample;
+		uint32_t samplesPerSecond;
+		FileView fileData;
+		const uint8_t* pcmData;
+		size_t pcmSize;
+	};
+
 	struct RiffFormatChunk
 	{
 		uint16_t wFormatTag;
@@ -23,52 +34,69 @@ namespace Freeking
 		return false;
 	};
 
-	WavLoader::AssetPtr WavLoader::Load(const std::string& name) const
+	std::unique_ptr<AssetLoadData> WavLoader::Decode(const std::string& name) const
 	{
-		auto fileData = FileSystem::GetFileData(name);
+		auto fileData = FileSystem::GetFileView(name);
 
 		if (fileData.empty())
 		{
 			return nullptr;
 		}
 
-		MemoryStream stream(fileData);
-
-		static const char* RiffTag = "RIFF";
-		static const char* WavTag = "WAVE";
-		static const char* FormatTag = "fmt ";
+		BinaryReader reader(fileData);
 
-		char ident[4];
+		static const uint32_t RiffTag = 'FFIR';
+		static const uint32_t WavTag = 'EVAW';
+		static const uint32_t FormatTag = ' tmf';
+		static const uint32_t DataTag = 'atad';
 
-		stream.Read((uint8_t*)&ident[0], 4);
-		if (strncmp(ident, RiffTag, 4) != 0)
+		if (reader.Read<uint32_t>() != RiffTag)
 		{
 			return nullptr;
 		}
 
-		auto fileSize = stream.Read<uint32_t>();
+		reader.Skip(4);
 
-		stream.Read((uint8_t*)&ident[0], 4);
-		if (strncmp(ident, WavTag, 4) != 0)
+		if (reader.Read<uint32_t>() != WavTag)
 		{
 			return nullptr;
 		}
 
-		do
+		RiffFormatChunk riffChunk = {};
+		const uint8_t* pcmData = nullptr;
+		size_t pcmSize = 0;
+		bool hasFormat = false;
+
+		while (reader.Remaining() >= 8)
 		{
-			stream.Read((uint8_t*)&ident[0], 4);
-		} while ((strncmp(ident, FormatTag, 4) != 0) && !stream.End());
+			auto chunkId = reader.Read<uint32_t>();
+			auto chunkSize = reader.Read<uint32_t>();
+			auto chunkStart = reader.Position();
 
-		if (stream.End())
+			if (chunkId == FormatTag)
+			{
+				hasFormat = reader.ReadBytes(&riffChunk, std::min<size_t>(chunkSize, sizeof(RiffFormatChunk)));
+			}
+			else if (chunkId == DataTag)
+			{
+				// Truncated files are common enough to keep whatever samples are there.
+				pcmSize = std::min<size_t>(chunkSize, reader.Remaining());
+				pcmData = reader.ReadArray<uint8_t>(pcmSize);
+
+				break;
+			}
+
+			if (!reader.Seek(chunkStart + ((size_t)chunkSize + 1) / 2 * 2))
+			{
+				break;
+			}
+		}
+
+		if (!hasFormat || !pcmData)
 		{
 			return nullptr;
 		}
 
-		stream.Seek(4, SeekMode::Current);
-
-		RiffFormatChunk riffChunk;
-		stream.Read((uint8_t*)&riffChunk, sizeof(RiffFormatChunk));
-
 		if (riffChunk.wFormatTag != 1)
 		{
 			return nullptr;
@@ -84,37 +112,21 @@ namespace Freeking
 			return nullptr;
 		}
 
-		uint32_t chunkId;
-		uint32_t chunkSize;
-		uint32_t dataSize = 0;
-		std::vector<char> pcmData;
-
-		for (uint32_t i = 12; i < fileSize;)
-		{
-			stream.Seek(i, SeekMode::Begin);
-			stream.Read((uint8_t*)&chunkId, sizeof(chunkId));
-			stream.Read((uint8_t*)&chunkSize, sizeof(chunkSize));
-
-			if (chunkId == 'atad')
-			{
-				pcmData.clear();
-				pcmData.resize(chunkSize, 0);
-				stream.Read((uint8_t*)&pcmData[0], chunkSize);
-				dataSize = chunkSize;
-
-				break;
-			}
+		auto data = std::make_unique<WavLoadData>();
+		data->bitsPerSample = riffChunk.wBitsPerSample;
+		data->channelCount = riffChunk.nChannels;
+		data->samplesPerSecond = riffChunk.nSamplesPerSec;
+		data->fileData = std::move(fileData);
+		data->pcmData = pcmData;
+		data->pcmSize = pcmSize;
 
-			chunkSize += 8;
-			chunkSize += 1;
-			chunkSize &= 0xfffffffe;
-			i += chunkSize;
-		}
+		return data;
+	}
 
-		auto bitsPerSample = riffChunk.wBitsPerSample;
-		auto channelCount = riffChunk.nChannels;
-		auto samplesPerSecond = riffChunk.nSamplesPerSec;
+	WavLoader::AssetPtr WavLoader::Upload(AssetLoadData& data) const
+	{
+		const auto& wavData = static_cast<WavLoadData&>(data);
 
-		return std::make_shared<AudioClip>(channelCount, bitsPerSample, samplesPerSecond, pcmData);
+		return std::make_shared<AudioClip>(wavData.channelCount, wavData.bitsPerSample, wavData.samplesPerSecond, wavData.pcmData, wavData.pcmSize);
 	}
 }
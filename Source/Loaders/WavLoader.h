@@ -9,6 +9,8 @@ namespace Freeking
 	public:
 
 		virtual bool CanLoadExtension(const std::string& extension) const override;
-		virtual AssetPtr Load(const std::string& name) const override;
+		virtual bool CanLoadAsync() const override { return true; }
+		virtual std::unique_ptr<AssetLoadData> Decode(const std::string& name) const override;
+		virtual AssetPtr Upload(AssetLoadData& data) const override;
 	};
 }
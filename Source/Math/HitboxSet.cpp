@@ -0,0 +1,185 @@
+#include "HitboxSet.h"
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FREEKING_HITBOX_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Freeking
+{
+	namespace
+	{
+		// Stands in for 1 / 0 on axes the trace does not move along. It pushes the slab
+		// distances far outside [0, 1] without the inf * 0 that would make them NaN.
+		constexpr float ParallelInverse = 1e30f;
+
+		inline float SafeInverse(float d)
+		{
+			return (d > 1e-20f || d < -1e-20f) ? (1.0f / d) : ParallelInverse;
+		}
+
+		struct Slab
+		{
+			float enter;
+			float exit;
+			int axis;
+		};
+
+		inline Slab SlabDistances(const float (&boxMin)[3], const float (&boxMax)[3], const Vector3f& start, const Vector3f& inverse)
+		{
+			Slab slab = { -ParallelInverse, ParallelInverse, 0 };
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float t1 = (boxMin[axis] - start[axis]) * inverse[axis];
+				float t2 = (boxMax[axis] - start[axis]) * inverse[axis];
+				float enter = std::min(t1, t2);
+
+				if (enter > slab.enter)
+				{
+					slab.enter = enter;
+					slab.axis = axis;
+				}
+
+				slab.exit = std::min(slab.exit, std::max(t1, t2));
+			}
+
+			return slab;
+		}
+	}
+
+	HitboxSet::HitboxSet() :
+		_numBoxes(0)
+	{
+	}
+
+	void HitboxSet::Clear()
+	{
+		_blocks.clear();
+		_numBoxes = 0;
+	}
+
+	void HitboxSet::Add(const Vector3f& a, const Vector3f& b)
+	{
+		if ((_numBoxes % 4) == 0)
+		{
+			_blocks.push_back({});
+		}
+
+		auto& block = _blocks.back();
+		size_t lane = _numBoxes % 4;
+
+		block.minX[lane] = std::min(a.x, b.x);
+		block.minY[lane] = std::min(a.y, b.y);
+		block.minZ[lane] = std::min(a.z, b.z);
+		block.maxX[lane] = std::max(a.x, b.x);
+		block.maxY[lane] = std::max(a.y, b.y);
+		block.maxZ[lane] = std::max(a.z, b.z);
+
+		_numBoxes++;
+	}
+
+	bool HitboxSet::Trace(const Vector3f& start, const Vector3f& end, const Vector3f& extents, float& fraction, size_t& box, Vector3f& normal) const
+	{
+		auto delta = end - start;
+		Vector3f inverse(SafeInverse(delta.x), SafeInverse(delta.y), SafeInverse(delta.z));
+
+		float bestFraction = 1.0f;
+		size_t bestBox = _numBoxes;
+
+#ifdef FREEKING_HITBOX_SSE
+		const __m128 startX = _mm_set1_ps(start.x), startY = _mm_set1_ps(start.y), startZ = _mm_set1_ps(start.z);
+		const __m128 inverseX = _mm_set1_ps(inverse.x), inverseY = _mm_set1_ps(inverse.y), inverseZ = _mm_set1_ps(inverse.z);
+		const __m128 extentX = _mm_set1_ps(extents.x), extentY = _mm_set1_ps(extents.y), extentZ = _mm_set1_ps(extents.z);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (size_t blockIndex = 0; blockIndex < _blocks.size(); ++blockIndex)
+		{
+			const auto& block = _blocks[blockIndex];
+
+			__m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_load_ps(block.minX), extentX), startX), inverseX);
+			__m128 t2x = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_load_ps(block.maxX), extentX), startX), inverseX);
+			__m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_load_ps(block.minY), extentY), startY), inverseY);
+			__m128 t2y = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_load_ps(block.maxY), extentY), startY), inverseY);
+			__m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_load_ps(block.minZ), extentZ), startZ), inverseZ);
+			__m128 t2z = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_load_ps(block.maxZ), extentZ), startZ), inverseZ);
+
+			__m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y)), _mm_min_ps(t1z, t2z));
+			__m128 exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y)), _mm_max_ps(t1z, t2z));
+
+			__m128 hit = _mm_and_ps(_mm_cmple_ps(enter, exit), _mm_and_ps(_mm_cmpge_ps(enter, zero), _mm_cmplt_ps(enter, _mm_set1_ps(bestFraction))));
+			int mask = _mm_movemask_ps(hit);
+
+			// The last block may be partly filled.
+			size_t lanes = std::min<size_t>(4, _numBoxes - (blockIndex * 4));
+			mask &= (1 << lanes) - 1;
+
+			if (mask == 0)
+			{
+				continue;
+			}
+
+			alignas(16) float enterLanes[4];
+			_mm_store_ps(enterLanes, enter);
+
+			for (size_t lane = 0; lane < lanes; ++lane)
+			{
+				if ((mask & (1 << lane)) && enterLanes[lane] < bestFraction)
+				{
+					bestFraction = enterLanes[lane];
+					bestBox = (blockIndex * 4) + lane;
+				}
+			}
+		}
+#else
+		for (size_t boxIndex = 0; boxIndex < _numBoxes; ++boxIndex)
+		{
+			const auto& block = _blocks[boxIndex / 4];
+			size_t lane = boxIndex % 4;
+
+			float boxMin[3] = { block.minX[lane] - extents.x, block.minY[lane] - extents.y, block.minZ[lane] - extents.z };
+			float boxMax[3] = { block.maxX[lane] + extents.x, block.maxY[lane] + extents.y, block.maxZ[lane] + extents.z };
+			auto slab = SlabDistances(boxMin, boxMax, start, inverse);
+
+			if (slab.enter <= slab.exit && slab.enter >= 0.0f && slab.enter < bestFraction)
+			{
+				bestFraction = slab.enter;
+				bestBox = boxIndex;
+			}
+		}
+#endif
+
+		if (bestBox == _numBoxes)
+		{
+			return false;
+		}
+
+		// Only the winning box needs the axis it was entered through.
+		const auto& block = _blocks[bestBox / 4];
+		size_t lane = bestBox % 4;
+
+		float boxMin[3] = { block.minX[lane] - extents.x, block.minY[lane] - extents.y, block.minZ[lane] - extents.z };
+		float boxMax[3] = { block.maxX[lane] + extents.x, block.maxY[lane] + extents.y, block.maxZ[lane] + extents.z };
+		auto slab = SlabDistances(boxMin, boxMax, start, inverse);
+
+		normal = Vector3f(0, 0, 0);
+		normal[slab.axis] = (delta[slab.axis] > 0.0f) ? -1.0f : 1.0f;
+		fraction = bestFraction;
+		box = bestBox;
+
+		return true;
+	}
+
+	bool HitboxSet::SegmentIntersectsBox(const Vector3f& start, const Vector3f& end, const Vector3f& boxMin, const Vector3f& boxMax)
+	{
+		auto delta = end - start;
+		Vector3f inverse(SafeInverse(delta.x), SafeInverse(delta.y), SafeInverse(delta.z));
+
+		float minBounds[3] = { boxMin.x, boxMin.y, boxMin.z };
+		float maxBounds[3] = { boxMax.x, boxMax.y, boxMax.z };
+		auto slab = SlabDistances(minBounds, maxBounds, start, inverse);
+
+		return slab.enter <= slab.exit && slab.exit >= 0.0f && slab.enter <= 1.0f;
+	}
+}
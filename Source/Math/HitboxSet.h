@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Vector.h"
+#include <vector>
+#include <cstddef>
+
+namespace Freeking
+{
+	// Axis aligned boxes in a shared space, packed four to a block so a trace is tested
+	// against four boxes at once. Callers move the trace into the boxes' space first, which
+	// makes oriented boxes with a common transform, such as the hitboxes of one model, as
+	// cheap as axis aligned ones.
+	class HitboxSet
+	{
+	public:
+
+		HitboxSet();
+
+		void Clear();
+		void Add(const Vector3f& a, const Vector3f& b);
+
+		// Sweeps a box of the given half extents from start to end and returns the first box
+		// entered. Boxes the trace starts inside are ignored, so a trace can always leave.
+		bool Trace(const Vector3f& start, const Vector3f& end, const Vector3f& extents, float& fraction, size_t& box, Vector3f& normal) const;
+
+		inline size_t GetNumBoxes() const { return _numBoxes; }
+
+		static bool SegmentIntersectsBox(const Vector3f& start, const Vector3f& end, const Vector3f& boxMin, const Vector3f& boxMax);
+
+	private:
+
+		struct alignas(16) Block
+		{
+			float minX[4];
+			float minY[4];
+			float minZ[4];
+			float maxX[4];
+			float maxY[4];
+			float maxZ[4];
+		};
+
+		std::vector<Block> _blocks;
+		size_t _numBoxes;
+	};
+}
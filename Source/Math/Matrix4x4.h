@@ -42,6 +42,8 @@ namespace Freeking
 		Vector4f operator*(const Vector4f& rhs) const;
 		Vector3f operator*(const Vector3f& rhs) const;
 		Matrix4x4 operator*(float rhs) const;
+		inline bool operator==(const Matrix4x4& rhs) const { return m[0] == rhs.m[0] && m[1] == rhs.m[1] && m[2] == rhs.m[2] && m[3] == rhs.m[3]; }
+		inline bool operator!=(const Matrix4x4& rhs) const { return !(*this == rhs); }
 		inline Vector4f& operator[](unsigned int value) { return m[value]; }
 		inline const Vector4f& operator[](unsigned int value) const { return m[value]; }
 
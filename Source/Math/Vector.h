@@ -771,6 +771,16 @@ namespace Freeking
 			return *this;
 		}
 
+		bool operator==(const Vector4<T>& v) const
+		{
+			return (v.x == x) && (v.y == y) && (v.z == z) && (v.w == w);
+		}
+
+		bool operator!=(const Vector4<T>& v) const
+		{
+			return !(*this == v);
+		}
+
 		Vector3<T> xyz() const
 		{
 			return Vector3<T>(x, y, z);
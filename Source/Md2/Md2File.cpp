@@ -1,5 +1,173 @@
 #include "Md2File.h"
+#include "AssetLoadQueue.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
 
 namespace Freeking
 {
+	namespace
+	{
+		// Frame vertices decoded per parallel chunk, so small models stay on one thread.
+		constexpr size_t FrameVertexGrain = 16384;
+	}
+
+	bool MD2File::Read(BinaryReader& reader, DynamicModelData& data)
+	{
+		MD2Header header;
+		if (!ReadHeader(reader, header))
+		{
+			return false;
+		}
+
+		const size_t numFrames = header.NumFrames;
+		const size_t numVertices = header.NumVertices;
+		const size_t frameSize = sizeof(MD2Frame) + (numVertices * sizeof(MD2Vertex));
+
+		// The frames are checked to fit before anything is sized from the header counts.
+		reader.Seek(header.OffsetFrames);
+		if (!reader || numFrames > reader.Remaining() / frameSize)
+		{
+			return false;
+		}
+
+		auto frames = reader.ReadArray<uint8_t>(numFrames * frameSize);
+
+		data.SetFrameCount(header.NumFrames);
+		data.SetFrameVertexCount(header.NumVertices);
+		data.FrameTransforms.resize(numFrames);
+		data.FrameVertices.resize(numFrames * numVertices);
+
+		AssetLoadQueue::ParallelFor(numFrames, FrameVertexGrain / std::max(numVertices, (size_t)1), [&](size_t begin, size_t end)
+		{
+			for (size_t frameIndex = begin; frameIndex < end; ++frameIndex)
+			{
+				auto frameData = frames + (frameIndex * frameSize);
+
+				MD2Frame frame;
+				std::memcpy(&frame, frameData, sizeof(MD2Frame));
+
+				auto& frameTransform = data.FrameTransforms[frameIndex];
+				frameTransform.name.assign(frame.Name.data(), strnlen(frame.Name.data(), frame.Name.size()));
+				frameTransform.translate = Vector3f(frame.Translate[0], frame.Translate[1], frame.Translate[2]);
+				frameTransform.scale = Vector3f(frame.Scale[0], frame.Scale[1], frame.Scale[2]);
+
+				auto vertices = reinterpret_cast<const MD2Vertex*>(frameData + sizeof(MD2Frame));
+				auto frameVertices = data.FrameVertices.data() + (frameIndex * numVertices);
+
+				for (size_t vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex)
+				{
+					const auto& vertex = vertices[vertexIndex];
+
+					frameVertices[vertexIndex] =
+					{
+						(int8_t)(vertex.X - 128),
+						(int8_t)(vertex.Y - 128),
+						(int8_t)(vertex.Z - 128),
+						(int8_t)(vertex.NormalIndex - 128)
+					};
+				}
+			}
+		});
+
+		// Count the commands first so the vertex and index arrays are only allocated once.
+		reader.Seek(header.OffsetCommands);
+
+		size_t numCommandVertices = 0;
+		size_t numIndices = 0;
+
+		{
+			BinaryReader counter = reader;
+			for (int commandIndex = 0; commandIndex < header.NumCommands; ++commandIndex)
+			{
+				auto command = counter.Read<MD2Command>();
+				if (command.TrisTypeNum == 0)
+				{
+					break;
+				}
+
+				auto numVerticesInCommand = std::abs((int64_t)command.TrisTypeNum);
+				if (numVerticesInCommand < 3 || !counter.Skip(numVerticesInCommand * sizeof(MD2CommandVertex)))
+				{
+					return false;
+				}
+
+				numCommandVertices += numVerticesInCommand;
+				numIndices += (numVerticesInCommand - 2) * 3;
+			}
+
+			if (!counter)
+			{
+				return false;
+			}
+		}
+
+		data.Vertices.resize(numCommandVertices);
+		data.Indices.resize(numIndices);
+
+		auto vertexOut = data.Vertices.data();
+		auto indexOut = data.Indices.data();
+		uint32_t vertexOffset = 0;
+
+		while (vertexOffset < numCommandVertices)
+		{
+			auto command = reader.Read<MD2Command>();
+			auto numVerticesInCommand = (int)std::abs((int64_t)command.TrisTypeNum);
+
+			for (int commandVertexIndex = 0; commandVertexIndex < numVerticesInCommand; ++commandVertexIndex)
+			{
+				auto commandVertex = reader.Read<MD2CommandVertex>();
+				if (commandVertex.VertexIndex < 0 || commandVertex.VertexIndex >= header.NumVertices)
+				{
+					return false;
+				}
+
+				*vertexOut++ =
+				{
+					Vector2f(commandVertex.TextureCoordinates[0], commandVertex.TextureCoordinates[1]),
+					commandVertex.VertexIndex,
+					0
+				};
+			}
+
+			for (int vertexIndex = 0; vertexIndex < numVerticesInCommand - 2; ++vertexIndex)
+			{
+				if (command.TrisTypeNum < 0)
+				{
+					*indexOut++ = vertexOffset + (vertexIndex + 2);
+					*indexOut++ = vertexOffset + (vertexIndex + 1);
+					*indexOut++ = vertexOffset;
+				}
+				else if ((vertexIndex % 2) == 0)
+				{
+					*indexOut++ = vertexOffset + (vertexIndex + 2);
+					*indexOut++ = vertexOffset + (vertexIndex + 1);
+					*indexOut++ = vertexOffset + vertexIndex;
+				}
+				else
+				{
+					*indexOut++ = vertexOffset + vertexIndex;
+					*indexOut++ = vertexOffset + (vertexIndex + 1);
+					*indexOut++ = vertexOffset + (vertexIndex + 2);
+				}
+			}
+
+			vertexOffset += numVerticesInCommand;
+		}
+
+		reader.Seek(header.OffsetSkins);
+		if (!reader || (size_t)header.NumSkins > reader.Remaining() / sizeof(MD2Skin))
+		{
+			return false;
+		}
+
+		data.Skins.resize(header.NumSkins);
+
+		for (auto& skin : data.Skins)
+		{
+			skin = reader.ReadString(sizeof(MD2Skin::Path));
+		}
+
+		return (bool)reader;
+	}
 }
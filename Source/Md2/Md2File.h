@@ -1,7 +1,8 @@
 #pragma once
 
 #include "Md2Structures.h"
-#include "DynamicModel.h"
+#include "BinaryReader.h"
+#include "DynamicModelData.h"
 #include <array>
 #include <stdint.h>
 
@@ -9,28 +10,23 @@ namespace Freeking
 {
 	struct MD2File
 	{
-		static const MD2File& Create(const uint8_t* data)
+		static bool ReadHeader(BinaryReader& reader, MD2Header& header)
 		{
-			return (const MD2File&)*data;
-		}
+			if (!reader.Read(header) || header.Ident != Ident || header.Version != Version)
+			{
+				return false;
+			}
 
-		inline bool IsValid() const
-		{
-			return Header.Ident == Ident && Header.Version == Version;
+			return
+				header.NumSkins >= 0 && header.NumVertices >= 0 && header.NumCommands >= 0 && header.NumFrames >= 0 &&
+				header.OffsetSkins >= 0 && header.OffsetFrames >= 0 && header.OffsetCommands >= 0;
 		}
 
-		template<typename T>
-		const T* Read(uint32_t& offset, uint32_t count) const
-		{
-			auto ptr = (T*)((const char*)this + offset);
-			offset += (sizeof(T) * count);
-
-			return ptr;
-		}
+		// Decodes the model into data, leaving LODs and animations for the caller to build.
+		// Frames are decoded in parallel on the asset workers when there are enough of them.
+		static bool Read(BinaryReader& reader, DynamicModelData& data);
 
 		static const int Ident = 0x32504449;
 		static const int Version = 8;
-
-		MD2Header Header;
 	};
 }
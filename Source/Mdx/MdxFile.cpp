@@ -1,5 +1,205 @@
 #include "MdxFile.h"
+#include "AssetLoadQueue.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
 
 namespace Freeking
 {
+	namespace
+	{
+		// Frame vertices decoded per parallel chunk, so small models stay on one thread.
+		constexpr size_t FrameVertexGrain = 16384;
+	}
+
+	bool MDXFile::Read(BinaryReader& reader, DynamicModelData& data)
+	{
+		MDXHeader header;
+		if (!ReadHeader(reader, header))
+		{
+			return false;
+		}
+
+		const size_t numFrames = header.NumFrames;
+		const size_t numVertices = header.NumVertices;
+		const size_t frameSize = sizeof(MDXFrame) + (numVertices * sizeof(MDXVertex));
+
+		// The frames are checked to fit before anything is sized from the header counts.
+		reader.Seek(header.OffsetFrames);
+		if (!reader || numFrames > reader.Remaining() / frameSize)
+		{
+			return false;
+		}
+
+		auto frames = reader.ReadArray<uint8_t>(numFrames * frameSize);
+
+		data.SetFrameCount(header.NumFrames);
+		data.SetFrameVertexCount(header.NumVertices);
+		data.FrameTransforms.resize(numFrames);
+		data.FrameVertices.resize(numFrames * numVertices);
+
+		AssetLoadQueue::ParallelFor(numFrames, FrameVertexGrain / std::max(numVertices, (size_t)1), [&](size_t begin, size_t end)
+		{
+			for (size_t frameIndex = begin; frameIndex < end; ++frameIndex)
+			{
+				auto frameData = frames + (frameIndex * frameSize);
+
+				MDXFrame frame;
+				std::memcpy(&frame, frameData, sizeof(MDXFrame));
+
+				auto& frameTransform = data.FrameTransforms[frameIndex];
+				frameTransform.name.assign((const char*)frame.Name.data(), strnlen((const char*)frame.Name.data(), frame.Name.size()));
+				frameTransform.translate = Vector3f(frame.Translate[0], frame.Translate[1], frame.Translate[2]);
+				frameTransform.scale = Vector3f(frame.Scale[0], frame.Scale[1], frame.Scale[2]);
+
+				auto vertices = reinterpret_cast<const MDXVertex*>(frameData + sizeof(MDXFrame));
+				auto frameVertices = data.FrameVertices.data() + (frameIndex * numVertices);
+
+				for (size_t vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex)
+				{
+					const auto& vertex = vertices[vertexIndex];
+
+					frameVertices[vertexIndex] =
+					{
+						(int8_t)(vertex.Vertex[0] - 128),
+						(int8_t)(vertex.Vertex[1] - 128),
+						(int8_t)(vertex.Vertex[2] - 128),
+						(int8_t)(vertex.NormalIndex - 128)
+					};
+				}
+			}
+		});
+
+		// Count the commands first so the vertex and index arrays are only allocated once.
+		reader.Seek(header.OffsetCommands);
+
+		size_t numCommandVertices = 0;
+		size_t numIndices = 0;
+
+		{
+			BinaryReader counter = reader;
+			for (int commandIndex = 0; commandIndex < header.NumCommands; ++commandIndex)
+			{
+				auto command = counter.Read<MDXCommand>();
+				if (command.TrisTypeNum == 0)
+				{
+					break;
+				}
+
+				auto numVerticesInCommand = std::abs((int64_t)command.TrisTypeNum);
+				if (numVerticesInCommand < 3 || !counter.Skip(numVerticesInCommand * sizeof(MDXCommandVertex)))
+				{
+					return false;
+				}
+
+				numCommandVertices += numVerticesInCommand;
+				numIndices += (numVerticesInCommand - 2) * 3;
+			}
+
+			if (!counter)
+			{
+				return false;
+			}
+		}
+
+		data.Vertices.resize(numCommandVertices);
+		data.Indices.resize(numIndices);
+
+		auto vertexOut = data.Vertices.data();
+		auto indexOut = data.Indices.data();
+		uint32_t vertexOffset = 0;
+
+		while (vertexOffset < numCommandVertices)
+		{
+			auto command = reader.Read<MDXCommand>();
+			auto numVerticesInCommand = (int)std::abs((int64_t)command.TrisTypeNum);
+
+			if (data.SubObjects.size() == command.SubObjectID)
+			{
+				data.SubObjects.push_back({ (int)(indexOut - data.Indices.data()), 0 });
+			}
+
+			if (data.SubObjects.empty())
+			{
+				return false;
+			}
+
+			data.SubObjects.back().numIndices += (numVerticesInCommand - 2) * 3;
+
+			for (int commandVertexIndex = 0; commandVertexIndex < numVerticesInCommand; ++commandVertexIndex)
+			{
+				auto commandVertex = reader.Read<MDXCommandVertex>();
+				if (commandVertex.VertexIndex < 0 || commandVertex.VertexIndex >= header.NumVertices)
+				{
+					return false;
+				}
+
+				*vertexOut++ =
+				{
+					Vector2f(commandVertex.TextureCoordinates[0], commandVertex.TextureCoordinates[1]),
+					commandVertex.VertexIndex,
+					0
+				};
+			}
+
+			for (int vertexIndex = 0; vertexIndex < numVerticesInCommand - 2; ++vertexIndex)
+			{
+				if (command.TrisTypeNum < 0)
+				{
+					*indexOut++ = vertexOffset + (vertexIndex + 2);
+					*indexOut++ = vertexOffset + (vertexIndex + 1);
+					*indexOut++ = vertexOffset;
+				}
+				else if ((vertexIndex % 2) == 0)
+				{
+					*indexOut++ = vertexOffset + (vertexIndex + 2);
+					*indexOut++ = vertexOffset + (vertexIndex + 1);
+					*indexOut++ = vertexOffset + vertexIndex;
+				}
+				else
+				{
+					*indexOut++ = vertexOffset + vertexIndex;
+					*indexOut++ = vertexOffset + (vertexIndex + 1);
+					*indexOut++ = vertexOffset + (vertexIndex + 2);
+				}
+			}
+
+			vertexOffset += numVerticesInCommand;
+		}
+
+		reader.Seek(header.OffsetSkins);
+		if (!reader || (size_t)header.NumSkins > reader.Remaining() / sizeof(MDXSkin))
+		{
+			return false;
+		}
+
+		data.Skins.resize(header.NumSkins);
+
+		for (auto& skin : data.Skins)
+		{
+			skin = reader.ReadString(sizeof(MDXSkin::Path));
+		}
+
+		reader.Seek(header.OffsetBBoxFrames);
+		if (!reader || (size_t)header.NumSubObjects * numFrames > reader.Remaining() / sizeof(MDXBBox))
+		{
+			return false;
+		}
+
+		data.FrameBounds.resize(header.NumSubObjects);
+
+		for (auto& subObjectBounds : data.FrameBounds)
+		{
+			subObjectBounds.resize(numFrames);
+
+			for (auto& frameBounds : subObjectBounds)
+			{
+				auto bbox = reader.Read<MDXBBox>();
+				frameBounds.boundsMin = Vector3f(bbox.MinX, bbox.MinZ, -bbox.MinY);
+				frameBounds.boundsMax = Vector3f(bbox.MaxX, bbox.MaxZ, -bbox.MaxY);
+			}
+		}
+
+		return (bool)reader;
+	}
 }
@@ -1,33 +1,49 @@
 #include "NavFile.h"
+#include "BinaryReader.h"
+#include <array>
 
 namespace Freeking
 {
-	std::vector<NavNode> NavFile::ReadNodes(const uint8_t* data)
+	std::vector<NavNode> NavFile::ReadNodes(const uint8_t* data, size_t size)
 	{
-		if (*(uint16_t*)&data[0] != 4)
+		BinaryReader reader(data, size);
+
+		if (reader.Read<uint16_t>() != 4)
 		{
 			return {};
 		}
 
-		size_t pos = 4;
-		uint16_t numNodes = *(uint16_t*)&data[pos];
-		pos += 2;
+		reader.Seek(4);
+		auto numNodes = reader.Read<uint16_t>();
+
+		// Each node carries a position, 52 unknown bytes and a nibble per node.
+		size_t nodeSize = 16 + 52 + (numNodes + 1) / 2;
+		if (!reader || (size_t)numNodes * nodeSize > reader.Remaining())
+		{
+			return {};
+		}
 
 		std::vector<NavNode> nodes(numNodes);
 
 		for (int i = 0; i < numNodes; ++i)
 		{
 			NavNode& node = nodes[i];
-			node.Position = *(Vector4f*)&data[pos];
-			pos += 16;
-			pos += 52; // what's this data
+			auto position = reader.Read<std::array<float, 4>>();
+			node.Position = Vector4f(position[0], position[1], position[2], position[3]);
+			reader.Skip(52); // what's this data
 
-			for (int j = 0; j < numNodes; ++j)
+			auto flags = reader.ReadArray<uint8_t>((numNodes + 1) / 2);
+			if (!flags)
 			{
-				node.NodeFlags.emplace_back((NavFlag)((j % 2 == 0) ? data[pos + (j / 2)] >> 4 : data[pos + (j / 2)] & 0x0F));
+				return {};
 			}
 
-			pos += (numNodes + 1) / 2;
+			node.NodeFlags.reserve(numNodes);
+
+			for (int j = 0; j < numNodes; ++j)
+			{
+				node.NodeFlags.emplace_back((NavFlag)((j % 2 == 0) ? flags[j / 2] >> 4 : flags[j / 2] & 0x0F));
+			}
 		}
 
 		return nodes;
@@ -0,0 +1,114 @@
+#include "AnimationScheduler.h"
+#include "Renderer.h"
+#include "Maths.h"
+#include <cmath>
+
+namespace Freeking
+{
+	std::vector<AnimationState> AnimationScheduler::_states;
+	std::vector<uint32_t> AnimationScheduler::_freeSlots;
+	size_t AnimationScheduler::_numEvaluated = 0;
+	size_t AnimationScheduler::_numClockOnly = 0;
+
+	uint32_t AnimationScheduler::Allocate()
+	{
+		uint32_t slot;
+
+		if (!_freeSlots.empty())
+		{
+			slot = _freeSlots.back();
+			_freeSlots.pop_back();
+		}
+		else
+		{
+			slot = (uint32_t)_states.size();
+			_states.emplace_back();
+		}
+
+		auto& state = _states[slot];
+		state = {};
+		state.rate = 10.0f;
+		state.numFrames = 0;
+		state.active = true;
+
+		return slot;
+	}
+
+	void AnimationScheduler::Release(uint32_t slot)
+	{
+		_states[slot].active = false;
+		_freeSlots.push_back(slot);
+	}
+
+	void AnimationScheduler::AdvanceClock(AnimationState& state, double dt)
+	{
+		state.playTime += state.rate * dt;
+
+		if (state.playTime >= state.numFrames)
+		{
+			state.playTime -= state.numFrames;
+
+			// Only a long stall wraps more than once.
+			if (state.playTime >= state.numFrames)
+			{
+				state.playTime = fmod(state.playTime, (double)state.numFrames);
+			}
+		}
+	}
+
+	void AnimationScheduler::Evaluate(AnimationState& state)
+	{
+		if (state.numFrames == 0)
+		{
+			return;
+		}
+
+		auto frame = Math::Min((uint32_t)state.playTime, state.numFrames - 1);
+		auto nextFrame = (frame + 1 == state.numFrames) ? 0 : frame + 1;
+
+		state.frame = state.firstFrame + frame;
+		state.nextFrame = state.firstFrame + nextFrame;
+		state.delta = Math::Clamp((float)(state.playTime - frame), 0.0f, 1.0f);
+		state.stale = false;
+	}
+
+	void AnimationScheduler::Update(double dt)
+	{
+		_numEvaluated = 0;
+		_numClockOnly = 0;
+
+		const auto& viewMatrix = Renderer::ViewMatrix;
+		float scaleX = Renderer::ProjectionMatrix[0].x;
+		float scaleY = Renderer::ProjectionMatrix[1].y;
+		float normaliseX = 1.0f / std::sqrt(scaleX * scaleX + 1.0f);
+		float normaliseY = 1.0f / std::sqrt(scaleY * scaleY + 1.0f);
+
+		for (auto& state : _states)
+		{
+			if (!state.active || !state.scheduled || state.numFrames == 0)
+			{
+				continue;
+			}
+
+			AdvanceClock(state, dt);
+
+			// The side planes of a symmetric perspective projection, in view space looking down -z.
+			auto viewPosition = viewMatrix.Transform(Vector4f(state.center.x, state.center.y, state.center.z, 1.0f));
+			float depth = -viewPosition.z;
+			bool visible = !state.hidden &&
+				depth > -state.radius &&
+				(std::abs(viewPosition.x) * scaleX - depth) * normaliseX <= state.radius &&
+				(std::abs(viewPosition.y) * scaleY - depth) * normaliseY <= state.radius;
+
+			if (!visible)
+			{
+				state.stale = true;
+				_numClockOnly++;
+				continue;
+			}
+
+			Evaluate(state);
+			_numEvaluated++;
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Vector.h"
+#include <vector>
+#include <cstdint>
+
+namespace Freeking
+{
+	// Playback state of one FrameAnimator. Frames are absolute indices into the model.
+	struct AnimationState
+	{
+		double playTime;
+		float rate;
+		float delta;
+		uint32_t firstFrame;
+		uint32_t numFrames;
+		uint32_t frame;
+		uint32_t nextFrame;
+		Vector3f center;
+		float radius;
+		bool scheduled;
+		bool hidden;
+		bool stale;
+		bool active;
+	};
+
+	// Owns the state of every FrameAnimator in one array and advances the scheduled ones in a
+	// single pass each tick. Every clock advances, but poses are only worked out for casts in
+	// view. Casts outside the view or hidden are marked stale and evaluated when they next
+	// come into view or are resolved for a trace.
+	class AnimationScheduler
+	{
+	public:
+
+		AnimationScheduler() = delete;
+		~AnimationScheduler() = delete;
+
+		static uint32_t Allocate();
+		static void Release(uint32_t slot);
+
+		// Advances every scheduled animator. Visibility uses the view of the last frame rendered.
+		static void Update(double dt);
+
+		// Works out the pose from the clock, for animators driven directly or that have
+		// just come into view.
+		static void AdvanceClock(AnimationState& state, double dt);
+		static void Evaluate(AnimationState& state);
+
+		static inline AnimationState& GetState(uint32_t slot) { return _states[slot]; }
+
+		static inline size_t GetNumAnimators() { return _states.size() - _freeSlots.size(); }
+		static inline size_t GetNumEvaluated() { return _numEvaluated; }
+		static inline size_t GetNumClockOnly() { return _numClockOnly; }
+
+	private:
+
+		static std::vector<AnimationState> _states;
+		static std::vector<uint32_t> _freeSlots;
+		static size_t _numEvaluated;
+		static size_t _numClockOnly;
+	};
+}
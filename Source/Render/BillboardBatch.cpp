@@ -2,11 +2,13 @@
 #include "IndexBuffer.h"
 #include "VertexBinding.h"
 #include "VertexBuffer.h"
+#include "StreamingBuffer.h"
 #include "Shader.h"
 #include "Texture2D.h"
 #include "Map.h"
 #include "Math.h"
 #include <array>
+#include <cstring>
 
 namespace Freeking
 {
@@ -24,29 +26,46 @@ namespace Freeking
 
 	static const std::array<uint32_t, 6> quadIndices = { 0, 1, 2, 2, 3, 0 };
 
-	BillboardBatch::BillboardBatch()
+	BillboardBatch::BillboardBatch() :
+		_bindingGeneration(0)
 	{
 		_vertexBuffer = std::make_shared<VertexBuffer>(quadVertices.data(), quadVertices.size(), vertStride);
 		_indexBuffer = std::make_shared<IndexBuffer>(quadIndices.data(), quadIndices.size(), GL_UNSIGNED_INT);
-		_instanceBuffer = std::make_shared<VertexBuffer>(_instances.data(), 1000, instanceStride);
+		_vertexBinding = std::make_shared<VertexBinding>();
+
+		_shader = Shader::Library.Billboard;
+		_coronaTexture = AssetHandle<Texture2D>(Texture2D::Library, "sprites/corona_a.tga");
+	}
+
+	void BillboardBatch::UpdateBinding()
+	{
+		if (_bindingGeneration == StreamingBuffer::GetGeneration())
+		{
+			return;
+		}
+
+		auto instanceBuffer = StreamingBuffer::GetVertexBuffer();
 
 		ArrayElement vertexLayout[] = {
 			ArrayElement(_vertexBuffer.get(), 0, 2, ElementType::Float, vertStride, 0),
-			ArrayElement(_instanceBuffer.get(), 1, 3, ElementType::Float, instanceStride, 0 * sizeof(float), 1),
-			ArrayElement(_instanceBuffer.get(), 2, 2, ElementType::Float, instanceStride, 3 * sizeof(float), 1),
-			ArrayElement(_instanceBuffer.get(), 3, 4, ElementType::Float, instanceStride, 5 * sizeof(float), 1),
+			ArrayElement(instanceBuffer, 1, 3, ElementType::Float, instanceStride, 0 * sizeof(float), 1),
+			ArrayElement(instanceBuffer, 2, 2, ElementType::Float, instanceStride, 3 * sizeof(float), 1),
+			ArrayElement(instanceBuffer, 3, 4, ElementType::Float, instanceStride, 5 * sizeof(float), 1),
 		};
 
-		_vertexBinding = std::make_shared<VertexBinding>();
 		_vertexBinding->Create(vertexLayout, 4, *_indexBuffer, ElementType::UInt);
-
-		_shader = Shader::Library.Billboard;
+		_bindingGeneration = StreamingBuffer::GetGeneration();
 	}
 
 	void BillboardBatch::Draw(double dt, const Vector3f& eyePosition, const Vector3f& eyeDirection)
 	{
+		if (_instances.empty())
+		{
+			return;
+		}
+
 		_shader->Bind();
-		_shader->SetParameterValue("diffuse", Texture2D::Library.Get("sprites/corona_a.tga").get());
+		_shader->SetParameterValue("diffuse", _coronaTexture.Get());
 
 		for (auto& instance : _instances)
 		{
@@ -75,14 +94,23 @@ namespace Freeking
 			}
 		}
 
-		_instanceBuffer->UpdateBuffer(_instances.data(), 0, _instances.size() * instanceStride);
+		size_t firstInstance;
+		auto instanceData = StreamingBuffer::Allocate(_instances.size(), instanceStride, firstInstance);
+		if (!instanceData)
+		{
+			_shader->Unbind();
+			return;
+		}
+
+		std::memcpy(instanceData, _instances.data(), _instances.size() * instanceStride);
+		UpdateBinding();
 
 		glBlendFunc(GL_ONE, GL_ONE);
 		glDisable(GL_DEPTH_TEST);
 		glDepthMask(GL_FALSE);
 
 		_vertexBinding->Bind();
-		glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(_instances.size()));
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(_instances.size()), static_cast<GLuint>(firstInstance));
 		_vertexBinding->Unbind();
 
 		glEnable(GL_DEPTH_TEST);
@@ -95,6 +123,5 @@ namespace Freeking
 	void BillboardBatch::AddInstance(const Vector3f& position)
 	{
 		_instances.push_back({ position, Vector2f(0, 0), Vector4f(1, 1, 1, 1) });
-		_instanceBuffer->UpdateBuffer(&_instances[_instances.size() - 1], (_instances.size() - 1) * instanceStride, instanceStride);
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Vector.h"
+#include "AssetLibrary.h"
 #include <vector>
 #include <memory>
 
@@ -35,14 +36,18 @@ namespace Freeking
 
 		void Draw(double dt, const Vector3f& eyePosition, const Vector3f& eyeDirection);
 		void AddInstance(const Vector3f& position);
+		inline void Clear() { _instances.clear(); }
 
 	private:
 
+		void UpdateBinding();
+
 		std::shared_ptr<VertexBuffer> _vertexBuffer;
 		std::shared_ptr<IndexBuffer> _indexBuffer;
-		std::shared_ptr<VertexBuffer> _instanceBuffer;
 		std::shared_ptr<VertexBinding> _vertexBinding;
+		uint32_t _bindingGeneration;
 		std::shared_ptr<Shader> _shader;
+		AssetHandle<Texture2D> _coronaTexture;
 		std::vector<BillboardInstance> _instances;
 	};
 }
@@ -0,0 +1,188 @@
+#include "CastModel.h"
+#include "Texture2D.h"
+#include "Shader.h"
+#include <iostream>
+
+namespace Freeking
+{
+	std::unordered_map<std::string, std::weak_ptr<CastModel>> CastModel::_castModels;
+	GLuint CastModel::_framebuffer = 0;
+	GLuint CastModel::_vertexArray = 0;
+
+	CastModel::CastModel(const std::shared_ptr<DynamicModel>& model) :
+		_model(model),
+		_skins(std::make_unique<Texture2DArray>(SkinSize, SkinSize, 4))
+	{
+	}
+
+	std::shared_ptr<CastModel> CastModel::Get(const std::string& key, const std::vector<const DynamicModel*>& parts)
+	{
+		if (auto it = _castModels.find(key); it != _castModels.end())
+		{
+			if (auto castModel = it->second.lock())
+			{
+				return castModel;
+			}
+		}
+
+		auto model = DynamicModel::Merge(parts);
+		if (!model)
+		{
+			std::cout << "Unable to merge cast model: " << key << std::endl;
+			return nullptr;
+		}
+
+		auto castModel = std::make_shared<CastModel>(model);
+		_castModels[key] = castModel;
+
+		return castModel;
+	}
+
+	int32_t CastModel::GetSkinLayer(const std::string& name, const std::shared_ptr<Texture2D>& source)
+	{
+		if (auto it = _skinLayers.find(name); it != _skinLayers.end())
+		{
+			return it->second;
+		}
+
+		auto layer = (int32_t)_skinLayers.size();
+		if (layer >= _skins->GetNumLayers())
+		{
+			_skins->Resize(_skins->GetNumLayers() * 2);
+		}
+
+		_skinLayers.insert({ name, layer });
+
+		if (source)
+		{
+			_pendingSkins.push_back({ source, layer, Texture2D::NoRequest });
+		}
+
+		return layer;
+	}
+
+	void CastModel::Update()
+	{
+		std::vector<CastModel*> castModels;
+
+		for (auto it = _castModels.begin(); it != _castModels.end();)
+		{
+			if (auto castModel = it->second.lock())
+			{
+				if (!castModel->_pendingSkins.empty())
+				{
+					castModels.push_back(castModel.get());
+				}
+
+				++it;
+			}
+			else
+			{
+				it = _castModels.erase(it);
+			}
+		}
+
+		if (castModels.empty())
+		{
+			return;
+		}
+
+		if (!_framebuffer)
+		{
+			glGenFramebuffers(1, &_framebuffer);
+			glGenVertexArrays(1, &_vertexArray);
+		}
+
+		GLint previousFramebuffer;
+		GLint previousViewport[4];
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+		glGetIntegerv(GL_VIEWPORT, previousViewport);
+		bool depthTest = glIsEnabled(GL_DEPTH_TEST);
+		bool blend = glIsEnabled(GL_BLEND);
+		bool cullFace = glIsEnabled(GL_CULL_FACE);
+		bool scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _framebuffer);
+		glViewport(0, 0, SkinSize, SkinSize);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+		glDisable(GL_CULL_FACE);
+		glDisable(GL_SCISSOR_TEST);
+		glBindVertexArray(_vertexArray);
+
+		Shader::Library.Blit->Bind();
+
+		for (auto castModel : castModels)
+		{
+			if (castModel->UpdateSkins())
+			{
+				castModel->_skins->GenerateMipmaps();
+			}
+		}
+
+		Shader::Library.Blit->Unbind();
+
+		glBindVertexArray(0);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+		glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+		if (depthTest) glEnable(GL_DEPTH_TEST);
+		if (blend) glEnable(GL_BLEND);
+		if (cullFace) glEnable(GL_CULL_FACE);
+		if (scissorTest) glEnable(GL_SCISSOR_TEST);
+	}
+
+	bool CastModel::UpdateSkins()
+	{
+		bool copied = false;
+
+		for (auto it = _pendingSkins.begin(); it != _pendingSkins.end();)
+		{
+			auto& pendingSkin = *it;
+			auto firstLevel = pendingSkin.source->GetFirstLevel();
+
+			if (firstLevel < pendingSkin.copiedLevel)
+			{
+				CopySkin(pendingSkin.source.get(), pendingSkin.layer);
+				pendingSkin.copiedLevel = firstLevel;
+				copied = true;
+			}
+
+			// Once the full texture has been copied the source is no longer needed and can be
+			// evicted with the rest of the unreferenced assets.
+			if (pendingSkin.copiedLevel == 0)
+			{
+				it = _pendingSkins.erase(it);
+			}
+			else
+			{
+				pendingSkin.source->RequestLevel(0);
+				++it;
+			}
+		}
+
+		return copied;
+	}
+
+	void CastModel::CopySkin(const Texture2D* source, int32_t layer)
+	{
+		glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _skins->GetId(), 0, layer);
+
+		Shader::Library.Blit->SetParameterValue("source", source, nullptr);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+	}
+
+	size_t CastModel::GetTotalSkinBytes()
+	{
+		size_t totalBytes = 0;
+
+		for (const auto& [key, weakCastModel] : _castModels)
+		{
+			if (auto castModel = weakCastModel.lock())
+			{
+				totalBytes += castModel->_skins->GetNumBytes();
+			}
+		}
+
+		return totalBytes;
+	}
+}
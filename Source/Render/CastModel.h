@@ -0,0 +1,63 @@
+#pragma once
+
+#include "DynamicModel.h"
+#include "Texture2DArray.h"
+#include <glad/gl.h>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace Freeking
+{
+	class Texture2D;
+
+	// The body parts of a cast merged into one model, with their skins copied into layers of
+	// one texture array, so a cast draws in a single call whatever its skins. Casts sharing
+	// a model folder share the CastModel, and each distinct skin gets one layer.
+	class CastModel
+	{
+	public:
+
+		static constexpr GLsizei SkinSize = 256;
+
+		CastModel() = delete;
+		CastModel(const std::shared_ptr<DynamicModel>& model);
+
+		// Merges the parts the first time a key is seen. Returns nullptr if they can not be merged.
+		static std::shared_ptr<CastModel> Get(const std::string& key, const std::vector<const DynamicModel*>& parts);
+
+		// Copies pending skins into their layers, and again as better mips of a streamed
+		// source arrive. Called once a frame, before the texture streamer.
+		static void Update();
+
+		static size_t GetTotalSkinBytes();
+
+		// Layers are filled by the next Update.
+		int32_t GetSkinLayer(const std::string& name, const std::shared_ptr<Texture2D>& source);
+
+		inline DynamicModel* GetModel() const { return _model.get(); }
+		inline const Texture2DArray* GetSkins() const { return _skins.get(); }
+
+	private:
+
+		struct PendingSkin
+		{
+			std::shared_ptr<Texture2D> source;
+			int32_t layer;
+			uint32_t copiedLevel;
+		};
+
+		bool UpdateSkins();
+		void CopySkin(const Texture2D* source, int32_t layer);
+
+		std::shared_ptr<DynamicModel> _model;
+		std::unique_ptr<Texture2DArray> _skins;
+		std::unordered_map<std::string, int32_t> _skinLayers;
+		std::vector<PendingSkin> _pendingSkins;
+
+		static std::unordered_map<std::string, std::weak_ptr<CastModel>> _castModels;
+		static GLuint _framebuffer;
+		static GLuint _vertexArray;
+	};
+}
@@ -2,6 +2,8 @@
 #include "NormalTable.h"
 #include "Md2Loader.h"
 #include "MdxLoader.h"
+#include "Renderer.h"
+#include <cstddef>
 
 namespace Freeking
 {
@@ -11,6 +13,11 @@ namespace Freeking
 		AddLoader<MDXLoader>();
 	}
 
+	size_t DynamicModelLibrary::GetAssetBytes(const DynamicModel& model) const
+	{
+		return model.GetNumBytes();
+	}
+
 	DynamicModelLibrary DynamicModel::Library;
 
 	const std::unique_ptr<TextureBuffer>& DynamicModel::GetNormalBuffer()
@@ -19,16 +26,23 @@ namespace Freeking
 		return normalBuffer;
 	}
 
-	void DynamicModel::Draw()
+	const std::unique_ptr<VertexBuffer>& DynamicModel::GetInstanceBuffer()
+	{
+		static auto instanceBuffer = std::make_unique<VertexBuffer>(nullptr, MaxInstances + MaxStaticInstances, sizeof(Instance), GL_STREAM_DRAW);
+		return instanceBuffer;
+	}
+
+	void DynamicModel::Draw(size_t lod, size_t firstInstance, size_t numInstances)
 	{
 		_vertexBinding->Bind();
 
-		glDrawElements(GL_TRIANGLES, _vertexBinding->GetNumElements(), GL_UNSIGNED_INT, (void*)0);
+		const auto& range = GetLod(lod);
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, range.numIndices, GL_UNSIGNED_INT, (void*)(range.firstIndex * sizeof(uint32_t)), (GLsizei)numInstances, (GLuint)firstInstance);
 
 		_vertexBinding->Unbind();
 	}
 
-	void DynamicModel::DrawSubObject(int index)
+	void DynamicModel::DrawSubObject(int index, size_t firstInstance, size_t numInstances)
 	{
 		if (index < 0 || index >= SubObjects.size())
 		{
@@ -38,87 +52,246 @@ namespace Freeking
 		_vertexBinding->Bind();
 
 		const auto& subObject = SubObjects.at(index);
-		glDrawElements(GL_TRIANGLES, subObject.numIndices, GL_UNSIGNED_INT, (void*)(subObject.firstIndex * sizeof(uint32_t)));
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, subObject.numIndices, GL_UNSIGNED_INT, (void*)(subObject.firstIndex * sizeof(uint32_t)), (GLsizei)numInstances, (GLuint)firstInstance);
 
 		_vertexBinding->Unbind();
 	}
 
-	void DynamicModel::Commit()
+	size_t DynamicModel::SelectLod(float screenSize, size_t currentLod) const
 	{
-		static const int vertexSize = sizeof(Vertex);
+		size_t lod = 0;
 
-		_indexBuffer = std::make_unique<IndexBuffer>(Indices.data(), Indices.size(), GL_UNSIGNED_INT);
-		_vertexBuffer = std::make_unique<VertexBuffer>(Vertices.data(), Vertices.size(), vertexSize, GL_STATIC_DRAW);
-		_frameVertexBuffer = std::make_unique<TextureBuffer>(FrameVertices.data(), FrameVertices.size() * sizeof(FrameVertex), GL_RGBA8I);
+		while (lod + 1 < Lods.size())
+		{
+			float threshold = LodScreenSizes[lod + 1];
+			float bias = (lod + 1 <= currentLod) ? (1.0f + LodHysteresis) : (1.0f - LodHysteresis);
 
-		ArrayElement vertexLayout[] =
+			if (screenSize >= threshold * bias)
+			{
+				break;
+			}
+
+			lod++;
+		}
+
+		return lod;
+	}
+
+	float DynamicModel::GetScreenSize(const Vector3f& center, float radius)
+	{
+		float distance = center.LengthBetween(Renderer::ViewMatrix.InverseTranslation());
+
+		return (radius * Renderer::ProjectionMatrix[1].y) / Math::Max(distance, 1.0f);
+	}
+
+	DynamicModel::Instance DynamicModel::MakeInstance(const Matrix4x4& modelMatrix, size_t frame, size_t nextFrame, float delta) const
+	{
+		return
 		{
-			ArrayElement(_vertexBuffer.get(), 0, 2, ElementType::Float, vertexSize, 0),
-			ArrayElement(_vertexBuffer.get(), 1, 1, ElementType::Int, vertexSize, 2 * sizeof(float)),
+			modelMatrix,
+			(int32_t)(frame * _frameVertexCount),
+			(int32_t)(nextFrame * _frameVertexCount),
+			(int32_t)(frame * _numParts),
+			(int32_t)(nextFrame * _numParts),
+			{ 0, 0, 0, 0 },
+			delta
 		};
-
-		_vertexBinding = std::make_unique<VertexBinding>();
-		_vertexBinding->Create(vertexLayout, 2, *_indexBuffer, ElementType::UInt);
 	}
 
-	std::vector<FrameAnimation> DynamicModel::GetFrameAnimations() const
+	std::shared_ptr<DynamicModel> DynamicModel::Merge(const std::vector<const DynamicModel*>& parts)
 	{
-		std::vector<FrameAnimation> animations;
+		if (parts.empty() || parts.size() > MaxParts)
+		{
+			return nullptr;
+		}
 
-		std::string currentFrameName = "";
-		size_t currentFrameIndex = 0;
+		uint32_t frameCount = parts[0]->GetFrameCount();
+		uint32_t frameVertexCount = 0;
 
-		for (auto frameTransform : FrameTransforms)
+		for (auto part : parts)
 		{
-			auto indexStart = frameTransform.name.find_last_of('_');
-			auto frameName = frameTransform.name.substr(0, indexStart);
+			if (!part || part->GetFrameCount() < frameCount)
+			{
+				return nullptr;
+			}
+
+			frameVertexCount += part->GetFrameVertexCount();
+		}
+
+		auto model = std::make_shared<DynamicModel>();
+		model->_numParts = (uint32_t)parts.size();
+		model->SetFrameCount(frameCount);
+		model->SetFrameVertexCount(frameVertexCount);
+		model->FrameTransforms = parts[0]->FrameTransforms;
+		model->FrameTransforms.resize(frameCount);
+		model->BuildFrameAnimations();
+		model->FrameVertices.reserve((size_t)frameCount * frameVertexCount);
+		model->_partFrameTransforms.reserve((size_t)frameCount * parts.size());
+
+		for (uint32_t frame = 0; frame < frameCount; ++frame)
+		{
+			for (auto part : parts)
+			{
+				auto first = part->FrameVertices.begin() + ((size_t)frame * part->GetFrameVertexCount());
+				model->FrameVertices.insert(model->FrameVertices.end(), first, first + part->GetFrameVertexCount());
+				model->_partFrameTransforms.push_back(part->FrameTransforms[frame]);
+			}
+		}
+
+		int vertexOffset = 0;
+		size_t numLods = 0;
+		std::vector<uint32_t> firstVertices;
+
+		for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex)
+		{
+			auto part = parts[partIndex];
+			auto firstIndex = (uint32_t)model->Indices.size();
+			auto firstVertex = (uint32_t)model->Vertices.size();
+			firstVertices.push_back(firstVertex);
+			numLods = std::max(numLods, part->GetNumLods());
+
+			for (auto vertex : part->Vertices)
+			{
+				vertex.VertexIndex += vertexOffset;
+				vertex.Part = (int)partIndex;
+				model->Vertices.push_back(vertex);
+			}
+
+			const auto& lod = part->GetLod(0);
+			for (uint32_t i = 0; i < lod.numIndices; ++i)
+			{
+				model->Indices.push_back(part->Indices[lod.firstIndex + i] + firstVertex);
+			}
 
-			if (currentFrameName != frameName)
+			for (auto subObject : part->SubObjects)
 			{
-				currentFrameName = frameName;
-				animations.push_back({ frameName, currentFrameIndex, 0 });
+				subObject.firstIndex += firstIndex;
+				model->SubObjects.push_back(subObject);
 			}
 
-			auto& animFrameIndex = animations.back();
-			animFrameIndex.numFrames += 1;
+			model->FrameBounds.insert(model->FrameBounds.end(), part->FrameBounds.begin(), part->FrameBounds.end());
+			model->_boundsParts.insert(model->_boundsParts.end(), part->FrameBounds.size(), (uint32_t)partIndex);
+			model->Skins.insert(model->Skins.end(), part->Skins.begin(), part->Skins.end());
 
-			currentFrameIndex++;
+			vertexOffset += part->GetFrameVertexCount();
 		}
 
-		return animations;
+		model->Lods.push_back({ 0, (uint32_t)model->Indices.size() });
+
+		// Each merged LOD takes the same LOD of every part, or the coarsest one a part has.
+		for (size_t lodIndex = 1; lodIndex < numLods; ++lodIndex)
+		{
+			auto firstIndex = (uint32_t)model->Indices.size();
+
+			for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex)
+			{
+				auto part = parts[partIndex];
+				const auto& lod = part->GetLod(lodIndex);
+
+				for (uint32_t i = 0; i < lod.numIndices; ++i)
+				{
+					model->Indices.push_back(part->Indices[lod.firstIndex + i] + firstVertices[partIndex]);
+				}
+			}
+
+			model->Lods.push_back({ firstIndex, (uint32_t)model->Indices.size() - firstIndex });
+		}
+
+		model->Commit();
+
+		return model;
+	}
+
+	void DynamicModel::Commit()
+	{
+		if (Lods.empty())
+		{
+			Lods.push_back({ 0, (uint32_t)Indices.size() });
+		}
+
+		static const int vertexSize = sizeof(Vertex);
+		static const int instanceSize = sizeof(Instance);
+
+		_indexBuffer = std::make_unique<IndexBuffer>(Indices.data(), Indices.size(), GL_UNSIGNED_INT);
+		_vertexBuffer = std::make_unique<VertexBuffer>(Vertices.data(), Vertices.size(), vertexSize, GL_STATIC_DRAW);
+		_frameVertexBuffer = std::make_unique<TextureBuffer>(FrameVertices.data(), FrameVertices.size() * sizeof(FrameVertex), GL_RGBA8I);
+
+		// Two texels per frame and part, the translate then the scale.
+		const auto& frameTransforms = _partFrameTransforms.empty() ? FrameTransforms : _partFrameTransforms;
+		std::vector<Vector3f> transformData;
+		transformData.reserve(frameTransforms.size() * 2);
+
+		for (const auto& frameTransform : frameTransforms)
+		{
+			transformData.push_back(frameTransform.translate);
+			transformData.push_back(frameTransform.scale);
+		}
+
+		_frameTransformBuffer = std::make_unique<TextureBuffer>(transformData.data(), transformData.size() * sizeof(Vector3f), GL_RGB32F);
+
+		auto instanceBuffer = GetInstanceBuffer().get();
+
+		ArrayElement vertexLayout[] =
+		{
+			ArrayElement(_vertexBuffer.get(), 0, 2, ElementType::Float, vertexSize, 0),
+			ArrayElement(_vertexBuffer.get(), 1, 1, ElementType::Int, vertexSize, offsetof(Vertex, VertexIndex)),
+			ArrayElement(_vertexBuffer.get(), 2, 1, ElementType::Int, vertexSize, offsetof(Vertex, Part)),
+			ArrayElement(instanceBuffer, 3, 4, ElementType::Float, instanceSize, offsetof(Instance, modelMatrix) + 0 * sizeof(Vector4f), 1),
+			ArrayElement(instanceBuffer, 4, 4, ElementType::Float, instanceSize, offsetof(Instance, modelMatrix) + 1 * sizeof(Vector4f), 1),
+			ArrayElement(instanceBuffer, 5, 4, ElementType::Float, instanceSize, offsetof(Instance, modelMatrix) + 2 * sizeof(Vector4f), 1),
+			ArrayElement(instanceBuffer, 6, 4, ElementType::Float, instanceSize, offsetof(Instance, modelMatrix) + 3 * sizeof(Vector4f), 1),
+			ArrayElement(instanceBuffer, 7, 4, ElementType::Int, instanceSize, offsetof(Instance, frameIndex), 1),
+			ArrayElement(instanceBuffer, 8, 4, ElementType::Int, instanceSize, offsetof(Instance, skinLayers), 1),
+			ArrayElement(instanceBuffer, 9, 1, ElementType::Float, instanceSize, offsetof(Instance, delta), 1),
+		};
+
+		_vertexBinding = std::make_unique<VertexBinding>();
+		_vertexBinding->Create(vertexLayout, 10, *_indexBuffer, ElementType::UInt);
+	}
+
+	size_t DynamicModel::GetNumBytes() const
+	{
+		size_t vertexBytes =
+			(Vertices.size() * sizeof(Vertex)) +
+			(Indices.size() * sizeof(uint32_t)) +
+			(FrameVertices.size() * sizeof(FrameVertex)) +
+			(_partFrameTransforms.size() * sizeof(FrameTransform));
+
+		return vertexBytes * 2;
 	}
 
 	FrameAnimator::FrameAnimator() :
-		_playTime(0),
-		_frame(0),
-		_nextFrame(0),
-		_frameDelta(0),
+		_slot(AnimationScheduler::Allocate()),
 		_currentAnimation(0)
 	{
 	}
 
-	void FrameAnimator::Tick(double dt)
+	FrameAnimator::~FrameAnimator()
 	{
-		const auto& animation = _animations.at(_currentAnimation);
-		auto frameCount = animation.numFrames;
-
-		_playTime += (10.0 * dt);
-		_playTime = fmod(_playTime, (float)frameCount);
+		AnimationScheduler::Release(_slot);
+	}
 
-		_frame = (size_t)floor(_playTime);
-		_frame %= frameCount;
-		_nextFrame = (_frame + 1) % frameCount;
-		_frameDelta = (float)_playTime - (float)_frame;
+	void FrameAnimator::Tick(double dt)
+	{
+		auto& state = GetState();
+		if (state.numFrames == 0)
+		{
+			return;
+		}
 
-		_frame += animation.firstFrame;
-		_nextFrame += animation.firstFrame;
-		_frameDelta = Math::Clamp(_frameDelta, 0.0f, 1.0f);
+		AnimationScheduler::AdvanceClock(state, dt);
+		AnimationScheduler::Evaluate(state);
 	}
 
 	void FrameAnimator::AddAnimation(const std::string& name, size_t firstFrame, size_t numFrames)
 	{
 		_animationNameIds.insert({ name, (int)_animations.size() });
 		_animations.push_back({ name, firstFrame, numFrames });
+
+		if (_animations.size() - 1 == _currentAnimation)
+		{
+			ApplyAnimation();
+		}
 	}
 
 	void FrameAnimator::SetAnimation(const std::string& name)
@@ -132,9 +305,51 @@ namespace Freeking
 	void FrameAnimator::SetAnimation(size_t index)
 	{
 		_currentAnimation = index;
-		_playTime = 0;
-		_frame = 0;
-		_nextFrame = 0;
-		_frameDelta = 0;
+		ApplyAnimation();
+	}
+
+	void FrameAnimator::ApplyAnimation()
+	{
+		auto& state = GetState();
+		state.playTime = 0;
+		state.delta = 0;
+
+		// The index may be set before the animations are added.
+		if (_currentAnimation < _animations.size())
+		{
+			const auto& animation = _animations[_currentAnimation];
+			state.firstFrame = (uint32_t)animation.firstFrame;
+			state.numFrames = (uint32_t)animation.numFrames;
+		}
+		else
+		{
+			state.firstFrame = 0;
+			state.numFrames = 0;
+		}
+
+		state.frame = state.firstFrame;
+		state.nextFrame = state.firstFrame;
+		state.stale = true;
+	}
+
+	void FrameAnimator::SetScheduled(bool scheduled)
+	{
+		GetState().scheduled = scheduled;
+	}
+
+	void FrameAnimator::SetBounds(const Vector3f& center, float radius, bool hidden)
+	{
+		auto& state = GetState();
+		state.center = center;
+		state.radius = radius;
+		state.hidden = hidden;
+	}
+
+	void FrameAnimator::Resolve()
+	{
+		if (auto& state = GetState(); state.stale)
+		{
+			AnimationScheduler::Evaluate(state);
+		}
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AssetLibrary.h"
+#include "DynamicModelData.h"
 #include "Vector.h"
 #include "VertexBinding.h"
 #include "VertexBuffer.h"
@@ -9,47 +10,56 @@
 #include "Texture2D.h"
 #include "Shader.h"
 #include "Util.h"
+#include "Matrix4x4.h"
+#include "AnimationScheduler.h"
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <array>
+#include <algorithm>
 
 namespace Freeking
 {
 	class DynamicModel;
 
-	struct FrameAnimation
-	{
-		std::string name;
-		size_t firstFrame;
-		size_t numFrames;
-	};
-
+	// The playback state lives in the AnimationScheduler. Scheduled animators are advanced
+	// by its batched pass and report their bounds each tick. Others are driven by Tick.
 	class FrameAnimator
 	{
 	public:
 
 		FrameAnimator();
+		~FrameAnimator();
+
+		FrameAnimator(const FrameAnimator&) = delete;
+		FrameAnimator& operator=(const FrameAnimator&) = delete;
 
 		void Tick(double dt);
 		void AddAnimation(const std::string& name, size_t firstFrame, size_t numFrames);
 		void SetAnimation(size_t index);
 		void SetAnimation(const std::string& name);
 
-		inline double GetPlayTime() const { return _playTime; }
-		inline size_t GetFrame() const { return _frame; }
-		inline size_t GetNextFrame() const { return _nextFrame; }
-		inline float GetFrameDelta() const { return _frameDelta; }
+		void SetScheduled(bool scheduled);
+		void SetBounds(const Vector3f& center, float radius, bool hidden);
+
+		// Brings the pose up to date if it went stale while out of view.
+		void Resolve();
+
+		inline double GetPlayTime() const { return GetState().playTime; }
+		inline size_t GetFrame() const { return GetState().frame; }
+		inline size_t GetNextFrame() const { return GetState().nextFrame; }
+		inline float GetFrameDelta() const { return GetState().delta; }
 		inline size_t GetCurrentAnimation() const { return _currentAnimation; }
 
 	private:
 
+		inline AnimationState& GetState() const { return AnimationScheduler::GetState(_slot); }
+		void ApplyAnimation();
+
 		std::unordered_map<std::string, int> _animationNameIds;
 		std::vector<FrameAnimation> _animations;
 
-		double _playTime;
-		size_t _frame;
-		size_t _nextFrame;
-		float _frameDelta;
+		uint32_t _slot;
 		size_t _currentAnimation;
 	};
 
@@ -58,74 +68,79 @@ namespace Freeking
 	protected:
 
 		virtual void UpdateLoaders() override;
+		virtual size_t GetAssetBytes(const DynamicModel& model) const override;
 	};
 
-	class DynamicModel
+	class DynamicModel : public DynamicModelData
 	{
 	public:
 
 		static DynamicModelLibrary Library;
 
-		struct Vertex
-		{
-			Vector2f UV;
-			int VertexIndex;
-		};
-
-		struct FrameVertex
+		// Per-instance attributes, read from the shared instance buffer. Frame indices are
+		// the offsets of the two frames being blended in the frame vertex buffer, and
+		// transform indices the first entry of each frame in the frame transform buffer.
+		// Skin layers select the texture array layer of each part.
+		struct Instance
 		{
-			int8_t x, y, z, n;
+			Matrix4x4 modelMatrix;
+			int32_t frameIndex;
+			int32_t nextFrameIndex;
+			int32_t transformIndex;
+			int32_t nextTransformIndex;
+			std::array<int32_t, 4> skinLayers;
+			float delta;
 		};
 
-		struct FrameTransform
-		{
-			std::string name;
-			Vector3f translate;
-			Vector3f scale;
-		};
+		// The instance buffer holds MaxInstances per-frame instances, followed by the range
+		// the StaticModelBatch keeps its instances in between rebuilds.
+		static constexpr size_t MaxInstances = 4096;
+		static constexpr size_t MaxStaticInstances = 4096;
+		static constexpr size_t MaxParts = 4;
+
+		// LOD i is used below LodScreenSizes[i] of the viewport height. Switching back to a
+		// finer LOD needs the model to grow past the threshold by the hysteresis, so models
+		// near a threshold do not flicker between LODs.
+		static constexpr std::array<float, MaxLods> LodScreenSizes = { 0.0f, 0.25f, 0.1f };
+		static constexpr float LodHysteresis = 0.15f;
+
+		// Concatenates models that animate together, such as the head, body and legs of a
+		// cast, into one model that draws them in a single call. Frames are taken from the
+		// first part and every part must have at least as many.
+		static std::shared_ptr<DynamicModel> Merge(const std::vector<const DynamicModel*>& parts);
+
+		void Draw(size_t lod, size_t firstInstance, size_t numInstances);
+		void DrawSubObject(int index, size_t firstInstance, size_t numInstances);
+		void Commit();
 
-		struct FrameBoundingBox
-		{
-			Vector3f boundsMin;
-			Vector3f boundsMax;
-		};
+		size_t SelectLod(float screenSize, size_t currentLod) const;
 
-		struct SubObject
-		{
-			int firstIndex;
-			int numIndices;
-		};
+		// The fraction of the viewport height covered by a sphere.
+		static float GetScreenSize(const Vector3f& center, float radius);
 
-		void Draw();
-		void DrawSubObject(int index);
-		void Commit();
+		Instance MakeInstance(const Matrix4x4& modelMatrix, size_t frame, size_t nextFrame, float delta) const;
 
-		inline uint32_t GetFrameCount() const { return _frameCount; }
-		inline uint32_t GetFrameVertexCount() const { return _frameVertexCount; }
-		inline void SetFrameCount(uint32_t frameCount) { _frameCount = frameCount; }
-		inline void SetFrameVertexCount(uint32_t frameVertexCount) { _frameVertexCount = frameVertexCount; }
+		inline uint32_t GetNumParts() const { return _numParts; }
+		inline uint32_t GetBoundsPart(size_t boundsIndex) const { return _boundsParts.empty() ? 0 : _boundsParts[boundsIndex]; }
 
 		inline const std::unique_ptr<VertexBinding>& GetBinding() const { return _vertexBinding; }
 		inline const std::shared_ptr<TextureBuffer>& GetFrameVertexBuffer() const { return _frameVertexBuffer; }
+		inline const std::unique_ptr<TextureBuffer>& GetFrameTransformBuffer() const { return _frameTransformBuffer; }
 		static const std::unique_ptr<TextureBuffer>& GetNormalBuffer();
+		static const std::unique_ptr<VertexBuffer>& GetInstanceBuffer();
 
-		std::vector<FrameAnimation> GetFrameAnimations() const;
-
-		std::vector<Vertex> Vertices;
-		std::vector<uint32_t> Indices;
-		std::vector<FrameVertex> FrameVertices;
-		std::vector<FrameTransform> FrameTransforms;
-		std::vector<std::vector<FrameBoundingBox>> FrameBounds;
-		std::vector<std::string> Skins;
-		std::vector<SubObject> SubObjects;
+		// The vertex data stays in memory after Commit, so it is counted for both copies.
+		size_t GetNumBytes() const;
 
 	private:
 
-		uint32_t _frameCount;
-		uint32_t _frameVertexCount;
+		uint32_t _numParts = 1;
+		std::vector<FrameTransform> _partFrameTransforms;
+		std::vector<uint32_t> _boundsParts;
 		std::unique_ptr<VertexBinding> _vertexBinding;
 		std::unique_ptr<VertexBuffer> _vertexBuffer;
 		std::unique_ptr<IndexBuffer> _indexBuffer;
 		std::shared_ptr<TextureBuffer> _frameVertexBuffer;
+		std::unique_ptr<TextureBuffer> _frameTransformBuffer;
 	};
 }
@@ -0,0 +1,130 @@
+#include "DynamicModelBatch.h"
+#include "Shader.h"
+#include "Texture2D.h"
+#include "Texture2DArray.h"
+#include <algorithm>
+
+namespace Freeking
+{
+	DynamicModelBatch::DynamicModelBatch() :
+		_numInstances(0),
+		_numDrawCalls(0),
+		_numTriangles(0)
+	{
+	}
+
+	void DynamicModelBatch::Add(DynamicModel* model, Texture2D* skin, const Matrix4x4& modelMatrix, size_t frame, size_t nextFrame, float delta, size_t lod)
+	{
+		if (!model || !skin)
+		{
+			return;
+		}
+
+		_draws.push_back({ model, lod, skin, nullptr, model->MakeInstance(modelMatrix, frame, nextFrame, delta) });
+	}
+
+	void DynamicModelBatch::Add(DynamicModel* model, const Texture2DArray* skins, const std::array<int32_t, 4>& skinLayers, const Matrix4x4& modelMatrix, size_t frame, size_t nextFrame, float delta, size_t lod)
+	{
+		if (!model || !skins)
+		{
+			return;
+		}
+
+		auto instance = model->MakeInstance(modelMatrix, frame, nextFrame, delta);
+		instance.skinLayers = skinLayers;
+
+		_draws.push_back({ model, lod, nullptr, skins, instance });
+	}
+
+	void DynamicModelBatch::Flush(Shader* shader)
+	{
+		_numInstances = _draws.size();
+		_numDrawCalls = 0;
+		_numTriangles = 0;
+
+		if (_draws.empty())
+		{
+			return;
+		}
+
+		std::stable_sort(_draws.begin(), _draws.end(), [](const Draw& a, const Draw& b)
+		{
+			if (a.model != b.model)
+			{
+				return a.model < b.model;
+			}
+
+			if (a.lod != b.lod)
+			{
+				return a.lod < b.lod;
+			}
+
+			return (a.skin != b.skin) ? (a.skin < b.skin) : (a.skinArray < b.skinArray);
+		});
+
+		static const Name normalBufferName("normalBuffer");
+		static const Name diffuseName("diffuse");
+		static const Name diffuseArrayName("diffuseArray");
+		static const Name useDiffuseArrayName("useDiffuseArray");
+		static const Name frameVertexBufferName("frameVertexBuffer");
+		static const Name frameTransformBufferName("frameTransformBuffer");
+
+		shader->Bind();
+		shader->SetParameterValue(normalBufferName, DynamicModel::GetNormalBuffer().get());
+
+		int diffuseId = shader->GetTextureParameterId(diffuseName);
+		int diffuseArrayId = shader->GetTextureParameterId(diffuseArrayName);
+		int useDiffuseArrayId = shader->GetIntParameterId(useDiffuseArrayName);
+		int frameVertexBufferId = shader->GetTextureParameterId(frameVertexBufferName);
+		int frameTransformBufferId = shader->GetTextureParameterId(frameTransformBufferName);
+		const auto& instanceBuffer = DynamicModel::GetInstanceBuffer();
+
+		for (size_t first = 0; first < _draws.size(); first += DynamicModel::MaxInstances)
+		{
+			size_t count = std::min(_draws.size() - first, DynamicModel::MaxInstances);
+
+			_instances.resize(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				_instances[i] = _draws[first + i].instance;
+			}
+
+			instanceBuffer->UpdateBuffer(_instances.data(), 0, count * sizeof(DynamicModel::Instance));
+
+			for (size_t i = 0; i < count;)
+			{
+				const auto& draw = _draws[first + i];
+
+				size_t end = i + 1;
+				while (end < count &&
+					_draws[first + end].model == draw.model &&
+					_draws[first + end].lod == draw.lod &&
+					_draws[first + end].skin == draw.skin &&
+					_draws[first + end].skinArray == draw.skinArray)
+				{
+					end++;
+				}
+
+				if (draw.skinArray)
+				{
+					shader->SetParameterValue(diffuseArrayId, draw.skinArray, nullptr);
+				}
+				else
+				{
+					shader->SetParameterValue(diffuseId, draw.skin);
+				}
+
+				shader->SetParameterValue(useDiffuseArrayId, draw.skinArray ? 1 : 0);
+				shader->SetParameterValue(frameVertexBufferId, draw.model->GetFrameVertexBuffer().get());
+				shader->SetParameterValue(frameTransformBufferId, draw.model->GetFrameTransformBuffer().get());
+				draw.model->Draw(draw.lod, i, end - i);
+
+				_numDrawCalls++;
+				_numTriangles += (draw.model->GetLod(draw.lod).numIndices / 3) * (end - i);
+				i = end;
+			}
+		}
+
+		_draws.clear();
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "DynamicModel.h"
+#include <vector>
+#include <array>
+
+namespace Freeking
+{
+	class Shader;
+	class Texture2D;
+	class Texture2DArray;
+
+	// Collects dynamic model draws for a pass and issues one instanced draw for each model
+	// and skin. Transforms and animation frames go through the shared instance buffer, so
+	// the only uniforms set per draw are the skin and the frame buffers.
+	class DynamicModelBatch
+	{
+	public:
+
+		DynamicModelBatch();
+
+		void Add(DynamicModel* model, Texture2D* skin, const Matrix4x4& modelMatrix, size_t frame, size_t nextFrame, float delta, size_t lod = 0);
+
+		// Merged models sample each part's skin from a layer of a texture array.
+		void Add(DynamicModel* model, const Texture2DArray* skins, const std::array<int32_t, 4>& skinLayers, const Matrix4x4& modelMatrix, size_t frame, size_t nextFrame, float delta, size_t lod = 0);
+
+		// Binds the shader and draws everything added since the last flush. Parameters
+		// shared by every instance, such as the cubemap, can be set on the shader first.
+		void Flush(Shader* shader);
+
+		inline size_t GetNumInstances() const { return _numInstances; }
+		inline size_t GetNumDrawCalls() const { return _numDrawCalls; }
+		inline size_t GetNumTriangles() const { return _numTriangles; }
+
+	private:
+
+		struct Draw
+		{
+			DynamicModel* model;
+			size_t lod;
+			Texture2D* skin;
+			const Texture2DArray* skinArray;
+			DynamicModel::Instance instance;
+		};
+
+		std::vector<Draw> _draws;
+		std::vector<DynamicModel::Instance> _instances;
+		size_t _numInstances;
+		size_t _numDrawCalls;
+		size_t _numTriangles;
+	};
+}
@@ -0,0 +1,343 @@
+#include "DynamicModelData.h"
+#include "ModelSimplifier.h"
+#include "CookedModelFile.h"
+#include "BinaryReader.h"
+#include <string_view>
+#include <type_traits>
+#include <cstring>
+
+namespace Freeking
+{
+	namespace
+	{
+		template <typename T>
+		void WriteRecords(std::vector<uint8_t>& data, const T* values, size_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable records can be written");
+
+			if (count == 0)
+			{
+				return;
+			}
+
+			auto bytes = reinterpret_cast<const uint8_t*>(values);
+			data.insert(data.end(), bytes, bytes + (count * sizeof(T)));
+		}
+
+		template <typename T>
+		void WriteRecord(std::vector<uint8_t>& data, const T& value)
+		{
+			WriteRecords(data, &value, 1);
+		}
+
+		template <typename T>
+		bool ReadRecords(BinaryReader& reader, std::vector<T>& values, size_t count)
+		{
+			if (count > reader.Remaining() / sizeof(T))
+			{
+				return false;
+			}
+
+			values.resize(count);
+
+			return count == 0 || reader.ReadBytes(values.data(), count * sizeof(T));
+		}
+
+		template <size_t N>
+		std::array<char, N> MakeName(const std::string& name)
+		{
+			std::array<char, N> result = {};
+			std::memcpy(result.data(), name.data(), std::min(name.size(), N));
+
+			return result;
+		}
+
+		template <size_t N>
+		std::string ReadName(const std::array<char, N>& name)
+		{
+			return std::string(name.data(), strnlen(name.data(), N));
+		}
+	}
+
+	void DynamicModelData::GenerateLods()
+	{
+		Lods.clear();
+		Lods.push_back({ 0, (uint32_t)Indices.size() });
+
+		size_t numTriangles = Indices.size() / 3;
+		std::vector<size_t> targetTriangleCounts;
+
+		for (size_t lod = 1; lod < MaxLods; ++lod)
+		{
+			targetTriangleCounts.push_back(numTriangles >> lod);
+		}
+
+		for (auto& indices : ModelSimplifier::Simplify(*this, targetTriangleCounts))
+		{
+			Lods.push_back({ (uint32_t)Indices.size(), (uint32_t)indices.size() });
+			Indices.insert(Indices.end(), indices.begin(), indices.end());
+		}
+	}
+
+	void DynamicModelData::BuildFrameAnimations()
+	{
+		_frameAnimations.clear();
+
+		std::string_view currentName;
+		bool first = true;
+
+		for (size_t frameIndex = 0; frameIndex < FrameTransforms.size(); ++frameIndex)
+		{
+			std::string_view frameName(FrameTransforms[frameIndex].name);
+			frameName = frameName.substr(0, frameName.find_last_of('_'));
+
+			if (first || frameName != currentName)
+			{
+				currentName = frameName;
+				first = false;
+				_frameAnimations.push_back({ std::string(frameName), frameIndex, 0 });
+			}
+
+			_frameAnimations.back().numFrames++;
+		}
+	}
+
+	std::vector<uint8_t> DynamicModelData::WriteCooked() const
+	{
+		if (FrameTransforms.size() != _frameCount || FrameVertices.size() != (size_t)_frameCount * _frameVertexCount)
+		{
+			return {};
+		}
+
+		for (const auto& subObjectBounds : FrameBounds)
+		{
+			if (subObjectBounds.size() != _frameCount)
+			{
+				return {};
+			}
+		}
+
+		CookedModelHeader header =
+		{
+			CookedModelFile::Ident,
+			CookedModelFile::Version,
+			(uint32_t)Vertices.size(),
+			(uint32_t)Indices.size(),
+			_frameCount,
+			_frameVertexCount,
+			(uint32_t)Skins.size(),
+			(uint32_t)SubObjects.size(),
+			(uint32_t)FrameBounds.size(),
+			(uint32_t)Lods.size(),
+			(uint32_t)_frameAnimations.size()
+		};
+
+		std::vector<uint8_t> data;
+		data.reserve(sizeof(header) +
+			(Vertices.size() * sizeof(CookedModelVertex)) +
+			(Indices.size() * sizeof(uint32_t)) +
+			(FrameTransforms.size() * sizeof(CookedModelFrame)) +
+			(FrameVertices.size() * sizeof(FrameVertex)) +
+			(Skins.size() * CookedModelFile::SkinPathLength) +
+			(SubObjects.size() * sizeof(SubObject)) +
+			(FrameBounds.size() * _frameCount * sizeof(CookedModelBounds)) +
+			(Lods.size() * sizeof(Lod)) +
+			(_frameAnimations.size() * sizeof(CookedModelAnimation)));
+
+		WriteRecord(data, header);
+
+		for (const auto& vertex : Vertices)
+		{
+			WriteRecord(data, CookedModelVertex{ vertex.UV.x, vertex.UV.y, vertex.VertexIndex });
+		}
+
+		WriteRecords(data, Indices.data(), Indices.size());
+
+		for (const auto& frame : FrameTransforms)
+		{
+			WriteRecord(data, CookedModelFrame
+				{
+					MakeName<16>(frame.name),
+					{ frame.translate.x, frame.translate.y, frame.translate.z },
+					{ frame.scale.x, frame.scale.y, frame.scale.z }
+				});
+		}
+
+		WriteRecords(data, FrameVertices.data(), FrameVertices.size());
+
+		for (const auto& skin : Skins)
+		{
+			WriteRecord(data, MakeName<CookedModelFile::SkinPathLength>(skin));
+		}
+
+		WriteRecords(data, SubObjects.data(), SubObjects.size());
+
+		for (const auto& subObjectBounds : FrameBounds)
+		{
+			for (const auto& bounds : subObjectBounds)
+			{
+				WriteRecord(data, CookedModelBounds
+					{
+						{ bounds.boundsMin.x, bounds.boundsMin.y, bounds.boundsMin.z },
+						{ bounds.boundsMax.x, bounds.boundsMax.y, bounds.boundsMax.z }
+					});
+			}
+		}
+
+		WriteRecords(data, Lods.data(), Lods.size());
+
+		for (const auto& animation : _frameAnimations)
+		{
+			WriteRecord(data, CookedModelAnimation{ MakeName<16>(animation.name), (uint32_t)animation.firstFrame, (uint32_t)animation.numFrames });
+		}
+
+		return data;
+	}
+
+	bool DynamicModelData::ReadCooked(const uint8_t* data, size_t size)
+	{
+		BinaryReader reader(data, size);
+
+		CookedModelHeader header;
+		if (!reader.Read(header) || header.Ident != CookedModelFile::Ident || header.Version != CookedModelFile::Version)
+		{
+			return false;
+		}
+
+		if (header.NumLods == 0 || header.NumLods > MaxLods)
+		{
+			return false;
+		}
+
+		if (header.NumVertices > reader.Remaining() / sizeof(CookedModelVertex))
+		{
+			return false;
+		}
+
+		Vertices.resize(header.NumVertices);
+
+		for (auto& vertex : Vertices)
+		{
+			auto cookedVertex = reader.Read<CookedModelVertex>();
+			if (cookedVertex.VertexIndex < 0 || (uint32_t)cookedVertex.VertexIndex >= header.NumFrameVertices)
+			{
+				return false;
+			}
+
+			vertex = { Vector2f(cookedVertex.U, cookedVertex.V), cookedVertex.VertexIndex, 0 };
+		}
+
+		if (!ReadRecords(reader, Indices, header.NumIndices))
+		{
+			return false;
+		}
+
+		for (auto index : Indices)
+		{
+			if (index >= header.NumVertices)
+			{
+				return false;
+			}
+		}
+
+		if (header.NumFrames > reader.Remaining() / sizeof(CookedModelFrame))
+		{
+			return false;
+		}
+
+		FrameTransforms.resize(header.NumFrames);
+
+		for (auto& frame : FrameTransforms)
+		{
+			auto cookedFrame = reader.Read<CookedModelFrame>();
+			frame.name = ReadName(cookedFrame.Name);
+			frame.translate = Vector3f(cookedFrame.Translate[0], cookedFrame.Translate[1], cookedFrame.Translate[2]);
+			frame.scale = Vector3f(cookedFrame.Scale[0], cookedFrame.Scale[1], cookedFrame.Scale[2]);
+		}
+
+		if (!ReadRecords(reader, FrameVertices, (size_t)header.NumFrames * header.NumFrameVertices))
+		{
+			return false;
+		}
+
+		if (header.NumSkins > reader.Remaining() / CookedModelFile::SkinPathLength)
+		{
+			return false;
+		}
+
+		Skins.resize(header.NumSkins);
+
+		for (auto& skin : Skins)
+		{
+			skin = reader.ReadString(CookedModelFile::SkinPathLength);
+		}
+
+		if (!ReadRecords(reader, SubObjects, header.NumSubObjects))
+		{
+			return false;
+		}
+
+		for (const auto& subObject : SubObjects)
+		{
+			if (subObject.firstIndex < 0 || subObject.numIndices < 0 || (size_t)subObject.firstIndex + subObject.numIndices > header.NumIndices)
+			{
+				return false;
+			}
+		}
+
+		if ((size_t)header.NumBoundsSubObjects * header.NumFrames > reader.Remaining() / sizeof(CookedModelBounds))
+		{
+			return false;
+		}
+
+		FrameBounds.resize(header.NumBoundsSubObjects);
+
+		for (auto& subObjectBounds : FrameBounds)
+		{
+			subObjectBounds.resize(header.NumFrames);
+
+			for (auto& bounds : subObjectBounds)
+			{
+				auto cookedBounds = reader.Read<CookedModelBounds>();
+				bounds.boundsMin = Vector3f(cookedBounds.Min[0], cookedBounds.Min[1], cookedBounds.Min[2]);
+				bounds.boundsMax = Vector3f(cookedBounds.Max[0], cookedBounds.Max[1], cookedBounds.Max[2]);
+			}
+		}
+
+		if (!ReadRecords(reader, Lods, header.NumLods))
+		{
+			return false;
+		}
+
+		for (const auto& lod : Lods)
+		{
+			if ((size_t)lod.firstIndex + lod.numIndices > header.NumIndices || (lod.numIndices % 3) != 0)
+			{
+				return false;
+			}
+		}
+
+		if (header.NumAnimations > reader.Remaining() / sizeof(CookedModelAnimation))
+		{
+			return false;
+		}
+
+		_frameAnimations.resize(header.NumAnimations);
+
+		for (auto& animation : _frameAnimations)
+		{
+			auto cookedAnimation = reader.Read<CookedModelAnimation>();
+			if ((size_t)cookedAnimation.FirstFrame + cookedAnimation.NumFrames > header.NumFrames)
+			{
+				return false;
+			}
+
+			animation = { ReadName(cookedAnimation.Name), cookedAnimation.FirstFrame, cookedAnimation.NumFrames };
+		}
+
+		_frameCount = header.NumFrames;
+		_frameVertexCount = header.NumFrameVertices;
+
+		return (bool)reader;
+	}
+}
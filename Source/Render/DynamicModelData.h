@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Vector.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+namespace Freeking
+{
+	struct FrameAnimation
+	{
+		std::string name;
+		size_t firstFrame;
+		size_t numFrames;
+	};
+
+	// The CPU side of a dynamic model, with no GL state, so the cook tool can build and
+	// serialise models with the same code the game loads them with.
+	class DynamicModelData
+	{
+	public:
+
+		// Part is the index of the source model in a merged model, and selects the skin
+		// layer and frame transforms the vertex uses.
+		struct Vertex
+		{
+			Vector2f UV;
+			int VertexIndex;
+			int Part;
+		};
+
+		struct FrameVertex
+		{
+			int8_t x, y, z, n;
+		};
+
+		struct FrameTransform
+		{
+			std::string name;
+			Vector3f translate;
+			Vector3f scale;
+		};
+
+		struct FrameBoundingBox
+		{
+			Vector3f boundsMin;
+			Vector3f boundsMax;
+		};
+
+		struct SubObject
+		{
+			int firstIndex;
+			int numIndices;
+		};
+
+		// A range of Indices. LOD 0 is the full model and the others are simplified copies
+		// of it that reuse its vertices.
+		struct Lod
+		{
+			uint32_t firstIndex;
+			uint32_t numIndices;
+		};
+
+		static constexpr size_t MaxLods = 3;
+
+		// Appends simplified LODs to Indices.
+		void GenerateLods();
+
+		// Groups frames into animations by name, "run_01" and "run_02" into "run". Loaders
+		// call this once, after the frame transforms are read.
+		void BuildFrameAnimations();
+
+		// Serialises the model as a cooked ".fkmdl" file, built LODs and animations included.
+		std::vector<uint8_t> WriteCooked() const;
+		bool ReadCooked(const uint8_t* data, size_t size);
+
+		inline const std::vector<FrameAnimation>& GetFrameAnimations() const { return _frameAnimations; }
+		inline size_t GetNumLods() const { return Lods.size(); }
+		inline const Lod& GetLod(size_t lod) const { return Lods[std::min(lod, Lods.size() - 1)]; }
+
+		inline uint32_t GetFrameCount() const { return _frameCount; }
+		inline uint32_t GetFrameVertexCount() const { return _frameVertexCount; }
+		inline void SetFrameCount(uint32_t frameCount) { _frameCount = frameCount; }
+		inline void SetFrameVertexCount(uint32_t frameVertexCount) { _frameVertexCount = frameVertexCount; }
+
+		std::vector<Vertex> Vertices;
+		std::vector<uint32_t> Indices;
+		std::vector<FrameVertex> FrameVertices;
+		std::vector<FrameTransform> FrameTransforms;
+		std::vector<std::vector<FrameBoundingBox>> FrameBounds;
+		std::vector<std::string> Skins;
+		std::vector<SubObject> SubObjects;
+		std::vector<Lod> Lods;
+
+	protected:
+
+		uint32_t _frameCount = 0;
+		uint32_t _frameVertexCount = 0;
+		std::vector<FrameAnimation> _frameAnimations;
+	};
+}
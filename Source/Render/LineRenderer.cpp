@@ -1,28 +1,38 @@
 #include "LineRenderer.h"
 #include "Shader.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Freeking
 {
 	std::shared_ptr<LineRenderer> LineRenderer::Debug = nullptr;
 
-	LineRenderer::LineRenderer(size_t maxVertexCount) :
-		_maxVertexCount(maxVertexCount),
-		_vertexCount(0)
+	LineRenderer::LineRenderer() :
+		_vertexCount(0),
+		_bindingGeneration(0)
 	{
-		_buffer.resize(VertexSize * _maxVertexCount, 0);
+		_vertexBinding = std::make_unique<VertexBinding>();
+
+		_shader = Shader::Library.Get("Shaders/DebugLine.shader");
+	}
+
+	void LineRenderer::UpdateBinding()
+	{
+		if (_bindingGeneration == StreamingBuffer::GetGeneration())
+		{
+			return;
+		}
 
-		_vertexBuffer = std::make_unique<VertexBuffer>(nullptr, _maxVertexCount, VertexSize, GL_DYNAMIC_DRAW);
+		auto vertexBuffer = StreamingBuffer::GetVertexBuffer();
 
 		ArrayElement vertexLayout[] =
 		{
-			ArrayElement(_vertexBuffer.get(), 0, 3, ElementType::Float, VertexSize, 0),
-			ArrayElement(_vertexBuffer.get(), 1, 4, ElementType::Float, VertexSize, 3 * sizeof(float))
+			ArrayElement(vertexBuffer, 0, 3, ElementType::Float, VertexSize, 0),
+			ArrayElement(vertexBuffer, 1, 4, ElementType::Float, VertexSize, 3 * sizeof(float))
 		};
 
-		_vertexBinding = std::make_unique<VertexBinding>();
-		_vertexBinding->Create(vertexLayout, 2, *_vertexBuffer);
-
-		_shader = Shader::Library.Get("Shaders/DebugLine.shader");
+		_vertexBinding->Create(vertexLayout, 2, *vertexBuffer);
+		_bindingGeneration = StreamingBuffer::GetGeneration();
 	}
 
 	void LineRenderer::Flush()
@@ -32,12 +42,21 @@ namespace Freeking
 			return;
 		}
 
-		_vertexBuffer->UpdateBuffer(_buffer.data(), 0, _vertexCount * VertexSize);
+		size_t firstVertex;
+		auto vertices = StreamingBuffer::Allocate(_vertexCount, VertexSize, firstVertex);
+		if (!vertices)
+		{
+			_vertexCount = 0;
+			return;
+		}
+
+		std::memcpy(vertices, _buffer.data(), _vertexCount * VertexSize);
+		UpdateBinding();
 
 		_shader->Bind();
 
 		_vertexBinding->Bind();
-		glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(_vertexCount));
+		glDrawArrays(GL_LINES, static_cast<GLint>(firstVertex), static_cast<GLsizei>(_vertexCount));
 		_vertexBinding->Unbind();
 
 		_vertexCount = 0;
@@ -180,9 +199,9 @@ namespace Freeking
 
 	void LineRenderer::BufferVertex(const Vector3f& position, const LinearColor& colour)
 	{
-		if (_vertexCount >= _maxVertexCount)
+		if ((_vertexCount + 1) * VertexSize > _buffer.size())
 		{
-			return;
+			_buffer.resize(std::max(_buffer.size() * 2, VertexSize * 4096));
 		}
 
 		uint8_t* vertexData = &_buffer[_vertexCount * VertexSize];
@@ -2,6 +2,7 @@
 
 #include "VertexBinding.h"
 #include "VertexBuffer.h"
+#include "StreamingBuffer.h"
 #include "Quaternion.h"
 #include "Color.h"
 #include <vector>
@@ -16,7 +17,7 @@ namespace Freeking
 
 		static std::shared_ptr<LineRenderer> Debug;
 
-		LineRenderer(std::size_t maxVertexCount);
+		LineRenderer();
 
 		void DrawLine(const Vector3f& p1, const Vector3f& p2, const LinearColor& colour);
 		void DrawBox(const Matrix4x4& transform, const Vector3f& mins, const Vector3f& maxs, const LinearColor& colour);
@@ -30,18 +31,17 @@ namespace Freeking
 		void Clear();
 
 		inline std::size_t GetVertexCount() const { return _vertexCount; }
-		inline std::size_t GetMaxVertexCount() const { return _maxVertexCount; }
 
 	private:
 
 		void BufferVertex(const Vector3f& position, const LinearColor& colour);
+		void UpdateBinding();
 
 		static const std::size_t VertexSize = 28;
 		std::size_t _vertexCount;
-		std::size_t _maxVertexCount;
 
-		std::unique_ptr<VertexBuffer> _vertexBuffer;
 		std::unique_ptr<VertexBinding> _vertexBinding;
+		uint32_t _bindingGeneration;
 		std::vector<uint8_t> _buffer;
 		std::shared_ptr<Shader> _shader;
 	};
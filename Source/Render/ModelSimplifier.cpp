@@ -0,0 +1,417 @@
+#include "ModelSimplifier.h"
+#include <algorithm>
+#include <array>
+#include <queue>
+#include <unordered_map>
+
+namespace Freeking
+{
+	namespace
+	{
+		struct Quadric
+		{
+			std::array<double, 10> q = {};
+
+			void AddPlane(double a, double b, double c, double d, double weight)
+			{
+				q[0] += weight * a * a; q[1] += weight * a * b; q[2] += weight * a * c; q[3] += weight * a * d;
+				q[4] += weight * b * b; q[5] += weight * b * c; q[6] += weight * b * d;
+				q[7] += weight * c * c; q[8] += weight * c * d;
+				q[9] += weight * d * d;
+			}
+
+			void Add(const Quadric& other)
+			{
+				for (size_t i = 0; i < q.size(); ++i)
+				{
+					q[i] += other.q[i];
+				}
+			}
+
+			double Evaluate(const Vector3f& p) const
+			{
+				double x = p.x, y = p.y, z = p.z;
+
+				return
+					q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
+					q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
+					q[7] * z * z + 2 * q[8] * z +
+					q[9];
+			}
+		};
+
+		struct Triangle
+		{
+			std::array<uint32_t, 3> corners;
+			std::array<uint32_t, 3> positions;
+			bool removed;
+		};
+
+		struct Collapse
+		{
+			double cost;
+			uint32_t from;
+			uint32_t to;
+			uint32_t fromVersion;
+			uint32_t toVersion;
+
+			bool operator>(const Collapse& other) const { return cost > other.cost; }
+		};
+
+		inline uint64_t EdgeKey(uint32_t a, uint32_t b)
+		{
+			return (a < b) ? (((uint64_t)a << 32) | b) : (((uint64_t)b << 32) | a);
+		}
+	}
+
+	std::vector<std::vector<uint32_t>> ModelSimplifier::Simplify(const DynamicModelData& model, const std::vector<size_t>& targetTriangleCounts)
+	{
+		std::vector<std::vector<uint32_t>> lods;
+
+		const size_t numPositions = model.GetFrameVertexCount();
+		const size_t frameCount = std::min<size_t>(model.GetFrameCount(), model.FrameTransforms.size());
+
+		if (numPositions == 0 || frameCount == 0 || model.FrameVertices.size() < frameCount * numPositions || model.Indices.size() < 3)
+		{
+			return lods;
+		}
+
+		// Positions are decoded for a spread of frames and every collapse is tested against all of them.
+		const size_t numSampleFrames = std::min(frameCount, MaxSampleFrames);
+		std::vector<Vector3f> positions(numSampleFrames * numPositions);
+
+		for (size_t sample = 0; sample < numSampleFrames; ++sample)
+		{
+			size_t frame = (sample * frameCount) / numSampleFrames;
+			const auto& frameTransform = model.FrameTransforms[frame];
+
+			for (size_t i = 0; i < numPositions; ++i)
+			{
+				const auto& frameVertex = model.FrameVertices[frame * numPositions + i];
+				Vector3f position(frameVertex.x + 128.0f, frameVertex.y + 128.0f, frameVertex.z + 128.0f);
+
+				positions[sample * numPositions + i] = Vector3f(
+					position.x * frameTransform.scale.x + frameTransform.translate.x,
+					position.y * frameTransform.scale.y + frameTransform.translate.y,
+					position.z * frameTransform.scale.z + frameTransform.translate.z);
+			}
+		}
+
+		auto getPosition = [&](size_t sample, uint32_t position) -> const Vector3f&
+		{
+			return positions[sample * numPositions + position];
+		};
+
+		std::vector<Triangle> triangles;
+		triangles.reserve(model.Indices.size() / 3);
+
+		for (size_t i = 0; i + 2 < model.Indices.size(); i += 3)
+		{
+			Triangle triangle;
+			triangle.removed = false;
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				triangle.corners[c] = model.Indices[i + c];
+				triangle.positions[c] = (uint32_t)model.Vertices[triangle.corners[c]].VertexIndex;
+			}
+
+			if (triangle.positions[0] != triangle.positions[1] &&
+				triangle.positions[1] != triangle.positions[2] &&
+				triangle.positions[2] != triangle.positions[0])
+			{
+				triangles.push_back(triangle);
+			}
+		}
+
+		std::vector<std::vector<uint32_t>> positionTriangles(numPositions);
+		std::vector<Quadric> quadrics(numSampleFrames * numPositions);
+		std::vector<bool> locked(numPositions, false);
+		std::vector<bool> removed(numPositions, false);
+		std::vector<uint32_t> versions(numPositions, 0);
+		std::vector<const Vector2f*> positionUVs(numPositions, nullptr);
+		std::unordered_map<uint64_t, uint32_t> edgeCounts;
+
+		for (uint32_t t = 0; t < (uint32_t)triangles.size(); ++t)
+		{
+			const auto& triangle = triangles[t];
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				auto position = triangle.positions[c];
+				positionTriangles[position].push_back(t);
+				edgeCounts[EdgeKey(position, triangle.positions[(c + 1) % 3])]++;
+
+				// A position whose corners disagree on UV lies on a seam.
+				const auto& uv = model.Vertices[triangle.corners[c]].UV;
+				if (!positionUVs[position])
+				{
+					positionUVs[position] = &uv;
+				}
+				else if (positionUVs[position]->x != uv.x || positionUVs[position]->y != uv.y)
+				{
+					locked[position] = true;
+				}
+			}
+
+			for (size_t sample = 0; sample < numSampleFrames; ++sample)
+			{
+				const auto& p0 = getPosition(sample, triangle.positions[0]);
+				const auto& p1 = getPosition(sample, triangle.positions[1]);
+				const auto& p2 = getPosition(sample, triangle.positions[2]);
+
+				auto normal = (p1 - p0).Cross(p2 - p0);
+				float area = normal.Length();
+				if (area <= 0.0f)
+				{
+					continue;
+				}
+
+				normal = normal * (1.0f / area);
+				double d = -(double)normal.Dot(p0);
+
+				for (size_t c = 0; c < 3; ++c)
+				{
+					quadrics[sample * numPositions + triangle.positions[c]].AddPlane(normal.x, normal.y, normal.z, d, area * 0.5);
+				}
+			}
+		}
+
+		// Edges that are not shared by exactly two triangles are open borders or non-manifold.
+		for (const auto& [edge, count] : edgeCounts)
+		{
+			if (count != 2)
+			{
+				locked[(uint32_t)(edge >> 32)] = true;
+				locked[(uint32_t)(edge & 0xFFFFFFFF)] = true;
+			}
+		}
+
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+
+		auto pushCollapse = [&](uint32_t from, uint32_t to)
+		{
+			if (locked[from] || removed[from] || removed[to])
+			{
+				return;
+			}
+
+			double cost = 0.0;
+
+			for (size_t sample = 0; sample < numSampleFrames; ++sample)
+			{
+				Quadric quadric = quadrics[sample * numPositions + from];
+				quadric.Add(quadrics[sample * numPositions + to]);
+				cost = std::max(cost, quadric.Evaluate(getPosition(sample, to)));
+			}
+
+			collapses.push({ cost, from, to, versions[from], versions[to] });
+		};
+
+		auto pushNeighbourCollapses = [&](uint32_t position)
+		{
+			for (auto t : positionTriangles[position])
+			{
+				const auto& triangle = triangles[t];
+				if (triangle.removed)
+				{
+					continue;
+				}
+
+				for (auto other : triangle.positions)
+				{
+					if (other != position)
+					{
+						pushCollapse(position, other);
+						pushCollapse(other, position);
+					}
+				}
+			}
+		};
+
+		for (const auto& triangle : triangles)
+		{
+			for (size_t c = 0; c < 3; ++c)
+			{
+				pushCollapse(triangle.positions[c], triangle.positions[(c + 1) % 3]);
+				pushCollapse(triangle.positions[(c + 1) % 3], triangle.positions[c]);
+			}
+		}
+
+		// Rejects collapses that flip a remaining triangle in any sampled frame.
+		auto flipsTriangle = [&](uint32_t from, uint32_t to)
+		{
+			for (auto t : positionTriangles[from])
+			{
+				const auto& triangle = triangles[t];
+				if (triangle.removed || std::find(triangle.positions.begin(), triangle.positions.end(), to) != triangle.positions.end())
+				{
+					continue;
+				}
+
+				for (size_t sample = 0; sample < numSampleFrames; ++sample)
+				{
+					std::array<Vector3f, 3> before;
+					std::array<Vector3f, 3> after;
+
+					for (size_t c = 0; c < 3; ++c)
+					{
+						before[c] = getPosition(sample, triangle.positions[c]);
+						after[c] = getPosition(sample, triangle.positions[c] == from ? to : triangle.positions[c]);
+					}
+
+					auto beforeNormal = (before[1] - before[0]).Cross(before[2] - before[0]);
+					auto afterNormal = (after[1] - after[0]).Cross(after[2] - after[0]);
+
+					if (beforeNormal.Dot(afterNormal) <= 0.0f)
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		};
+
+		auto emitLod = [&]()
+		{
+			std::vector<uint32_t> indices;
+
+			for (const auto& triangle : triangles)
+			{
+				if (!triangle.removed)
+				{
+					indices.insert(indices.end(), triangle.corners.begin(), triangle.corners.end());
+				}
+			}
+
+			lods.push_back(std::move(indices));
+		};
+
+		size_t numTriangles = triangles.size();
+		size_t targetIndex = 0;
+
+		while (targetIndex < targetTriangleCounts.size())
+		{
+			if (numTriangles <= targetTriangleCounts[targetIndex])
+			{
+				emitLod();
+				targetIndex++;
+				continue;
+			}
+
+			if (collapses.empty())
+			{
+				// Keep a partly reduced LOD only if it is worth the extra draw range.
+				size_t previousCount = lods.empty() ? triangles.size() : lods.back().size() / 3;
+				if (numTriangles * 5 < previousCount * 4)
+				{
+					emitLod();
+				}
+
+				break;
+			}
+
+			auto collapse = collapses.top();
+			collapses.pop();
+
+			auto from = collapse.from;
+			auto to = collapse.to;
+
+			if (removed[from] || removed[to] || versions[from] != collapse.fromVersion || versions[to] != collapse.toVersion)
+			{
+				continue;
+			}
+
+			// The moved corners take the render vertex 'to' has on the collapsed edge, which
+			// carries the right UV because 'from' is not on a seam.
+			uint32_t toCorner = UINT32_MAX;
+
+			for (auto t : positionTriangles[from])
+			{
+				const auto& triangle = triangles[t];
+				if (triangle.removed)
+				{
+					continue;
+				}
+
+				for (size_t c = 0; c < 3; ++c)
+				{
+					if (triangle.positions[c] == to)
+					{
+						toCorner = triangle.corners[c];
+					}
+				}
+			}
+
+			if (toCorner == UINT32_MAX || flipsTriangle(from, to))
+			{
+				continue;
+			}
+
+			for (auto t : positionTriangles[from])
+			{
+				auto& triangle = triangles[t];
+				if (triangle.removed)
+				{
+					continue;
+				}
+
+				if (std::find(triangle.positions.begin(), triangle.positions.end(), to) != triangle.positions.end())
+				{
+					triangle.removed = true;
+					numTriangles--;
+					continue;
+				}
+
+				for (size_t c = 0; c < 3; ++c)
+				{
+					if (triangle.positions[c] == from)
+					{
+						triangle.positions[c] = to;
+						triangle.corners[c] = toCorner;
+					}
+				}
+
+				positionTriangles[to].push_back(t);
+			}
+
+			for (size_t sample = 0; sample < numSampleFrames; ++sample)
+			{
+				quadrics[sample * numPositions + to].Add(quadrics[sample * numPositions + from]);
+			}
+
+			removed[from] = true;
+			positionTriangles[from].clear();
+
+			// Drop the removed triangles from the list and invalidate every queued collapse
+			// that touches the changed neighbourhood.
+			auto& toTriangles = positionTriangles[to];
+			toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [&](uint32_t t) { return triangles[t].removed; }), toTriangles.end());
+
+			std::vector<uint32_t> neighbours = { to };
+			for (auto t : toTriangles)
+			{
+				for (auto position : triangles[t].positions)
+				{
+					if (std::find(neighbours.begin(), neighbours.end(), position) == neighbours.end())
+					{
+						neighbours.push_back(position);
+					}
+				}
+			}
+
+			for (auto position : neighbours)
+			{
+				versions[position]++;
+			}
+
+			for (auto position : neighbours)
+			{
+				pushNeighbourCollapses(position);
+			}
+		}
+
+		return lods;
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "DynamicModelData.h"
+#include <vector>
+#include <cstdint>
+
+namespace Freeking
+{
+	// Builds coarser index lists for a dynamic model with quadric error metric edge collapses.
+	// Collapses move a vertex onto a neighbour rather than to a new position, so every LOD
+	// reuses the model's vertices and animates with the same frame data. The error of a
+	// collapse is the worst over a spread of frames, so the reduced topology holds up
+	// across the animation. Vertices on UV seams and open borders are never moved.
+	class ModelSimplifier
+	{
+	public:
+
+		static constexpr size_t MaxSampleFrames = 16;
+
+		ModelSimplifier() = delete;
+
+		// Returns one index list for each target triangle count that could be reached, from
+		// finest to coarsest. Stops early if the model can not be reduced any further.
+		static std::vector<std::vector<uint32_t>> Simplify(const DynamicModelData& model, const std::vector<size_t>& targetTriangleCounts);
+	};
+}
@@ -0,0 +1,220 @@
+#include "RenderQueue.h"
+#include "Shader.h"
+#include "Texture2D.h"
+#include "VertexBinding.h"
+#include "Maths.h"
+#include "Name.h"
+#include <array>
+#include <cstring>
+
+namespace Freeking
+{
+	namespace
+	{
+		// Entries with this bit set index the draw callbacks rather than the packets.
+		constexpr uint32_t DrawIndexBit = 0x80000000u;
+
+		constexpr uint64_t DepthBits = 22;
+		constexpr uint64_t DepthMask = (1ull << DepthBits) - 1;
+
+		const Name DiffuseName("diffuse");
+		const Name LightmapName("lightmap");
+	}
+
+	RenderQueue::RenderQueue() :
+		_numPackets(0),
+		_numProgramSwitches(0),
+		_numTextureSwitches(0),
+		_numBindingSwitches(0)
+	{
+	}
+
+	uint64_t RenderQueue::MakeKey(Pass pass, const Shader* shader, uint32_t textureId, uint32_t bindingId, float depth)
+	{
+		uint64_t quantisedDepth = (uint64_t)(Math::Clamp(depth / MaxDepth, 0.0f, 1.0f) * (float)DepthMask);
+		uint64_t program = shader ? (shader->GetProgram() & 0xFF) : 0;
+		uint64_t texture = textureId & 0xFFFF;
+		uint64_t binding = bindingId & 0xFFFF;
+
+		if (pass == Pass::Opaque)
+		{
+			return ((uint64_t)pass << 62) | (program << 54) | (texture << 38) | (binding << 22) | quantisedDepth;
+		}
+
+		return ((uint64_t)pass << 62) | ((DepthMask - quantisedDepth) << 40) | (program << 32) | (texture << 16) | binding;
+	}
+
+	void RenderQueue::Add(uint64_t key, const Packet& packet)
+	{
+		_entries.push_back({ key, (uint32_t)_packets.size() });
+		_packets.push_back(packet);
+	}
+
+	void RenderQueue::Add(uint64_t key, std::function<void()> draw)
+	{
+		_entries.push_back({ key, (uint32_t)_draws.size() | DrawIndexBit });
+		_draws.push_back(std::move(draw));
+	}
+
+	void RenderQueue::Sort()
+	{
+		// Least significant digit first, a byte at a time. Bytes every key shares, such as
+		// the pass bits in a frame with no translucent draws, are skipped.
+		std::array<std::array<uint32_t, 256>, 8> counts = {};
+
+		for (const auto& entry : _entries)
+		{
+			for (size_t digit = 0; digit < 8; ++digit)
+			{
+				counts[digit][(entry.key >> (digit * 8)) & 0xFF]++;
+			}
+		}
+
+		_sortBuffer.resize(_entries.size());
+
+		for (size_t digit = 0; digit < 8; ++digit)
+		{
+			auto& digitCounts = counts[digit];
+			if (digitCounts[(_entries.front().key >> (digit * 8)) & 0xFF] == _entries.size())
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (auto& count : digitCounts)
+			{
+				auto bucketSize = count;
+				count = offset;
+				offset += bucketSize;
+			}
+
+			for (const auto& entry : _entries)
+			{
+				_sortBuffer[digitCounts[(entry.key >> (digit * 8)) & 0xFF]++] = entry;
+			}
+
+			_entries.swap(_sortBuffer);
+		}
+	}
+
+	void RenderQueue::Submit()
+	{
+		_numPackets = _entries.size();
+		_numProgramSwitches = 0;
+		_numTextureSwitches = 0;
+		_numBindingSwitches = 0;
+
+		if (_entries.empty())
+		{
+			return;
+		}
+
+		Sort();
+
+		// Lay the packets' uniform blocks out in submit order and upload them together.
+		size_t blockStride = Shader::DrawUniforms.GetStride(sizeof(DrawUniformBlock));
+		_uniformData.resize(_packets.size() * blockStride);
+
+		size_t numBlocks = 0;
+		for (const auto& entry : _entries)
+		{
+			if (entry.index & DrawIndexBit)
+			{
+				continue;
+			}
+
+			const auto& packet = _packets[entry.index];
+
+			DrawUniformBlock block;
+			block.modelMatrix = *packet.modelMatrix;
+			block.brightness = packet.brightness;
+			block.alphaCutOff = packet.alphaCutOff;
+			block.alphaMultiply = packet.alphaMultiply;
+			block.padding = 0.0f;
+
+			std::memcpy(&_uniformData[numBlocks++ * blockStride], &block, sizeof(block));
+		}
+
+		size_t blockOffset = Shader::DrawUniforms.Upload(_uniformData.data(), numBlocks * blockStride);
+
+		Shader* shader = nullptr;
+		VertexBinding* binding = nullptr;
+		const Texture2D* diffuse = nullptr;
+		const Texture2D* lightmap = nullptr;
+		bool translucent = false;
+
+		int diffuseId = -1;
+		int lightmapId = -1;
+
+		for (const auto& entry : _entries)
+		{
+			if (!translucent && (entry.key >> 62) == (uint64_t)Pass::Translucent)
+			{
+				translucent = true;
+				glEnable(GL_BLEND);
+			}
+
+			if (entry.index & DrawIndexBit)
+			{
+				if (binding)
+				{
+					binding->Unbind();
+				}
+
+				_draws[entry.index & ~DrawIndexBit]();
+
+				shader = nullptr;
+				binding = nullptr;
+				diffuse = nullptr;
+				lightmap = nullptr;
+
+				continue;
+			}
+
+			const auto& packet = _packets[entry.index];
+
+			if (packet.shader != shader)
+			{
+				shader = packet.shader;
+				shader->Bind();
+				_numProgramSwitches++;
+
+				diffuseId = shader->GetTextureParameterId(DiffuseName);
+				lightmapId = shader->GetTextureParameterId(LightmapName);
+				diffuse = nullptr;
+				lightmap = nullptr;
+			}
+
+			if (packet.diffuse != diffuse || packet.lightmap != lightmap)
+			{
+				diffuse = packet.diffuse;
+				lightmap = packet.lightmap;
+				shader->SetParameterValue(diffuseId, diffuse);
+				shader->SetParameterValue(lightmapId, lightmap);
+				_numTextureSwitches++;
+			}
+
+			// Blocks were written in this same order, skipping the callbacks.
+			Shader::DrawUniforms.Bind(blockOffset, sizeof(DrawUniformBlock));
+			blockOffset += blockStride;
+
+			if (packet.binding != binding)
+			{
+				binding = packet.binding;
+				binding->Bind();
+				_numBindingSwitches++;
+			}
+
+			glDrawElements(GL_TRIANGLES, binding->GetNumElements(), GL_UNSIGNED_INT, (void*)0);
+		}
+
+		if (binding)
+		{
+			binding->Unbind();
+		}
+
+		_entries.clear();
+		_packets.clear();
+		_draws.clear();
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace Freeking
+{
+	class Shader;
+	class Texture2D;
+	class VertexBinding;
+
+	// Collects a frame's draws as packets with 64 bit sort keys, radix sorts them and submits
+	// them in order, skipping program, texture and vertex binding changes that would not
+	// change anything. Opaque packets are grouped by state and drawn front to back within a
+	// state, translucent packets are drawn back to front:
+	//   opaque:      pass:2 | shader:8 | texture:16 | binding:16 | depth:22
+	//   translucent: pass:2 | inverted depth:22 | shader:8 | texture:16 | binding:16
+	// The per-draw values go to the shader's DrawUniforms block, uploaded once per submit
+	// and bound by offset, rather than through glUniform calls.
+	class RenderQueue
+	{
+	public:
+
+		enum class Pass : uint8_t
+		{
+			Opaque = 0,
+			Translucent = 1
+		};
+
+		// A lightmapped mesh draw. The model matrix must outlive the frame's Submit.
+		struct Packet
+		{
+			Shader* shader;
+			VertexBinding* binding;
+			const Texture2D* diffuse;
+			const Texture2D* lightmap;
+			const Matrix4x4* modelMatrix;
+			float brightness;
+			float alphaCutOff;
+			float alphaMultiply;
+		};
+
+		static constexpr float MaxDepth = 16384.0f;
+
+		RenderQueue();
+
+		static uint64_t MakeKey(Pass pass, const Shader* shader, uint32_t textureId, uint32_t bindingId, float depth);
+
+		void Add(uint64_t key, const Packet& packet);
+
+		// Runs a draw the queue does not know the state of, such as a batch flush. Packets
+		// after it rebind everything they use.
+		void Add(uint64_t key, std::function<void()> draw);
+
+		// Sorts and draws everything added since the last submit. Blending is enabled when
+		// the translucent pass starts.
+		void Submit();
+
+		inline size_t GetNumPackets() const { return _numPackets; }
+		inline size_t GetNumProgramSwitches() const { return _numProgramSwitches; }
+		inline size_t GetNumTextureSwitches() const { return _numTextureSwitches; }
+		inline size_t GetNumBindingSwitches() const { return _numBindingSwitches; }
+
+	private:
+
+		struct Entry
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		// std140 layout of the DrawUniforms block.
+		struct DrawUniformBlock
+		{
+			Matrix4x4 modelMatrix;
+			float brightness;
+			float alphaCutOff;
+			float alphaMultiply;
+			float padding;
+		};
+
+		void Sort();
+
+		std::vector<Entry> _entries;
+		std::vector<Entry> _sortBuffer;
+		std::vector<Packet> _packets;
+		std::vector<std::function<void()>> _draws;
+		std::vector<uint8_t> _uniformData;
+		size_t _numPackets;
+		size_t _numProgramSwitches;
+		size_t _numTextureSwitches;
+		size_t _numBindingSwitches;
+	};
+}
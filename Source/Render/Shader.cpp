@@ -1,10 +1,12 @@
 ﻿#include "Shader.h"
 #include "Texture2D.h"
+#include "Texture2DArray.h"
 #include "TextureBuffer.h"
 #include "TextureCube.h"
 #include "TextureSampler.h"
 #include "ShaderLoader.h"
 #include <cassert>
+#include <cstring>
 
 namespace Freeking
 {
@@ -17,6 +19,7 @@ namespace Freeking
 		Text = Get("Shaders/Text.shader");
 		Skybox = Get("Shaders/Skybox.shader");
 		Billboard = Get("Shaders/Billboard.shader");
+		Blit = Get("Shaders/Blit.shader");
 	}
 
 	void ShaderLibrary::UpdateLoaders()
@@ -26,9 +29,11 @@ namespace Freeking
 
 	ShaderLibrary Shader::Library;
 	GlobalUniformBuffer Shader::GlobalUniforms;
+	DrawUniformBuffer Shader::DrawUniforms;
 
 	std::vector<Shader::TextureBindingState> Shader::_textureBindingStates;
 	GLuint Shader::_activeProgramId = 0;
+	size_t Shader::_numUniformCalls = 0;
 
 	void Shader::Initialize()
 	{
@@ -37,6 +42,7 @@ namespace Freeking
 		_textureBindingStates.resize(maxCombinedTextureImageUnits);
 
 		GlobalUniforms.Initialize();
+		DrawUniforms.Initialize(1024 * 1024);
 		Library.Initialize();
 	}
 
@@ -102,6 +108,7 @@ namespace Freeking
 
 			// This can be set here as it doesn't change
 			glUniform1i(p.location, p.unit);
+			_numUniformCalls++;
 
 			return;
 		}
@@ -127,7 +134,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, int value)
+	void Shader::SetParameterValue(const Name& name, int value)
 	{
 		SetParameterValue(_intParameters.GetId(name), value);
 	}
@@ -143,7 +150,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, float value)
+	void Shader::SetParameterValue(const Name& name, float value)
 	{
 		SetParameterValue(_floatParameters.GetId(name), value);
 	}
@@ -159,7 +166,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, const Vector2f& value)
+	void Shader::SetParameterValue(const Name& name, const Vector2f& value)
 	{
 		SetParameterValue(_floatParameters.GetId(name), value);
 	}
@@ -175,7 +182,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, const Vector3f& value)
+	void Shader::SetParameterValue(const Name& name, const Vector3f& value)
 	{
 		SetParameterValue(_floatParameters.GetId(name), value);
 	}
@@ -191,7 +198,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, const Vector4f& value)
+	void Shader::SetParameterValue(const Name& name, const Vector4f& value)
 	{
 		SetParameterValue(_floatParameters.GetId(name), value);
 	}
@@ -207,7 +214,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, const Matrix3x3& value)
+	void Shader::SetParameterValue(const Name& name, const Matrix3x3& value)
 	{
 		SetParameterValue(_matrixParameters.GetId(name), value);
 	}
@@ -223,7 +230,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, const Matrix4x4& value)
+	void Shader::SetParameterValue(const Name& name, const Matrix4x4& value)
 	{
 		SetParameterValue(_matrixParameters.GetId(name), value);
 	}
@@ -239,7 +246,7 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, const Texture2D* value)
+	void Shader::SetParameterValue(const Name& name, const Texture2D* value)
 	{
 		SetParameterValue(name, value, TextureSampler::GetDefault().get());
 	}
@@ -249,7 +256,7 @@ namespace Freeking
 		SetParameterValue(id, value, TextureSampler::GetDefault().get());
 	}
 
-	void Shader::SetParameterValue(const char* name, const Texture2D* texture, const TextureSampler* sampler)
+	void Shader::SetParameterValue(const Name& name, const Texture2D* texture, const TextureSampler* sampler)
 	{
 		if (!texture)
 		{
@@ -275,7 +282,33 @@ namespace Freeking
 		}
 	}
 
-	void Shader::SetParameterValue(const char* name, const TextureBuffer* texture)
+	void Shader::SetParameterValue(const Name& name, const Texture2DArray* texture, const TextureSampler* sampler)
+	{
+		if (!texture)
+		{
+			return;
+		}
+
+		SetParameterValue(_textureParameters.GetId(name), texture, sampler);
+	}
+
+	void Shader::SetParameterValue(int id, const Texture2DArray* texture, const TextureSampler* sampler)
+	{
+		assert(_program == _activeProgramId);
+
+		if (!texture)
+		{
+			return;
+		}
+
+		if (auto param = _textureParameters.GetParameter(id);
+			param != nullptr && param->type == TextureParameter::Type::Tex2DArray)
+		{
+			param->SetTexture(texture, sampler);
+		}
+	}
+
+	void Shader::SetParameterValue(const Name& name, const TextureBuffer* texture)
 	{
 		if (!texture)
 		{
@@ -285,7 +318,7 @@ namespace Freeking
 		SetParameterValue(_textureParameters.GetId(name), texture);
 	}
 
-	void Shader::SetParameterValue(const char* name, const TextureCube* texture, const TextureSampler* sampler)
+	void Shader::SetParameterValue(const Name& name, const TextureCube* texture, const TextureSampler* sampler)
 	{
 		if (!texture)
 		{
@@ -340,6 +373,7 @@ namespace Freeking
 			unset = false;
 
 			glUniform1f(location, value[0]);
+			_numUniformCalls++;
 		}
 	}
 
@@ -356,6 +390,7 @@ namespace Freeking
 			unset = false;
 
 			glUniform2f(location, value[0], value[1]);
+			_numUniformCalls++;
 		}
 	}
 
@@ -372,6 +407,7 @@ namespace Freeking
 			unset = false;
 
 			glUniform3f(location, value[0], value[1], value[2]);
+			_numUniformCalls++;
 		}
 	}
 
@@ -388,6 +424,7 @@ namespace Freeking
 			unset = false;
 
 			glUniform4f(location, value[0], value[1], value[2], value[3]);
+			_numUniformCalls++;
 		}
 	}
 
@@ -404,6 +441,7 @@ namespace Freeking
 			unset = false;
 
 			glUniform1i(location, value[0]);
+			_numUniformCalls++;
 		}
 	}
 
@@ -414,10 +452,16 @@ namespace Freeking
 			return;
 		}
 
+		if (!unset && std::memcmp(&value[0], v.Base(), 36) == 0)
+		{
+			return;
+		}
+
 		std::memcpy(&value[0], v.Base(), 36);
 		unset = false;
 
 		glUniformMatrix3fv(location, 1, GL_FALSE, &value[0]);
+		_numUniformCalls++;
 	}
 
 	void Shader::MatrixParameter::SetMat4(const Matrix4x4& v)
@@ -427,10 +471,16 @@ namespace Freeking
 			return;
 		}
 
+		if (!unset && std::memcmp(&value[0], v.Base(), 64) == 0)
+		{
+			return;
+		}
+
 		std::memcpy(&value[0], v.Base(), 64);
 		unset = false;
 
 		glUniformMatrix4fv(location, 1, GL_FALSE, &value[0]);
+		_numUniformCalls++;
 	}
 
 	void Shader::TextureParameter::SetTexture(const Texture2D* texture, const TextureSampler* sampler)
@@ -445,6 +495,18 @@ namespace Freeking
 		}
 	}
 
+	void Shader::TextureParameter::SetTexture(const Texture2DArray* texture, const TextureSampler* sampler)
+	{
+		if (type == Type::Tex2DArray && texture)
+		{
+			textureId = texture->GetId();
+			samplerId = sampler != nullptr ? sampler->GetId() : TextureSampler::GetDefault()->GetId();
+			unset = false;
+
+			Apply();
+		}
+	}
+
 	void Shader::TextureParameter::SetTexture(const TextureBuffer* texture)
 	{
 		if (type == Type::TexBuffer && texture)
@@ -574,7 +636,11 @@ namespace Freeking
 
 			if (nameString == "GlobalUniforms")
 			{
-				glUniformBlockBinding(_program, i, 0);
+				glUniformBlockBinding(_program, i, GlobalUniformBuffer::Binding);
+			}
+			else if (nameString == "DrawUniforms")
+			{
+				glUniformBlockBinding(_program, i, DrawUniformBuffer::Binding);
 			}
 		}
 
@@ -627,7 +693,7 @@ namespace Freeking
 		glGenBuffers(1, &_bufferId);
 		glBindBuffer(GL_UNIFORM_BUFFER, _bufferId);
 		glBufferData(GL_UNIFORM_BUFFER, sizeof(UniformBlock), NULL, GL_STATIC_DRAW);
-		glBindBufferBase(GL_UNIFORM_BUFFER, 0, _bufferId);
+		glBindBufferBase(GL_UNIFORM_BUFFER, Binding, _bufferId);
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
@@ -642,4 +708,98 @@ namespace Freeking
 		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(UniformBlock), &Uniforms);
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
+
+	DrawUniformBuffer::DrawUniformBuffer() :
+		_bufferId(0),
+		_capacity(0),
+		_head(0),
+		_alignment(256),
+		_boundOffset(0),
+		_boundSize(0)
+	{
+	}
+
+	DrawUniformBuffer::~DrawUniformBuffer()
+	{
+		if (_bufferId)
+		{
+			glDeleteBuffers(1, &_bufferId);
+		}
+	}
+
+	void DrawUniformBuffer::Initialize(size_t capacity)
+	{
+		if (_bufferId)
+		{
+			return;
+		}
+
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		if (alignment > 0)
+		{
+			_alignment = static_cast<size_t>(alignment);
+		}
+
+		_capacity = capacity;
+
+		glGenBuffers(1, &_bufferId);
+		glBindBuffer(GL_UNIFORM_BUFFER, _bufferId);
+		glBufferData(GL_UNIFORM_BUFFER, _capacity, NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	size_t DrawUniformBuffer::GetStride(size_t blockSize) const
+	{
+		return ((blockSize + _alignment - 1) / _alignment) * _alignment;
+	}
+
+	size_t DrawUniformBuffer::Upload(const void* data, size_t size)
+	{
+		if (!_bufferId || size == 0)
+		{
+			return 0;
+		}
+
+		glBindBuffer(GL_UNIFORM_BUFFER, _bufferId);
+
+		if (size > _capacity)
+		{
+			while (_capacity < size)
+			{
+				_capacity *= 2;
+			}
+
+			glBufferData(GL_UNIFORM_BUFFER, _capacity, NULL, GL_STREAM_DRAW);
+			_head = 0;
+		}
+		else if (_head + size > _capacity)
+		{
+			glBufferData(GL_UNIFORM_BUFFER, _capacity, NULL, GL_STREAM_DRAW);
+			_head = 0;
+		}
+
+		size_t offset = _head;
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		_head = GetStride(offset + size);
+
+		// Orphaning replaces the storage the bound range pointed into.
+		_boundSize = 0;
+
+		return offset;
+	}
+
+	void DrawUniformBuffer::Bind(size_t offset, size_t size)
+	{
+		if (offset == _boundOffset && size == _boundSize)
+		{
+			return;
+		}
+
+		glBindBufferRange(GL_UNIFORM_BUFFER, Binding, _bufferId, offset, size);
+		_boundOffset = offset;
+		_boundSize = size;
+	}
 }
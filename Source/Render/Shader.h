@@ -11,6 +11,7 @@
 namespace Freeking
 {
 	class Texture2D;
+	class Texture2DArray;
 	class TextureBuffer;
 	class TextureCube;
 	class TextureSampler;
@@ -29,6 +30,7 @@ namespace Freeking
 		std::shared_ptr<Shader> Text;
 		std::shared_ptr<Shader> Skybox;
 		std::shared_ptr<Shader> Billboard;
+		std::shared_ptr<Shader> Blit;
 
 	protected:
 
@@ -39,6 +41,8 @@ namespace Freeking
 	{
 	public:
 
+		static constexpr GLuint Binding = 0;
+
 		GlobalUniformBuffer();
 		~GlobalUniformBuffer();
 
@@ -59,12 +63,46 @@ namespace Freeking
 		GLuint _bufferId;
 	};
 
+	// Ring of per-draw uniform blocks bound to a shader's DrawUniforms block by offset. A
+	// frame's blocks are uploaded in one go after the previous upload, and the storage is
+	// orphaned when the ring wraps so the driver never waits on draws still reading it.
+	class DrawUniformBuffer
+	{
+	public:
+
+		static constexpr GLuint Binding = 1;
+
+		DrawUniformBuffer();
+		~DrawUniformBuffer();
+
+		void Initialize(size_t capacity);
+
+		// Size of a block rounded up to the uniform buffer offset alignment, the stride to
+		// lay blocks out at so each can be bound on its own.
+		size_t GetStride(size_t blockSize) const;
+
+		// Returns the offset the data was written to.
+		size_t Upload(const void* data, size_t size);
+
+		void Bind(size_t offset, size_t size);
+
+	private:
+
+		GLuint _bufferId;
+		size_t _capacity;
+		size_t _head;
+		size_t _alignment;
+		size_t _boundOffset;
+		size_t _boundSize;
+	};
+
 	class Shader
 	{
 	public:
 
 		static ShaderLibrary Library;
 		static GlobalUniformBuffer GlobalUniforms;
+		static DrawUniformBuffer DrawUniforms;
 
 		static void Initialize();
 
@@ -76,17 +114,18 @@ namespace Freeking
 		void Bind();
 		void Unbind();
 
-		void SetParameterValue(const char*, int);
-		void SetParameterValue(const char*, float);
-		void SetParameterValue(const char*, const Vector2f&);
-		void SetParameterValue(const char*, const Vector3f&);
-		void SetParameterValue(const char*, const Vector4f&);
-		void SetParameterValue(const char*, const Matrix3x3&);
-		void SetParameterValue(const char*, const Matrix4x4&);
-		void SetParameterValue(const char*, const Texture2D*);
-		void SetParameterValue(const char*, const Texture2D*, const TextureSampler*);
-		void SetParameterValue(const char*, const TextureBuffer*);
-		void SetParameterValue(const char*, const TextureCube*, const TextureSampler*);
+		void SetParameterValue(const Name&, int);
+		void SetParameterValue(const Name&, float);
+		void SetParameterValue(const Name&, const Vector2f&);
+		void SetParameterValue(const Name&, const Vector3f&);
+		void SetParameterValue(const Name&, const Vector4f&);
+		void SetParameterValue(const Name&, const Matrix3x3&);
+		void SetParameterValue(const Name&, const Matrix4x4&);
+		void SetParameterValue(const Name&, const Texture2D*);
+		void SetParameterValue(const Name&, const Texture2D*, const TextureSampler*);
+		void SetParameterValue(const Name&, const Texture2DArray*, const TextureSampler*);
+		void SetParameterValue(const Name&, const TextureBuffer*);
+		void SetParameterValue(const Name&, const TextureCube*, const TextureSampler*);
 
 		void SetParameterValue(int, int);
 		void SetParameterValue(int, float);
@@ -97,13 +136,20 @@ namespace Freeking
 		void SetParameterValue(int, const Matrix4x4&);
 		void SetParameterValue(int, const Texture2D*);
 		void SetParameterValue(int, const Texture2D*, const TextureSampler*);
+		void SetParameterValue(int, const Texture2DArray*, const TextureSampler*);
 		void SetParameterValue(int, const TextureBuffer*);
 		void SetParameterValue(int, const TextureCube*, const TextureSampler*);
 
-		int GetFloatParameterId(const std::string& name) { return _floatParameters.GetId(name); }
-		int GetIntParameterId(const std::string& name) { return _intParameters.GetId(name); }
-		int GetMatrixParameterId(const std::string& name) { return _matrixParameters.GetId(name); }
-		int GetTextureParameterId(const std::string& name) { return _textureParameters.GetId(name); }
+		int GetFloatParameterId(const Name& name) { return _floatParameters.GetId(name); }
+		int GetIntParameterId(const Name& name) { return _intParameters.GetId(name); }
+		int GetMatrixParameterId(const Name& name) { return _matrixParameters.GetId(name); }
+		int GetTextureParameterId(const Name& name) { return _textureParameters.GetId(name); }
+
+		inline GLuint GetProgram() const { return _program; }
+
+		// glUniform calls made since the last reset, including texture unit assignments.
+		static inline size_t GetNumUniformCalls() { return _numUniformCalls; }
+		static inline void ResetStats() { _numUniformCalls = 0; }
 
 		struct FloatParameter
 		{
@@ -195,7 +241,7 @@ namespace Freeking
 		{
 			enum class Type : uint8_t
 			{
-				Tex1D, Tex2D, Tex3D, TexBuffer, TexCube, Invalid
+				Tex1D, Tex2D, Tex3D, TexBuffer, TexCube, Tex2DArray, Invalid
 			};
 
 			inline static Type CastType(GLenum type)
@@ -209,6 +255,7 @@ namespace Freeking
 				case GL_INT_SAMPLER_BUFFER: return Type::TexBuffer;
 				case GL_UNSIGNED_INT_SAMPLER_BUFFER: return Type::TexBuffer;
 				case GL_SAMPLER_CUBE: return Type::TexCube;
+				case GL_SAMPLER_2D_ARRAY: return Type::Tex2DArray;
 				}
 
 				return Type::Invalid;
@@ -223,12 +270,14 @@ namespace Freeking
 				case Type::Tex3D: return GL_TEXTURE_3D;
 				case Type::TexBuffer: return GL_TEXTURE_BUFFER;
 				case Type::TexCube: return GL_TEXTURE_CUBE_MAP;
+				case Type::Tex2DArray: return GL_TEXTURE_2D_ARRAY;
 				}
 
 				return GL_INVALID_ENUM;
 			}
 
 			void SetTexture(const Texture2D*, const TextureSampler*);
+			void SetTexture(const Texture2DArray*, const TextureSampler*);
 			void SetTexture(const TextureBuffer*);
 			void SetTexture(const TextureCube*, const TextureSampler*);
 			void Apply();
@@ -249,7 +298,7 @@ namespace Freeking
 		template <typename T>
 		struct Parameters
 		{
-			T& AddParameter(const std::string& name)
+			T& AddParameter(const Name& name)
 			{
 				if (auto it = _parameterNameIds.find(name);
 					it != _parameterNameIds.end())
@@ -264,7 +313,7 @@ namespace Freeking
 				return param;
 			}
 
-			int GetId(const std::string& name)
+			int GetId(const Name& name)
 			{
 				if (auto it = _parameterNameIds.find(name);
 					it != _parameterNameIds.end())
@@ -275,7 +324,7 @@ namespace Freeking
 				return -1;
 			}
 
-			T* GetParameter(const std::string& name)
+			T* GetParameter(const Name& name)
 			{
 				return GetParameter(GetId(name));
 			}
@@ -293,7 +342,7 @@ namespace Freeking
 			size_t GetCount() const { return _parameters.size(); }
 
 			std::vector<T> _parameters;
-			std::unordered_map<std::string, int> _parameterNameIds;
+			std::unordered_map<Name, int> _parameterNameIds;
 		};
 
 		GLuint _program;
@@ -316,5 +365,6 @@ namespace Freeking
 
 		static std::vector<TextureBindingState> _textureBindingStates;
 		static GLuint _activeProgramId;
+		static size_t _numUniformCalls;
 	};
 }
@@ -1,7 +1,7 @@
 #include "SpriteBatch.h"
 #include "Shader.h"
 #include "VertexBinding.h"
-#include "VertexBuffer.h"
+#include "StreamingBuffer.h"
 #include "Texture2D.h"
 #include "Font.h"
 #include "Maths.h"
@@ -63,28 +63,36 @@ namespace Freeking
 	{
 	}
 
-	SpriteBatch::SpriteBatch(size_t maxSpriteCount) :
+	SpriteBatch::SpriteBatch() :
 		_clipping(false),
 		_drawCallCount(0),
-		_maxSpriteCount(maxSpriteCount)
+		_bindingGeneration(0)
 	{
-		static const size_t vertSize = 8;
-		static const size_t faceVertCount = 6;
-		static const size_t vertStride = vertSize * sizeof(float);
+		_vertexBinding = std::make_unique<VertexBinding>();
+	}
+
+	bool SpriteBatch::UpdateBinding()
+	{
+		static const size_t vertStride = 8 * sizeof(float);
+
+		if (_bindingGeneration == StreamingBuffer::GetGeneration())
+		{
+			return false;
+		}
 
-		_vertexBuffer = std::make_unique<VertexBuffer>(nullptr, _maxSpriteCount * faceVertCount, vertStride, GL_DYNAMIC_DRAW);
+		auto vertexBuffer = StreamingBuffer::GetVertexBuffer();
 
 		ArrayElement vertexLayout[] =
 		{
-			ArrayElement(_vertexBuffer.get(), 0, 2, ElementType::Float, vertStride, 0),
-			ArrayElement(_vertexBuffer.get(), 1, 2, ElementType::Float, vertStride, 2 * sizeof(float)),
-			ArrayElement(_vertexBuffer.get(), 2, 4, ElementType::Float, vertStride, 4 * sizeof(float)),
+			ArrayElement(vertexBuffer, 0, 2, ElementType::Float, vertStride, 0),
+			ArrayElement(vertexBuffer, 1, 2, ElementType::Float, vertStride, 2 * sizeof(float)),
+			ArrayElement(vertexBuffer, 2, 4, ElementType::Float, vertStride, 4 * sizeof(float)),
 		};
 
-		_vertexBinding = std::make_unique<VertexBinding>();
-		_vertexBinding->Create(vertexLayout, 3, *_vertexBuffer);
+		_vertexBinding->Create(vertexLayout, 3, *vertexBuffer);
+		_bindingGeneration = StreamingBuffer::GetGeneration();
 
-		_vertexData.resize(_maxSpriteCount * faceVertCount * vertSize);
+		return true;
 	}
 
 	void SpriteBatch::DrawText(const Font* font, const std::string& text, const Vector2f& position, const LinearColor& colour, float scale)
@@ -505,6 +513,7 @@ namespace Freeking
 
 		glDisable(GL_DEPTH_TEST);
 
+		UpdateBinding();
 		_vertexBinding->Bind();
 
 		const auto& textShader = GetTextShader();
@@ -536,34 +545,45 @@ namespace Freeking
 		static const size_t faceVertCount = 6;
 		static const size_t vertStride = vertSize * sizeof(float);
 		static const uint32_t faceIndices[] = { 0, 1, 2, 2, 3, 0 };
+		static const Name textureName("texture");
 
 		size_t basePos = 0;
-		size_t maxSpriteBatch = sprites.size();
-		if (maxSpriteBatch > _maxSpriteCount)
-		{
-			maxSpriteBatch = _maxSpriteCount;
-		}
 
 		shader->Bind();
+		int textureId = shader->GetTextureParameterId(textureName);
 
-		while (basePos < sprites.size() && maxSpriteBatch > 0)
+		while (basePos < sprites.size())
 		{
 			size_t searchPos = basePos;
 			auto batchTexture = sprites[basePos]._texture;
 
-			while (searchPos < sprites.size() && (searchPos - basePos) < maxSpriteBatch && sprites[searchPos]._texture == batchTexture)
+			while (searchPos < sprites.size() && sprites[searchPos]._texture == batchTexture)
 			{
 				searchPos++;
 			}
 
+			// Vertices are written straight into the streaming buffer. Growing it replaces
+			// the buffer the binding points at.
+			size_t firstVertex;
+			auto vertexData = reinterpret_cast<float*>(StreamingBuffer::Allocate((searchPos - basePos) * faceVertCount, vertStride, firstVertex));
+			if (!vertexData)
+			{
+				break;
+			}
+
+			if (UpdateBinding())
+			{
+				_vertexBinding->Bind();
+			}
+
 			if (batchTexture != nullptr)
 			{
-				shader->SetParameterValue("texture", batchTexture);
+				shader->SetParameterValue(textureId, batchTexture);
 			}
 
 			for (size_t i = basePos; i < searchPos; ++i)
 			{
-				float* buffer = &_vertexData[(i - basePos) * faceVertCount * vertSize];
+				float* buffer = &vertexData[(i - basePos) * faceVertCount * vertSize];
 				const Sprite& sprite = sprites[i];
 
 				for (size_t j = 0; j < faceVertCount; ++j)
@@ -611,9 +631,7 @@ namespace Freeking
 				}
 			}
 
-			_vertexBuffer->UpdateBuffer(_vertexData.data(), 0, (searchPos - basePos) * faceVertCount * vertStride);
-
-			glDrawArrays(GL_TRIANGLES, 0, (GLsizei)((searchPos - basePos) * faceVertCount));
+			glDrawArrays(GL_TRIANGLES, (GLint)firstVertex, (GLsizei)((searchPos - basePos) * faceVertCount));
 
 			_drawCallCount++;
 
@@ -13,7 +13,6 @@ namespace Freeking
 {
 	class Texture2D;
 	class VertexBinding;
-	class VertexBuffer;
 	class Shader;
 	class Font;
 	class TextureSampler;
@@ -24,7 +23,7 @@ namespace Freeking
 
 		static std::shared_ptr<SpriteBatch> Debug;
 
-		SpriteBatch(size_t = 1000);
+		SpriteBatch();
 
 		void Flush(float = 1.0f);
 		void Clear();
@@ -101,15 +100,14 @@ namespace Freeking
 		static void TransformUV(Vector2f&, const Vector2f&, const Vector2f&, const Vector2f&);
 		static void TransformUVs(Slice&, const Vector2f&, const Vector2f&, const Vector2f&);
 		bool IsSpriteInsideClippingRect(const Vector2f&, const Vector2f&);
+		bool UpdateBinding();
 
 		std::vector<Sprite> _spritesToDraw;
 		std::vector<Sprite> _textToDraw;
 		bool _clipping;
 		Vector4f _clippingRect;
 		size_t _drawCallCount;
-		size_t _maxSpriteCount;
-		std::vector<float> _vertexData;
-		std::unique_ptr<VertexBuffer> _vertexBuffer;
 		std::unique_ptr<VertexBinding> _vertexBinding;
+		uint32_t _bindingGeneration;
 	};
 }
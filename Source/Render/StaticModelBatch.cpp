@@ -0,0 +1,186 @@
+#include "StaticModelBatch.h"
+#include "Shader.h"
+#include "Texture2D.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Freeking
+{
+	StaticModelBatch::StaticModelBatch() :
+		_dirty(false),
+		_numInstances(0),
+		_numTriangles(0),
+		_numRebuilds(0)
+	{
+	}
+
+	StaticModelBatch::Handle StaticModelBatch::Add(DynamicModel* model, Texture2D* skin, const Matrix4x4& modelMatrix, size_t frame, const Vector3f& center, float radius)
+	{
+		if (!model || !skin)
+		{
+			return InvalidHandle;
+		}
+
+		Handle handle;
+		if (!_freeProps.empty())
+		{
+			handle = _freeProps.back();
+			_freeProps.pop_back();
+		}
+		else
+		{
+			handle = (Handle)_props.size();
+			_props.emplace_back();
+		}
+
+		_props[handle] = { model, skin, frame, modelMatrix, center, radius, false, true };
+		_dirty = true;
+
+		return handle;
+	}
+
+	void StaticModelBatch::Move(Handle handle, const Matrix4x4& modelMatrix, const Vector3f& center)
+	{
+		if (handle >= _props.size() || !_props[handle].active)
+		{
+			return;
+		}
+
+		auto& prop = _props[handle];
+		prop.modelMatrix = modelMatrix;
+		prop.center = center;
+		_dirty = true;
+	}
+
+	void StaticModelBatch::SetHidden(Handle handle, bool hidden)
+	{
+		if (handle >= _props.size() || !_props[handle].active || _props[handle].hidden == hidden)
+		{
+			return;
+		}
+
+		_props[handle].hidden = hidden;
+		_dirty = true;
+	}
+
+	void StaticModelBatch::Remove(Handle handle)
+	{
+		if (handle >= _props.size() || !_props[handle].active)
+		{
+			return;
+		}
+
+		_props[handle].active = false;
+		_freeProps.push_back(handle);
+		_dirty = true;
+	}
+
+	void StaticModelBatch::Rebuild()
+	{
+		_dirty = false;
+		_numRebuilds++;
+
+		std::vector<const Prop*> props;
+		props.reserve(_props.size());
+
+		for (const auto& prop : _props)
+		{
+			if (prop.active && !prop.hidden)
+			{
+				props.push_back(&prop);
+			}
+		}
+
+		std::sort(props.begin(), props.end(), [](const Prop* a, const Prop* b)
+		{
+			if (a->model != b->model)
+			{
+				return a->model < b->model;
+			}
+
+			return (a->skin != b->skin) ? (a->skin < b->skin) : (a->frame < b->frame);
+		});
+
+		if (props.size() > DynamicModel::MaxStaticInstances)
+		{
+			std::cout << "Static model batch is full, " << (props.size() - DynamicModel::MaxStaticInstances) << " props not drawn" << std::endl;
+			props.resize(DynamicModel::MaxStaticInstances);
+		}
+
+		_groups.clear();
+		_bounds.clear();
+		_instances.clear();
+
+		for (const auto prop : props)
+		{
+			if (_groups.empty() ||
+				_groups.back().model != prop->model ||
+				_groups.back().skin != prop->skin ||
+				_groups.back().frame != prop->frame)
+			{
+				_groups.push_back({ prop->model, prop->skin, prop->frame, _instances.size(), 0, 0 });
+			}
+
+			_groups.back().numInstances++;
+			_bounds.push_back({ prop->center, prop->radius });
+			_instances.push_back(prop->model->MakeInstance(prop->modelMatrix, prop->frame, prop->frame, 0.0f));
+		}
+
+		_numInstances = _instances.size();
+
+		if (!_instances.empty())
+		{
+			DynamicModel::GetInstanceBuffer()->UpdateBuffer(_instances.data(), DynamicModel::MaxInstances * sizeof(DynamicModel::Instance), _instances.size() * sizeof(DynamicModel::Instance));
+		}
+	}
+
+	void StaticModelBatch::Draw(Shader* shader)
+	{
+		if (_dirty)
+		{
+			Rebuild();
+		}
+
+		_numTriangles = 0;
+
+		if (_groups.empty())
+		{
+			return;
+		}
+
+		static const Name normalBufferName("normalBuffer");
+		static const Name diffuseName("diffuse");
+		static const Name useDiffuseArrayName("useDiffuseArray");
+		static const Name frameVertexBufferName("frameVertexBuffer");
+		static const Name frameTransformBufferName("frameTransformBuffer");
+
+		shader->Bind();
+		shader->SetParameterValue(normalBufferName, DynamicModel::GetNormalBuffer().get());
+
+		int diffuseId = shader->GetTextureParameterId(diffuseName);
+		int useDiffuseArrayId = shader->GetIntParameterId(useDiffuseArrayName);
+		int frameVertexBufferId = shader->GetTextureParameterId(frameVertexBufferName);
+		int frameTransformBufferId = shader->GetTextureParameterId(frameTransformBufferName);
+
+		shader->SetParameterValue(useDiffuseArrayId, 0);
+
+		for (auto& group : _groups)
+		{
+			float screenSize = 0.0f;
+			for (size_t i = 0; i < group.numInstances; ++i)
+			{
+				const auto& bounds = _bounds[group.firstInstance + i];
+				screenSize = std::max(screenSize, DynamicModel::GetScreenSize(bounds.center, bounds.radius));
+			}
+
+			group.lod = group.model->SelectLod(screenSize, group.lod);
+
+			shader->SetParameterValue(diffuseId, group.skin);
+			shader->SetParameterValue(frameVertexBufferId, group.model->GetFrameVertexBuffer().get());
+			shader->SetParameterValue(frameTransformBufferId, group.model->GetFrameTransformBuffer().get());
+			group.model->Draw(group.lod, DynamicModel::MaxInstances + group.firstInstance, group.numInstances);
+
+			_numTriangles += (group.model->GetLod(group.lod).numIndices / 3) * group.numInstances;
+		}
+	}
+}
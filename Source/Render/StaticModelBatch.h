@@ -0,0 +1,82 @@
+#pragma once
+
+#include "DynamicModel.h"
+#include <vector>
+#include <cstdint>
+
+namespace Freeking
+{
+	class Shader;
+	class Texture2D;
+
+	// Draws models that rarely move, such as map props, from instances that stay in the
+	// static range of the shared instance buffer. Props are grouped by model, skin and frame,
+	// and each group is one instanced draw. The instances are only rebuilt when a prop is
+	// added, moved, hidden or removed.
+	class StaticModelBatch
+	{
+	public:
+
+		using Handle = uint32_t;
+		static constexpr Handle InvalidHandle = UINT32_MAX;
+
+		StaticModelBatch();
+
+		// The center and radius bound the prop in world space and pick its group's LOD.
+		Handle Add(DynamicModel* model, Texture2D* skin, const Matrix4x4& modelMatrix, size_t frame, const Vector3f& center, float radius);
+		void Move(Handle handle, const Matrix4x4& modelMatrix, const Vector3f& center);
+		void SetHidden(Handle handle, bool hidden);
+		void Remove(Handle handle);
+
+		void Draw(Shader* shader);
+
+		inline size_t GetNumInstances() const { return _numInstances; }
+		inline size_t GetNumDrawCalls() const { return _groups.size(); }
+		inline size_t GetNumTriangles() const { return _numTriangles; }
+		inline size_t GetNumRebuilds() const { return _numRebuilds; }
+
+	private:
+
+		struct Prop
+		{
+			DynamicModel* model;
+			Texture2D* skin;
+			size_t frame;
+			Matrix4x4 modelMatrix;
+			Vector3f center;
+			float radius;
+			bool hidden;
+			bool active;
+		};
+
+		// Each group draws its instances at the LOD its nearest prop needs. Bounds are kept
+		// in instance order.
+		struct Group
+		{
+			DynamicModel* model;
+			Texture2D* skin;
+			size_t frame;
+			size_t firstInstance;
+			size_t numInstances;
+			size_t lod;
+		};
+
+		struct Bounds
+		{
+			Vector3f center;
+			float radius;
+		};
+
+		void Rebuild();
+
+		std::vector<Prop> _props;
+		std::vector<Handle> _freeProps;
+		std::vector<Group> _groups;
+		std::vector<Bounds> _bounds;
+		std::vector<DynamicModel::Instance> _instances;
+		bool _dirty;
+		size_t _numInstances;
+		size_t _numTriangles;
+		size_t _numRebuilds;
+	};
+}
@@ -0,0 +1,124 @@
+#include "StreamingBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Freeking
+{
+	std::unique_ptr<VertexBuffer> StreamingBuffer::_buffer;
+	std::array<GLsync, StreamingBuffer::FrameCount> StreamingBuffer::_fences = {};
+	uint8_t* StreamingBuffer::_mapping = nullptr;
+	size_t StreamingBuffer::_frameBytes = 0;
+	size_t StreamingBuffer::_frame = 0;
+	size_t StreamingBuffer::_head = 0;
+	size_t StreamingBuffer::_lastFrameBytesUsed = 0;
+	uint32_t StreamingBuffer::_generation = 0;
+	size_t StreamingBuffer::_numStalls = 0;
+	double StreamingBuffer::_stallTime = 0.0;
+
+	static constexpr GLbitfield MapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	void StreamingBuffer::Initialize(size_t frameBytes)
+	{
+		if (_buffer)
+		{
+			return;
+		}
+
+		CreateStorage(frameBytes);
+	}
+
+	void StreamingBuffer::CreateStorage(size_t frameBytes)
+	{
+		// The old buffer may still be read by queued draws. Deleting it only releases the
+		// name, the driver keeps the storage until they finish.
+		for (auto& fence : _fences)
+		{
+			if (fence)
+			{
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		_buffer = std::make_unique<VertexBuffer>(frameBytes * FrameCount, 1, MapFlags);
+		_mapping = _buffer->GetMapping();
+		_frameBytes = frameBytes;
+		_frame = 0;
+		_head = 0;
+		_generation++;
+
+		if (!_mapping)
+		{
+			std::cout << "Failed to map " << (frameBytes * FrameCount) << " byte streaming buffer" << std::endl;
+		}
+	}
+
+	uint8_t* StreamingBuffer::Allocate(size_t count, size_t stride, size_t& first)
+	{
+		size_t size = count * stride;
+		size_t frameStart = _frame * _frameBytes;
+		size_t offset = ((frameStart + _head + stride - 1) / stride) * stride;
+
+		if (!_mapping)
+		{
+			first = 0;
+			return nullptr;
+		}
+
+		if (offset + size > frameStart + _frameBytes)
+		{
+			CreateStorage(std::max(_frameBytes * 2, size + stride));
+
+			if (!_mapping)
+			{
+				first = 0;
+				return nullptr;
+			}
+
+			frameStart = 0;
+			offset = 0;
+		}
+
+		_head = offset + size - frameStart;
+		first = offset / stride;
+
+		return _mapping + offset;
+	}
+
+	void StreamingBuffer::EndFrame()
+	{
+		if (!_buffer)
+		{
+			return;
+		}
+
+		_fences[_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		_lastFrameBytesUsed = _head;
+
+		_frame = (_frame + 1) % FrameCount;
+		_head = 0;
+
+		auto& fence = _fences[_frame];
+		if (!fence)
+		{
+			return;
+		}
+
+		// Only a GPU more than FrameCount - 1 frames behind makes this wait.
+		if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+			{
+			}
+
+			_numStalls++;
+			_stallTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
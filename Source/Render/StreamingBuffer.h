@@ -0,0 +1,59 @@
+#pragma once
+
+#include "VertexBuffer.h"
+#include <glad/gl.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace Freeking
+{
+	// Shared buffer for geometry rebuilt every frame. The storage is mapped once, persistent
+	// and coherent, and split into a region per frame in flight, so batches write vertices
+	// straight into memory the GPU reads. Each region is fenced at the end of its frame and
+	// waited on before it is reused. A frame that outgrows its region recreates the buffer
+	// twice as large, so callers check GetGeneration and rebuild their vertex bindings
+	// when it changes.
+	class StreamingBuffer
+	{
+	public:
+
+		StreamingBuffer() = delete;
+		~StreamingBuffer() = delete;
+
+		static constexpr size_t FrameCount = 3;
+
+		static void Initialize(size_t frameBytes);
+
+		// Space for count elements of stride bytes in this frame's region. first is the
+		// index of the first element in strides from the start of the buffer, for use as a
+		// first vertex or base instance.
+		static uint8_t* Allocate(size_t count, size_t stride, size_t& first);
+
+		// Call once per frame after rendering. Fences this frame's region and moves on to
+		// the next, waiting if the GPU is still reading it.
+		static void EndFrame();
+
+		static inline const VertexBuffer* GetVertexBuffer() { return _buffer.get(); }
+		static inline uint32_t GetGeneration() { return _generation; }
+		static inline size_t GetFrameBytes() { return _frameBytes; }
+		static inline size_t GetBytesUsed() { return _lastFrameBytesUsed; }
+		static inline size_t GetNumStalls() { return _numStalls; }
+		static inline double GetStallTime() { return _stallTime; }
+
+	private:
+
+		static void CreateStorage(size_t frameBytes);
+
+		static std::unique_ptr<VertexBuffer> _buffer;
+		static std::array<GLsync, FrameCount> _fences;
+		static uint8_t* _mapping;
+		static size_t _frameBytes;
+		static size_t _frame;
+		static size_t _head;
+		static size_t _lastFrameBytesUsed;
+		static uint32_t _generation;
+		static size_t _numStalls;
+		static double _stallTime;
+	};
+}
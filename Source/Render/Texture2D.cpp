@@ -10,7 +10,36 @@ namespace Freeking
 		AddLoader<TextureLoader>();
 	}
 
+	TextureLibrary::AssetPtr TextureLibrary::CreatePlaceholder()
+	{
+		return std::make_shared<Texture2D>(1, 1, 128, 128, 128);
+	}
+
+	size_t TextureLibrary::GetAssetBytes(const Texture2D& texture) const
+	{
+		return texture.GetNumBytes();
+	}
+
 	TextureLibrary Texture2D::Library;
+	size_t Texture2D::_totalBytes = 0;
+
+	bool Texture2D::IsCompressedFormat(GLenum internalFormat)
+	{
+		return internalFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || internalFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	}
+
+	size_t Texture2D::GetBytesPerPixel(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_RGB565:
+		case GL_RGBA4:
+			return 2;
+		default:
+			// Drivers pad RGB8 out to four bytes.
+			return 4;
+		}
+	}
 
 	Texture2D::Texture2D(GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const void* data) :
 		_width(width),
@@ -18,8 +47,13 @@ namespace Freeking
 		_internalFormat(internalFormat),
 		_format(format),
 		_type(type),
-		_id(0)
+		_id(0),
+		_numBytes((size_t)width * height * GetBytesPerPixel(internalFormat) * 4 / 3),
+		_firstLevel(0),
+		_requestedLevel(NoRequest)
 	{
+		_totalBytes += _numBytes;
+
 		glGenTextures(1, &_id);
 		glBindTexture(GL_TEXTURE_2D, _id);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -32,14 +66,85 @@ namespace Freeking
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
+	Texture2D::Texture2D(GLenum internalFormat, GLenum format, GLenum type, const std::vector<MipLevel>& levels) :
+		Texture2D(levels.front().width, levels.front().height, internalFormat, format, type, levels, 0)
+	{
+	}
+
+	Texture2D::Texture2D(GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const std::vector<MipLevel>& levels, uint32_t firstLevel) :
+		_width(width),
+		_height(height),
+		_internalFormat(internalFormat),
+		_format(format),
+		_type(type),
+		_id(0),
+		_numBytes(0),
+		_firstLevel(firstLevel),
+		_requestedLevel(NoRequest)
+	{
+		UploadLevels(levels);
+	}
+
+	void Texture2D::ReplaceLevels(const std::vector<MipLevel>& levels, uint32_t firstLevel)
+	{
+		if (_id != 0)
+		{
+			glDeleteTextures(1, &_id);
+			_id = 0;
+		}
+
+		_totalBytes -= _numBytes;
+		_numBytes = 0;
+		_firstLevel = firstLevel;
+
+		UploadLevels(levels);
+	}
+
+	void Texture2D::UploadLevels(const std::vector<MipLevel>& levels)
+	{
+		glGenTextures(1, &_id);
+		glBindTexture(GL_TEXTURE_2D, _id);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			const auto& level = levels[i];
+
+			if (IsCompressedFormat(_internalFormat))
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, _internalFormat, level.width, level.height, 0, level.size, level.data);
+				_numBytes += level.size;
+			}
+			else
+			{
+				glTexImage2D(GL_TEXTURE_2D, (GLint)i, _internalFormat, level.width, level.height, 0, _format, _type, level.data);
+				_numBytes += (size_t)level.width * level.height * GetBytesPerPixel(_internalFormat);
+			}
+		}
+
+		_totalBytes += _numBytes;
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
 	Texture2D::Texture2D(GLsizei width, GLsizei height, uint8_t r, uint8_t g, uint8_t b) :
 		_width(width),
 		_height(height),
 		_internalFormat(GL_RGBA8),
 		_format(GL_RGB),
 		_type(GL_UNSIGNED_BYTE),
-		_id(0)
+		_id(0),
+		_numBytes((size_t)width * height * 4 * 4 / 3),
+		_firstLevel(0),
+		_requestedLevel(NoRequest)
 	{
+		_totalBytes += _numBytes;
+
 		std::vector<uint8_t> buffer((width * height) * 3, 0);
 		uint8_t pixel[] { r, g, b };
 		for (auto i = 0; i < width * height; ++i)
@@ -61,5 +166,7 @@ namespace Freeking
 		{
 			glDeleteTextures(1, &_id);
 		}
+
+		_totalBytes -= _numBytes;
 	}
 }
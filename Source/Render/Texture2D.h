@@ -3,6 +3,9 @@
 #include "Texture.h"
 #include "AssetLibrary.h"
 #include <glad/gl.h>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
 
 namespace Freeking
 {
@@ -13,6 +16,8 @@ namespace Freeking
 	protected:
 
 		virtual void UpdateLoaders() override;
+		virtual AssetPtr CreatePlaceholder() override;
+		virtual size_t GetAssetBytes(const Texture2D& texture) const override;
 	};
 
 	class Texture2D : public Texture
@@ -21,14 +26,40 @@ namespace Freeking
 
 		static TextureLibrary Library;
 
+		// Size is only needed for compressed formats.
+		struct MipLevel
+		{
+			GLsizei width;
+			GLsizei height;
+			const void* data;
+			GLsizei size;
+		};
+
 		Texture2D() = delete;
 		Texture2D(GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const void* data);
+		Texture2D(GLenum internalFormat, GLenum format, GLenum type, const std::vector<MipLevel>& levels);
+		Texture2D(GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const std::vector<MipLevel>& levels, uint32_t firstLevel);
 		Texture2D(GLsizei width, GLsizei height, uint8_t r, uint8_t g, uint8_t b);
 		~Texture2D();
 
 		virtual const GLuint GetId() const override { return _id; }
 		const GLsizei GetWidth() const { return _width; }
 		const GLsizei GetHeight() const { return _height; }
+		inline size_t GetNumBytes() const { return _numBytes; }
+
+		// Streamed textures only hold the levels from firstLevel down. Width and height stay
+		// those of the full texture, whichever levels are resident.
+		void ReplaceLevels(const std::vector<MipLevel>& levels, uint32_t firstLevel);
+		inline uint32_t GetFirstLevel() const { return _firstLevel; }
+
+		// Renderers report the most detailed level they need each frame.
+		inline void RequestLevel(uint32_t level) { _requestedLevel = std::min(_requestedLevel, level); }
+		inline uint32_t TakeRequestedLevel() { auto level = _requestedLevel; _requestedLevel = NoRequest; return level; }
+
+		static constexpr uint32_t NoRequest = UINT32_MAX;
+
+		static bool IsCompressedFormat(GLenum internalFormat);
+		static inline size_t GetTotalBytes() { return _totalBytes; }
 
 	private:
 
@@ -38,5 +69,13 @@ namespace Freeking
 		GLenum _internalFormat;
 		GLenum _format;
 		GLenum _type;
+		size_t _numBytes;
+		uint32_t _firstLevel;
+		uint32_t _requestedLevel;
+
+		void UploadLevels(const std::vector<MipLevel>& levels);
+
+		static size_t GetBytesPerPixel(GLenum internalFormat);
+		static size_t _totalBytes;
 	};
 }
@@ -0,0 +1,69 @@
+#include "Texture2DArray.h"
+#include <algorithm>
+
+namespace Freeking
+{
+	Texture2DArray::Texture2DArray(GLsizei width, GLsizei height, GLsizei numLayers) :
+		_id(0),
+		_width(width),
+		_height(height),
+		_numLayers(std::max(numLayers, 1)),
+		_numLevels(1)
+	{
+		for (auto size = std::max(width, height); size > 1; size >>= 1)
+		{
+			_numLevels++;
+		}
+
+		_id = CreateStorage(_width, _height, _numLayers, _numLevels);
+	}
+
+	Texture2DArray::~Texture2DArray()
+	{
+		if (_id)
+		{
+			glDeleteTextures(1, &_id);
+		}
+	}
+
+	GLuint Texture2DArray::CreateStorage(GLsizei width, GLsizei height, GLsizei numLayers, GLsizei numLevels)
+	{
+		GLuint id = 0;
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &id);
+		glTextureStorage3D(id, numLevels, GL_RGBA8, width, height, numLayers);
+		glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		return id;
+	}
+
+	void Texture2DArray::Resize(GLsizei numLayers)
+	{
+		if (numLayers == _numLayers)
+		{
+			return;
+		}
+
+		auto id = CreateStorage(_width, _height, numLayers, _numLevels);
+		auto copyLayers = std::min(numLayers, _numLayers);
+
+		for (GLsizei level = 0; level < _numLevels; ++level)
+		{
+			auto width = std::max(_width >> level, 1);
+			auto height = std::max(_height >> level, 1);
+
+			glCopyImageSubData(_id, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, id, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, width, height, copyLayers);
+		}
+
+		glDeleteTextures(1, &_id);
+		_id = id;
+		_numLayers = numLayers;
+	}
+
+	void Texture2DArray::GenerateMipmaps()
+	{
+		glGenerateTextureMipmap(_id);
+	}
+}
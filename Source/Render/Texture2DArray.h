@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Texture.h"
+#include <glad/gl.h>
+#include <cstdint>
+
+namespace Freeking
+{
+	// RGBA8 texture array with a full mip chain. Layers are filled by rendering into them,
+	// so the storage is immutable and Resize reallocates it, keeping the existing layers.
+	class Texture2DArray : public Texture
+	{
+	public:
+
+		Texture2DArray() = delete;
+		Texture2DArray(GLsizei width, GLsizei height, GLsizei numLayers);
+		~Texture2DArray();
+
+		void Resize(GLsizei numLayers);
+		void GenerateMipmaps();
+
+		virtual const GLuint GetId() const override { return _id; }
+		inline GLsizei GetWidth() const { return _width; }
+		inline GLsizei GetHeight() const { return _height; }
+		inline GLsizei GetNumLayers() const { return _numLayers; }
+		inline size_t GetNumBytes() const { return (size_t)_width * _height * _numLayers * 4 * 4 / 3; }
+
+	private:
+
+		static GLuint CreateStorage(GLsizei width, GLsizei height, GLsizei numLayers, GLsizei numLevels);
+
+		GLuint _id;
+		GLsizei _width;
+		GLsizei _height;
+		GLsizei _numLayers;
+		GLsizei _numLevels;
+	};
+}
@@ -0,0 +1,300 @@
+#include "TextureStreamer.h"
+#include "AssetLoadQueue.h"
+#include "Renderer.h"
+#include "Maths.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Freeking
+{
+	std::unordered_map<const Texture2D*, TextureStreamer::StreamState> TextureStreamer::_textures;
+	uint64_t TextureStreamer::_frame = 0;
+	size_t TextureStreamer::_budget = 512 * 1024 * 1024;
+	bool TextureStreamer::_enabled = true;
+	size_t TextureStreamer::_numPendingLoads = 0;
+	size_t TextureStreamer::_numEvictions = 0;
+
+	static bool GetTextureFormat(CookedTextureFormat cookedFormat, GLenum& internalFormat, GLenum& format, GLenum& type)
+	{
+		switch (cookedFormat)
+		{
+		case CookedTextureFormat::RGBA8: internalFormat = GL_RGBA8; format = GL_RGBA; type = GL_UNSIGNED_BYTE; return true;
+		case CookedTextureFormat::RGB8: internalFormat = GL_RGB8; format = GL_RGB; type = GL_UNSIGNED_BYTE; return true;
+		case CookedTextureFormat::BC1: internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; format = GL_RGB; type = GL_UNSIGNED_BYTE; return true;
+		case CookedTextureFormat::BC3: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; format = GL_RGBA; type = GL_UNSIGNED_BYTE; return true;
+		case CookedTextureFormat::RGB565: internalFormat = GL_RGB565; format = GL_RGB; type = GL_UNSIGNED_SHORT_5_6_5; return true;
+		case CookedTextureFormat::RGBA4: internalFormat = GL_RGBA4; format = GL_RGBA; type = GL_UNSIGNED_SHORT_4_4_4_4; return true;
+		}
+
+		return false;
+	}
+
+	std::shared_ptr<Texture2D> TextureStreamer::CreateTexture(const std::string& name, FileView view, const CookedTextureFile& file)
+	{
+		GLenum internalFormat, format, type;
+		if (!GetTextureFormat(file.Header.Format, internalFormat, format, type))
+		{
+			return nullptr;
+		}
+
+		uint32_t initialLevel = 0;
+
+		if (_enabled)
+		{
+			while (initialLevel + 1 < file.Header.NumLevels &&
+				std::max(file.GetLevel(initialLevel).Width, file.GetLevel(initialLevel).Height) > InitialSize)
+			{
+				initialLevel++;
+			}
+		}
+
+		auto texture = std::make_shared<Texture2D>(
+			(GLsizei)file.Header.Width, (GLsizei)file.Header.Height,
+			internalFormat, format, type,
+			GetLevels(file, initialLevel), initialLevel);
+
+		if (initialLevel > 0)
+		{
+			_textures.insert_or_assign(texture.get(), StreamState{ name, texture, std::move(view), &file, initialLevel, initialLevel, _frame, false });
+		}
+
+		return texture;
+	}
+
+	std::vector<Texture2D::MipLevel> TextureStreamer::GetLevels(const CookedTextureFile& file, uint32_t firstLevel)
+	{
+		std::vector<Texture2D::MipLevel> levels;
+
+		for (uint32_t i = firstLevel; i < file.Header.NumLevels; ++i)
+		{
+			const auto& level = file.GetLevel(i);
+			levels.push_back({ (GLsizei)level.Width, (GLsizei)level.Height, file.GetLevelData(i), (GLsizei)level.Size });
+		}
+
+		return levels;
+	}
+
+	size_t TextureStreamer::GetLevelBytes(const CookedTextureFile& file, uint32_t firstLevel)
+	{
+		size_t numBytes = 0;
+
+		for (uint32_t i = firstLevel; i < file.Header.NumLevels; ++i)
+		{
+			numBytes += file.GetLevel(i).Size;
+		}
+
+		return numBytes;
+	}
+
+	void TextureStreamer::Update()
+	{
+		_frame++;
+
+		std::vector<std::pair<const Texture2D*, StreamState*>> wanted;
+
+		for (auto it = _textures.begin(); it != _textures.end();)
+		{
+			auto& state = it->second;
+			auto texture = state.texture.lock();
+
+			if (!texture)
+			{
+				it = _textures.erase(it);
+				continue;
+			}
+
+			if (auto requested = texture->TakeRequestedLevel(); requested != Texture2D::NoRequest)
+			{
+				state.wantedLevel = std::min(requested, state.file->Header.NumLevels - 1);
+				state.lastUsedFrame = _frame;
+
+				if (!state.pending && state.wantedLevel < texture->GetFirstLevel())
+				{
+					wanted.push_back({ it->first, &state });
+				}
+			}
+
+			++it;
+		}
+
+		// Textures furthest below the detail they need go first.
+		std::sort(wanted.begin(), wanted.end(), [](const auto& a, const auto& b)
+		{
+			return (int)a.first->GetFirstLevel() - (int)a.second->wantedLevel > (int)b.first->GetFirstLevel() - (int)b.second->wantedLevel;
+		});
+
+		for (auto& [texture, state] : wanted)
+		{
+			if (_numPendingLoads >= MaxPendingLoads)
+			{
+				break;
+			}
+
+			size_t bytesNeeded = GetLevelBytes(*state->file, state->wantedLevel) - texture->GetNumBytes();
+			if (!MakeRoom(bytesNeeded))
+			{
+				break;
+			}
+
+			StartLoad(texture, *state);
+		}
+	}
+
+	bool TextureStreamer::MakeRoom(size_t bytesNeeded)
+	{
+		if (Texture2D::GetTotalBytes() + bytesNeeded <= _budget)
+		{
+			return true;
+		}
+
+		std::vector<std::pair<const Texture2D*, StreamState*>> candidates;
+
+		for (auto& [key, state] : _textures)
+		{
+			auto texture = state.texture.lock();
+
+			if (texture && !state.pending && texture->GetFirstLevel() < state.initialLevel && state.lastUsedFrame < _frame)
+			{
+				candidates.push_back({ key, &state });
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b)
+		{
+			return a.second->lastUsedFrame < b.second->lastUsedFrame;
+		});
+
+		for (auto& [key, state] : candidates)
+		{
+			if (Texture2D::GetTotalBytes() + bytesNeeded <= _budget)
+			{
+				break;
+			}
+
+			if (auto texture = state->texture.lock())
+			{
+				texture->ReplaceLevels(GetLevels(*state->file, state->initialLevel), state->initialLevel);
+				_numEvictions++;
+			}
+		}
+
+		return Texture2D::GetTotalBytes() + bytesNeeded <= _budget;
+	}
+
+	void TextureStreamer::StartLoad(const Texture2D* key, StreamState& state)
+	{
+		state.pending = true;
+		_numPendingLoads++;
+
+		const auto level = state.wantedLevel;
+		const auto* data = state.file->GetLevelData(level);
+		size_t size = GetLevelBytes(*state.file, level);
+
+		// The worker only faults the mapped levels in, so the upload doesn't stall on disk.
+		AssetLoadQueue::EnqueueDecode([view = state.view, data, size, key, level]()
+		{
+			const volatile uint8_t* bytes = data;
+			uint8_t sum = 0;
+
+			for (size_t i = 0; i < size; i += 4096)
+			{
+				sum += bytes[i];
+			}
+
+			(void)sum;
+
+			AssetLoadQueue::EnqueueUpload([key, level]()
+			{
+				FinishLoad(key, level);
+			});
+		});
+	}
+
+	void TextureStreamer::FinishLoad(const Texture2D* key, uint32_t level)
+	{
+		_numPendingLoads--;
+
+		auto it = _textures.find(key);
+		if (it == _textures.end() || !it->second.pending)
+		{
+			return;
+		}
+
+		auto& state = it->second;
+		state.pending = false;
+
+		if (auto texture = state.texture.lock(); texture && level < texture->GetFirstLevel())
+		{
+			texture->ReplaceLevels(GetLevels(*state.file, level), level);
+		}
+	}
+
+	static float GetPixelsPerUnit(float distance)
+	{
+		return Renderer::ViewportHeight * 0.5f * Renderer::ProjectionMatrix[1].y / Math::Max(distance, 1.0f);
+	}
+
+	static uint32_t GetLevelForDensity(float texelsPerUnit, float pixelsPerUnit)
+	{
+		float ratio = texelsPerUnit / pixelsPerUnit;
+
+		return (ratio > 1.0f) ? (uint32_t)std::log2(ratio) : 0;
+	}
+
+	void TextureStreamer::RequestForBounds(Texture2D* texture, const Vector3f& boundsMin, const Vector3f& boundsMax, float texelsPerUnit)
+	{
+		if (!texture)
+		{
+			return;
+		}
+
+		auto cameraPosition = Renderer::ViewMatrix.InverseTranslation();
+		Vector3f closest(
+			Math::Clamp(cameraPosition.x, boundsMin.x, boundsMax.x),
+			Math::Clamp(cameraPosition.y, boundsMin.y, boundsMax.y),
+			Math::Clamp(cameraPosition.z, boundsMin.z, boundsMax.z));
+
+		float distance = closest.LengthBetween(cameraPosition);
+
+		texture->RequestLevel(GetLevelForDensity(texelsPerUnit, GetPixelsPerUnit(distance)));
+	}
+
+	void TextureStreamer::RequestForRadius(Texture2D* texture, const Vector3f& center, float radius)
+	{
+		if (!texture || radius <= 0.0f)
+		{
+			return;
+		}
+
+		// Model skins are atlases wrapped once around the model.
+		float texelsPerUnit = Math::Max(texture->GetWidth(), texture->GetHeight()) / (radius * 2.0f);
+		float distance = Math::Max(center.LengthBetween(Renderer::ViewMatrix.InverseTranslation()) - radius, 0.0f);
+
+		texture->RequestLevel(GetLevelForDensity(texelsPerUnit, GetPixelsPerUnit(distance)));
+	}
+
+	std::vector<TextureStreamer::TextureInfo> TextureStreamer::GetTextureInfo()
+	{
+		std::vector<TextureInfo> info;
+		info.reserve(_textures.size());
+
+		for (const auto& [key, state] : _textures)
+		{
+			if (auto texture = state.texture.lock())
+			{
+				info.push_back({
+					state.name,
+					(uint32_t)texture->GetWidth(),
+					(uint32_t)texture->GetHeight(),
+					state.file->Header.NumLevels,
+					texture->GetFirstLevel(),
+					state.wantedLevel,
+					texture->GetNumBytes(),
+					_frame - state.lastUsedFrame,
+					state.pending });
+			}
+		}
+
+		return info;
+	}
+}
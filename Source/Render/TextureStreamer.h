@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Texture2D.h"
+#include "FileView.h"
+#include "CookedTextureFile.h"
+#include "Vector.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Freeking
+{
+	// Keeps cooked textures at the mip level the renderer last asked for. Textures start
+	// with their small levels resident. More detailed levels are paged in on a worker and
+	// uploaded within the asset upload budget. When the texture budget is exceeded, the
+	// least recently used textures drop back to their small levels.
+	class TextureStreamer
+	{
+	public:
+
+		TextureStreamer() = delete;
+		~TextureStreamer() = delete;
+
+		struct TextureInfo
+		{
+			std::string name;
+			uint32_t width;
+			uint32_t height;
+			uint32_t numLevels;
+			uint32_t residentLevel;
+			uint32_t requestedLevel;
+			size_t numBytes;
+			uint64_t framesUnused;
+			bool pending;
+		};
+
+		// The view keeps the cooked file mapped for as long as the texture can stream.
+		static std::shared_ptr<Texture2D> CreateTexture(const std::string& name, FileView view, const CookedTextureFile& file);
+
+		// Call once per frame after rendering.
+		static void Update();
+
+		// Requests the level at which one texel covers about one pixel.
+		static void RequestForBounds(Texture2D* texture, const Vector3f& boundsMin, const Vector3f& boundsMax, float texelsPerUnit);
+		static void RequestForRadius(Texture2D* texture, const Vector3f& center, float radius);
+
+		static inline void SetEnabled(bool enabled) { _enabled = enabled; }
+		static inline bool IsEnabled() { return _enabled; }
+		static inline void SetBudget(size_t bytes) { _budget = bytes; }
+		static inline size_t GetBudget() { return _budget; }
+		static inline size_t GetNumTextures() { return _textures.size(); }
+		static inline size_t GetNumPendingLoads() { return _numPendingLoads; }
+		static inline size_t GetNumEvictions() { return _numEvictions; }
+		static std::vector<TextureInfo> GetTextureInfo();
+
+		// Largest level kept resident at all times.
+		static constexpr uint32_t InitialSize = 64;
+		static constexpr size_t MaxPendingLoads = 8;
+
+	private:
+
+		struct StreamState
+		{
+			std::string name;
+			std::weak_ptr<Texture2D> texture;
+			FileView view;
+			const CookedTextureFile* file;
+			uint32_t initialLevel;
+			uint32_t wantedLevel;
+			uint64_t lastUsedFrame;
+			bool pending;
+		};
+
+		static std::vector<Texture2D::MipLevel> GetLevels(const CookedTextureFile& file, uint32_t firstLevel);
+		static size_t GetLevelBytes(const CookedTextureFile& file, uint32_t firstLevel);
+		static void StartLoad(const Texture2D* key, StreamState& state);
+		static void FinishLoad(const Texture2D* key, uint32_t level);
+		static bool MakeRoom(size_t bytesNeeded);
+
+		static std::unordered_map<const Texture2D*, StreamState> _textures;
+		static uint64_t _frame;
+		static size_t _budget;
+		static bool _enabled;
+		static size_t _numPendingLoads;
+		static size_t _numEvictions;
+	};
+}
@@ -54,6 +54,7 @@ namespace Freeking
 		inline int GetNumElements() const { return _numElements; }
 		inline bool HasIndices() const { return _hasIndices; }
 		inline ElementType GetIndexType() const { return _indicesType; }
+		inline GLuint GetHandle() const { return _handle; }
 
 	private:
 
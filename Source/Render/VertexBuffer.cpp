@@ -7,7 +7,8 @@ namespace Freeking
 		_vbo(0),
 		_vertexCount(vertexCount),
 		_strideBytes(strideBytes),
-		_hint(hint)
+		_hint(hint),
+		_mapping(nullptr)
 	{
 		assert(vertexCount > 0);
 		assert(strideBytes > 0);
@@ -26,6 +27,31 @@ namespace Freeking
 		}
 	}
 
+	VertexBuffer::VertexBuffer(std::size_t vertexCount, size_t strideBytes, GLbitfield mapFlags) :
+		_vbo(0),
+		_vertexCount(vertexCount),
+		_strideBytes(strideBytes),
+		_hint(GL_STREAM_DRAW),
+		_mapping(nullptr)
+	{
+		assert(vertexCount > 0);
+		assert(strideBytes > 0);
+
+		glGenBuffers(1, &_vbo);
+
+		if (glGetError() == GL_NO_ERROR)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+			glBufferStorage(GL_ARRAY_BUFFER, vertexCount * strideBytes, nullptr, mapFlags);
+			_mapping = static_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexCount * strideBytes, mapFlags));
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+		else
+		{
+			_vbo = 0;
+		}
+	}
+
 	VertexBuffer::~VertexBuffer()
 	{
 		if (_vbo)
@@ -69,4 +95,9 @@ namespace Freeking
 		return _vbo;
 	}
 
+	uint8_t* VertexBuffer::GetMapping() const noexcept
+	{
+		return _mapping;
+	}
+
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glad/gl.h>
+#include <cstdint>
 #include <memory>
 
 namespace Freeking
@@ -13,6 +14,10 @@ namespace Freeking
 		VertexBuffer(const VertexBuffer& other) = delete;
 		VertexBuffer(VertexBuffer&&) = default;
 		VertexBuffer(const void* vertices, std::size_t vertexCount, size_t strideBytes, GLuint hint = GL_STATIC_DRAW);
+
+		// Immutable storage mapped persistently for writing for the life of the buffer.
+		VertexBuffer(std::size_t vertexCount, size_t strideBytes, GLbitfield mapFlags);
+
 		~VertexBuffer();
 
 		VertexBuffer& operator=(const VertexBuffer&) = delete;
@@ -23,6 +28,7 @@ namespace Freeking
 		std::size_t GetSizeInBytes() const noexcept;
 		GLuint GetHint() const noexcept;
 		GLuint GetVBO() const noexcept;
+		uint8_t* GetMapping() const noexcept;
 
 		void UpdateBuffer(const void* data, size_t offset, size_t size);
 
@@ -32,5 +38,6 @@ namespace Freeking
 		std::size_t _vertexCount;
 		std::size_t _strideBytes;
 		GLuint _hint;
+		uint8_t* _mapping;
 	};
 }
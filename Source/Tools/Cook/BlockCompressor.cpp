@@ -0,0 +1,234 @@
+#include "BlockCompressor.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+namespace Freeking
+{
+	static uint16_t PackRGB565(int r, int g, int b)
+	{
+		return (uint16_t)((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+	}
+
+	static void UnpackRGB565(uint16_t color, int* rgb)
+	{
+		int r = (color >> 11) & 31;
+		int g = (color >> 5) & 63;
+		int b = color & 31;
+
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+
+	// Range fit: endpoints from the inset bounding box of the block, then nearest palette entry per pixel.
+	static void EncodeColorBlock(const uint8_t* block, uint8_t* output)
+	{
+		int minColor[3] = { 255, 255, 255 };
+		int maxColor[3] = { 0, 0, 0 };
+
+		for (int i = 0; i < 16; ++i)
+		{
+			for (int c = 0; c < 3; ++c)
+			{
+				minColor[c] = std::min(minColor[c], (int)block[i * 4 + c]);
+				maxColor[c] = std::max(maxColor[c], (int)block[i * 4 + c]);
+			}
+		}
+
+		for (int c = 0; c < 3; ++c)
+		{
+			int inset = (maxColor[c] - minColor[c]) / 16;
+			minColor[c] = std::min(255, minColor[c] + inset);
+			maxColor[c] = std::max(0, maxColor[c] - inset);
+		}
+
+		uint16_t color0 = PackRGB565(maxColor[0], maxColor[1], maxColor[2]);
+		uint16_t color1 = PackRGB565(minColor[0], minColor[1], minColor[2]);
+
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+		}
+
+		uint32_t indices = 0;
+
+		// Equal endpoints would select the three colour mode, so every pixel uses color0.
+		if (color0 != color1)
+		{
+			int palette[4][3];
+			UnpackRGB565(color0, palette[0]);
+			UnpackRGB565(color1, palette[1]);
+
+			for (int c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (int i = 0; i < 16; ++i)
+			{
+				int bestIndex = 0;
+				int bestDistance = INT_MAX;
+
+				for (int p = 0; p < 4; ++p)
+				{
+					int dr = block[i * 4 + 0] - palette[p][0];
+					int dg = block[i * 4 + 1] - palette[p][1];
+					int db = block[i * 4 + 2] - palette[p][2];
+					int distance = dr * dr + dg * dg + db * db;
+
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+
+				indices |= (uint32_t)bestIndex << (i * 2);
+			}
+		}
+
+		std::memcpy(output, &color0, 2);
+		std::memcpy(output + 2, &color1, 2);
+		std::memcpy(output + 4, &indices, 4);
+	}
+
+	static void EncodeAlphaBlock(const uint8_t* block, uint8_t* output)
+	{
+		int minAlpha = 255;
+		int maxAlpha = 0;
+
+		for (int i = 0; i < 16; ++i)
+		{
+			minAlpha = std::min(minAlpha, (int)block[i * 4 + 3]);
+			maxAlpha = std::max(maxAlpha, (int)block[i * 4 + 3]);
+		}
+
+		uint64_t indices = 0;
+
+		if (maxAlpha != minAlpha)
+		{
+			// Eight value mode: a0 > a1, with six interpolated values between them.
+			int palette[8] = { maxAlpha, minAlpha };
+			for (int p = 1; p < 7; ++p)
+			{
+				palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha) / 7;
+			}
+
+			for (int i = 0; i < 16; ++i)
+			{
+				int alpha = block[i * 4 + 3];
+				int bestIndex = 0;
+				int bestDistance = INT_MAX;
+
+				for (int p = 0; p < 8; ++p)
+				{
+					int distance = std::abs(alpha - palette[p]);
+
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+
+				indices |= (uint64_t)bestIndex << (i * 3);
+			}
+		}
+
+		output[0] = (uint8_t)maxAlpha;
+		output[1] = (uint8_t)minAlpha;
+
+		for (int i = 0; i < 6; ++i)
+		{
+			output[2 + i] = (uint8_t)(indices >> (i * 8));
+		}
+	}
+
+	void BlockCompressor::EncodeBC1(const uint8_t* block, uint8_t* output)
+	{
+		EncodeColorBlock(block, output);
+	}
+
+	void BlockCompressor::EncodeBC3(const uint8_t* block, uint8_t* output)
+	{
+		EncodeAlphaBlock(block, output);
+		EncodeColorBlock(block, output + 8);
+	}
+
+	template <typename EncodeFunction>
+	static std::vector<uint8_t> CompressBlocks(const uint8_t* rgba, uint32_t width, uint32_t height, size_t blockSize, EncodeFunction encode)
+	{
+		uint32_t blocksX = (width + 3) / 4;
+		uint32_t blocksY = (height + 3) / 4;
+		std::vector<uint8_t> output((size_t)blocksX * blocksY * blockSize);
+		uint8_t block[64];
+
+		for (uint32_t by = 0; by < blocksY; ++by)
+		{
+			for (uint32_t bx = 0; bx < blocksX; ++bx)
+			{
+				for (uint32_t y = 0; y < 4; ++y)
+				{
+					for (uint32_t x = 0; x < 4; ++x)
+					{
+						uint32_t sx = std::min(bx * 4 + x, width - 1);
+						uint32_t sy = std::min(by * 4 + y, height - 1);
+						std::memcpy(&block[(y * 4 + x) * 4], &rgba[((size_t)sy * width + sx) * 4], 4);
+					}
+				}
+
+				encode(block, &output[((size_t)by * blocksX + bx) * blockSize]);
+			}
+		}
+
+		return output;
+	}
+
+	std::vector<uint8_t> BlockCompressor::CompressBC1(const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		return CompressBlocks(rgba, width, height, 8, EncodeBC1);
+	}
+
+	std::vector<uint8_t> BlockCompressor::CompressBC3(const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		return CompressBlocks(rgba, width, height, 16, EncodeBC3);
+	}
+
+	std::vector<uint8_t> BlockCompressor::ConvertRGB565(const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		size_t numPixels = (size_t)width * height;
+		std::vector<uint8_t> output(numPixels * 2);
+
+		for (size_t i = 0; i < numPixels; ++i)
+		{
+			uint16_t pixel = PackRGB565(rgba[i * 4 + 0], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+			std::memcpy(&output[i * 2], &pixel, 2);
+		}
+
+		return output;
+	}
+
+	std::vector<uint8_t> BlockCompressor::ConvertRGBA4(const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		size_t numPixels = (size_t)width * height;
+		std::vector<uint8_t> output(numPixels * 2);
+
+		for (size_t i = 0; i < numPixels; ++i)
+		{
+			auto quantize = [](int value) { return (value * 15 + 127) / 255; };
+
+			uint16_t pixel = (uint16_t)(
+				(quantize(rgba[i * 4 + 0]) << 12) |
+				(quantize(rgba[i * 4 + 1]) << 8) |
+				(quantize(rgba[i * 4 + 2]) << 4) |
+				quantize(rgba[i * 4 + 3]));
+
+			std::memcpy(&output[i * 2], &pixel, 2);
+		}
+
+		return output;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Freeking
+{
+	class BlockCompressor
+	{
+	public:
+
+		// Blocks are 4x4 RGBA8 pixels, row major.
+		static void EncodeBC1(const uint8_t* block, uint8_t* output);
+		static void EncodeBC3(const uint8_t* block, uint8_t* output);
+
+		// Compresses a whole RGBA8 image, clamping the edge blocks of sizes that aren't a multiple of four.
+		static std::vector<uint8_t> CompressBC1(const uint8_t* rgba, uint32_t width, uint32_t height);
+		static std::vector<uint8_t> CompressBC3(const uint8_t* rgba, uint32_t width, uint32_t height);
+
+		static std::vector<uint8_t> ConvertRGB565(const uint8_t* rgba, uint32_t width, uint32_t height);
+		static std::vector<uint8_t> ConvertRGBA4(const uint8_t* rgba, uint32_t width, uint32_t height);
+	};
+}
@@ -0,0 +1,169 @@
+#include "CookedArchiveWriter.h"
+#include "CookedArchive.h"
+#include "FileSystem.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+namespace Freeking
+{
+	static const uint32_t MaxSeedAttempts = 1 << 16;
+
+	void CookedArchiveWriter::Add(const std::string& path, Source source)
+	{
+		_entries.push_back({ FileSystem::NormalisePath(path), std::move(source) });
+	}
+
+	bool CookedArchiveWriter::BuildPerfectHash(uint32_t numBuckets, uint32_t numSlots, std::vector<uint32_t>& seeds, std::vector<uint32_t>& slots) const
+	{
+		std::vector<std::vector<uint32_t>> buckets(numBuckets);
+
+		for (uint32_t i = 0; i < (uint32_t)_entries.size(); ++i)
+		{
+			buckets[CookedArchive::BucketHash(_entries[i].path) % numBuckets].push_back(i);
+		}
+
+		std::vector<uint32_t> bucketOrder(numBuckets);
+		std::iota(bucketOrder.begin(), bucketOrder.end(), 0);
+		std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&buckets](uint32_t a, uint32_t b)
+		{
+			return buckets[a].size() > buckets[b].size();
+		});
+
+		seeds.assign(numBuckets, 0);
+		slots.assign(numSlots, CookedArchive::EmptySlot);
+
+		std::vector<uint32_t> bucketSlots;
+
+		// Place the largest buckets first, while most slots are still free.
+		for (uint32_t bucketIndex : bucketOrder)
+		{
+			const auto& bucket = buckets[bucketIndex];
+			if (bucket.empty())
+			{
+				break;
+			}
+
+			bool placed = false;
+
+			for (uint32_t seed = 0; seed < MaxSeedAttempts && !placed; ++seed)
+			{
+				bucketSlots.clear();
+				placed = true;
+
+				for (uint32_t entryIndex : bucket)
+				{
+					uint32_t slot = CookedArchive::SlotHash(_entries[entryIndex].path, seed) % numSlots;
+
+					if (slots[slot] != CookedArchive::EmptySlot || std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end())
+					{
+						placed = false;
+						break;
+					}
+
+					bucketSlots.push_back(slot);
+				}
+
+				if (placed)
+				{
+					seeds[bucketIndex] = seed;
+
+					for (size_t i = 0; i < bucket.size(); ++i)
+					{
+						slots[bucketSlots[i]] = bucket[i];
+					}
+				}
+			}
+
+			if (!placed)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool CookedArchiveWriter::Write(const std::filesystem::path& path)
+	{
+		auto numEntries = (uint32_t)_entries.size();
+		auto numBuckets = std::max(1u, (numEntries + 3) / 4);
+		auto numSlots = std::max(1u, numEntries + numEntries / 4);
+
+		std::vector<uint32_t> seeds;
+		std::vector<uint32_t> slots;
+
+		while (!BuildPerfectHash(numBuckets, numSlots, seeds, slots))
+		{
+			numSlots += std::max(1u, numSlots / 8);
+		}
+
+		std::vector<CookedArchiveEntry> entries(numEntries);
+		std::string names;
+
+		for (uint32_t i = 0; i < numEntries; ++i)
+		{
+			entries[i].NameOffset = (uint32_t)names.size();
+			entries[i].NameLength = (uint32_t)_entries[i].path.size();
+			names += _entries[i].path;
+		}
+
+		auto align = [](uint64_t offset) { return (offset + CookedArchive::Alignment - 1) & ~(uint64_t)(CookedArchive::Alignment - 1); };
+
+		CookedArchiveHeader header;
+		header.Ident = CookedArchive::Ident;
+		header.Version = CookedArchive::Version;
+		header.NumEntries = numEntries;
+		header.NumBuckets = numBuckets;
+		header.NumSlots = numSlots;
+		header.NamesOffset = (uint32_t)(sizeof(CookedArchiveHeader) + (seeds.size() + slots.size()) * sizeof(uint32_t) + entries.size() * sizeof(CookedArchiveEntry));
+		header.NamesSize = (uint32_t)names.size();
+		header.DataOffset = (uint32_t)align(header.NamesOffset + header.NamesSize);
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream.is_open())
+		{
+			std::cout << "Could not open " << path.string() << " for writing" << std::endl;
+			return false;
+		}
+
+		static const char padding[CookedArchive::Alignment] = {};
+		uint64_t offset = header.DataOffset;
+
+		stream.seekp(offset);
+
+		for (uint32_t i = 0; i < numEntries; ++i)
+		{
+			auto view = _entries[i].source();
+
+			entries[i].Offset = offset;
+			entries[i].Size = view.size();
+
+			stream.write((const char*)view.data(), view.size());
+			offset += view.size();
+
+			auto alignedOffset = align(offset);
+			stream.write(padding, alignedOffset - offset);
+			offset = alignedOffset;
+		}
+
+		stream.seekp(0);
+		stream.write((const char*)&header, sizeof(header));
+		stream.write((const char*)seeds.data(), seeds.size() * sizeof(uint32_t));
+		stream.write((const char*)slots.data(), slots.size() * sizeof(uint32_t));
+		stream.write((const char*)entries.data(), entries.size() * sizeof(CookedArchiveEntry));
+		stream.write(names.data(), names.size());
+
+		if (!stream.good())
+		{
+			std::cout << "Failed writing " << path.string() << std::endl;
+			return false;
+		}
+
+		std::cout << "Wrote " << numEntries << " entries (" << numSlots << " slots, " << numBuckets << " buckets), "
+			<< (offset / (1024 * 1024)) << " MB to " << path.string() << std::endl;
+
+		return true;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "FileView.h"
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Freeking
+{
+	class CookedArchiveWriter
+	{
+	public:
+
+		using Source = std::function<FileView()>;
+
+		// Entries are laid out in the order they're added.
+		void Add(const std::string& path, Source source);
+		bool Write(const std::filesystem::path& path);
+
+		inline size_t GetNumEntries() const { return _entries.size(); }
+
+	private:
+
+		struct Entry
+		{
+			std::string path;
+			Source source;
+		};
+
+		bool BuildPerfectHash(uint32_t numBuckets, uint32_t numSlots, std::vector<uint32_t>& seeds, std::vector<uint32_t>& slots) const;
+
+		std::vector<Entry> _entries;
+	};
+}
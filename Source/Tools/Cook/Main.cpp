@@ -0,0 +1,349 @@
+#include "CookedArchiveWriter.h"
+#include "TextureCooker.h"
+#include "FileSystem.h"
+#include "PakFileSystem.h"
+#include "PhysicalFileSystem.h"
+#include "CookedTextureFile.h"
+#include "CookedModelFile.h"
+#include "MdxFile.h"
+#include "Md2File.h"
+#include "Paths.h"
+#include "MappedFile.h"
+#include "Hash.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+using namespace Freeking;
+
+// Builds a cooked archive from the stock Kingpin data:
+//   freeking-cook [-basedir <dir>] [-accesslog <file>] [-textures] [-models] [-cache <dir>] [-report] [-o <archive>]
+// The access log is written by running the game with -recordaccess <file>. Cooked textures are
+// cached by source contents, so only new or changed textures are cooked on later runs. Cooked
+// models are quick to build and are rebuilt every run.
+int main(int argc, char** argv)
+{
+	std::filesystem::path baseDir = Paths::KingpinDir();
+	std::filesystem::path accessLogPath;
+	std::filesystem::path outputPath;
+	std::filesystem::path cacheDir = std::filesystem::current_path() / "Cache" / "Textures";
+	bool cookTextures = false;
+	bool cookModels = false;
+	bool report = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg(argv[i]);
+
+		if (arg == "-basedir" && (i + 1) < argc) baseDir = argv[++i];
+		else if (arg == "-accesslog" && (i + 1) < argc) accessLogPath = argv[++i];
+		else if (arg == "-o" && (i + 1) < argc) outputPath = argv[++i];
+		else if (arg == "-textures") cookTextures = true;
+		else if (arg == "-models") cookModels = true;
+		else if (arg == "-cache" && (i + 1) < argc) cacheDir = argv[++i];
+		else if (arg == "-report") report = true;
+		else
+		{
+			std::cout << "Unknown argument " << arg << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (outputPath.empty())
+	{
+		outputPath = baseDir / "main/Pak0.fka";
+	}
+
+	FileSystem::AddFileSystem(PhysicalFileSystem::Create(baseDir / "main"));
+	FileSystem::AddFileSystem(PakFileSystem::Create(baseDir / "main/Pak0.pak"));
+
+	std::unordered_map<std::string, size_t> accessOrder;
+
+	if (!accessLogPath.empty())
+	{
+		std::ifstream accessLog(accessLogPath);
+		std::string line;
+
+		while (std::getline(accessLog, line))
+		{
+			// Sessions recorded with a cooked archive mounted read the derived payloads.
+			for (auto cookedExtension : { CookedTextureFile::Extension, CookedModelFile::Extension })
+			{
+				const size_t extensionLength = strlen(cookedExtension);
+				if (line.size() > extensionLength && line.compare(line.size() - extensionLength, extensionLength, cookedExtension) == 0)
+				{
+					line.resize(line.size() - extensionLength);
+				}
+			}
+
+			accessOrder.try_emplace(FileSystem::NormalisePath(line), accessOrder.size());
+		}
+
+		std::cout << accessOrder.size() << " files in access log" << std::endl;
+	}
+
+	std::vector<std::string> files;
+
+	for (auto& file : FileSystem::FindFiles("", ""))
+	{
+		auto extension = std::filesystem::path(file).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+		if (extension != ".pak" && extension != ".fka" && extension != ".exe" && extension != ".dll")
+		{
+			files.push_back(std::move(file));
+		}
+	}
+
+	auto getAccessOrder = [&accessOrder](const std::string& file)
+	{
+		auto it = accessOrder.find(FileSystem::NormalisePath(file));
+		return (it != accessOrder.end()) ? it->second : std::numeric_limits<size_t>::max();
+	};
+
+	// Files read by the recorded session come first, in the order they were read.
+	std::stable_sort(files.begin(), files.end(), [&getAccessOrder](const std::string& a, const std::string& b)
+	{
+		return getAccessOrder(a) < getAccessOrder(b);
+	});
+
+	std::unordered_map<std::string, std::filesystem::path> cookedTextures;
+
+	if (cookTextures)
+	{
+		struct CookJob
+		{
+			std::string file;
+			bool interfaceTexture;
+			std::filesystem::path cachePath;
+		};
+
+		std::vector<CookJob> jobs;
+
+		for (const auto& file : files)
+		{
+			auto path = FileSystem::NormalisePath(file);
+			if (!TextureCooker::CanCook(path))
+			{
+				continue;
+			}
+
+			auto view = FileSystem::GetFileView(file);
+			if (!TextureCooker::CanDecode(view.data(), view.size()))
+			{
+				continue;
+			}
+
+			bool interfaceTexture = TextureCooker::IsInterfaceTexture(path);
+			auto hash = Hash::Fnv1a64(std::string_view((const char*)view.data(), view.size()));
+
+			char cacheName[64];
+			snprintf(cacheName, sizeof(cacheName), "%016llx-%u%s%s", (unsigned long long)hash, TextureCooker::CookVersion,
+				interfaceTexture ? "-ui" : "", CookedTextureFile::Extension);
+
+			jobs.push_back({ file, interfaceTexture, cacheDir / cacheName });
+		}
+
+		std::filesystem::create_directories(cacheDir);
+
+		std::atomic<size_t> nextJob = 0;
+		std::atomic<size_t> numCooked = 0;
+		std::vector<std::thread> workers(std::max(1u, std::thread::hardware_concurrency()));
+
+		auto cookBegin = std::chrono::steady_clock::now();
+
+		for (auto& worker : workers)
+		{
+			worker = std::thread([&jobs, &nextJob, &numCooked]()
+			{
+				for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+				{
+					const auto& job = jobs[i];
+
+					std::error_code error;
+					if (std::filesystem::exists(job.cachePath, error))
+					{
+						continue;
+					}
+
+					auto view = FileSystem::GetFileView(job.file);
+					auto cooked = TextureCooker::Cook(view.data(), view.size(), job.interfaceTexture);
+					if (cooked.empty())
+					{
+						continue;
+					}
+
+					// Written under a temporary name so an interrupted cook never leaves a truncated cache entry.
+					auto tempPath = job.cachePath;
+					tempPath += ".tmp";
+
+					std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+					stream.write((const char*)cooked.data(), cooked.size());
+					stream.close();
+
+					if (stream.good())
+					{
+						std::filesystem::rename(tempPath, job.cachePath, error);
+						numCooked++;
+					}
+				}
+			});
+		}
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		double cookSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - cookBegin).count();
+
+		std::cout << jobs.size() << " textures, " << numCooked << " cooked on " << workers.size() << " threads in "
+			<< cookSeconds << "s, " << (jobs.size() - numCooked) << " from " << cacheDir.string() << std::endl;
+
+		size_t uncookedBytes = 0;
+		size_t cookedBytes = 0;
+		double decodeSeconds = 0.0;
+
+		for (const auto& job : jobs)
+		{
+			auto mapped = MappedFile::Open(job.cachePath);
+			auto cookedFile = mapped ? CookedTextureFile::Create(mapped->GetData(), mapped->GetSize()) : nullptr;
+			if (!cookedFile)
+			{
+				continue;
+			}
+
+			cookedTextures.emplace(job.file, job.cachePath);
+
+			// What the loader allocates for an uncooked texture: RGBA8 plus a driver generated mip chain.
+			uncookedBytes += (size_t)cookedFile->Header.Width * cookedFile->Header.Height * 4 * 4 / 3;
+
+			for (uint32_t level = 0; level < cookedFile->Header.NumLevels; ++level)
+			{
+				cookedBytes += cookedFile->GetLevel(level).Size;
+			}
+
+			if (report)
+			{
+				auto view = FileSystem::GetFileView(job.file);
+				decodeSeconds += TextureCooker::TimeDecode(view.data(), view.size());
+			}
+		}
+
+		std::cout << "Texture memory: " << (uncookedBytes / (1024 * 1024)) << " MB uncooked, "
+			<< (cookedBytes / (1024 * 1024)) << " MB cooked" << std::endl;
+
+		if (report)
+		{
+			std::cout << "Source decode time saved at load: " << decodeSeconds << "s" << std::endl;
+		}
+	}
+
+	std::unordered_map<std::string, std::vector<uint8_t>> cookedModels;
+
+	if (cookModels)
+	{
+		struct ModelJob
+		{
+			std::string file;
+			bool mdx;
+		};
+
+		std::vector<ModelJob> jobs;
+
+		for (const auto& file : files)
+		{
+			auto extension = std::filesystem::path(file).extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+			if (extension == ".mdx" || extension == ".md2")
+			{
+				jobs.push_back({ file, extension == ".mdx" });
+			}
+		}
+
+		std::vector<std::vector<uint8_t>> results(jobs.size());
+		std::atomic<size_t> nextJob = 0;
+		std::vector<std::thread> workers(std::max(1u, std::thread::hardware_concurrency()));
+
+		auto cookBegin = std::chrono::steady_clock::now();
+
+		for (auto& worker : workers)
+		{
+			worker = std::thread([&jobs, &results, &nextJob]()
+			{
+				for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+				{
+					const auto& job = jobs[i];
+					auto view = FileSystem::GetFileView(job.file);
+					BinaryReader reader(view);
+					DynamicModelData model;
+
+					if (!(job.mdx ? MDXFile::Read(reader, model) : MD2File::Read(reader, model)))
+					{
+						continue;
+					}
+
+					model.GenerateLods();
+					model.BuildFrameAnimations();
+					results[i] = model.WriteCooked();
+				}
+			});
+		}
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		double cookSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - cookBegin).count();
+		size_t cookedBytes = 0;
+
+		for (size_t i = 0; i < jobs.size(); ++i)
+		{
+			if (!results[i].empty())
+			{
+				cookedBytes += results[i].size();
+				cookedModels.emplace(jobs[i].file, std::move(results[i]));
+			}
+		}
+
+		std::cout << jobs.size() << " models, " << cookedModels.size() << " cooked on " << workers.size() << " threads in "
+			<< cookSeconds << "s, " << (cookedBytes / 1024) << " KB" << std::endl;
+	}
+
+	CookedArchiveWriter writer;
+
+	for (const auto& file : files)
+	{
+		if (auto cooked = cookedTextures.find(file); cooked != cookedTextures.end())
+		{
+			writer.Add(file + CookedTextureFile::Extension, [cachePath = cooked->second]()
+			{
+				auto mapped = MappedFile::Open(cachePath);
+				return mapped ? FileView(mapped->GetData(), mapped->GetSize(), mapped) : FileView();
+			});
+		}
+
+		if (auto cooked = cookedModels.find(file); cooked != cookedModels.end())
+		{
+			writer.Add(file + CookedModelFile::Extension, [&bytes = cooked->second]()
+			{
+				return FileView(std::move(bytes));
+			});
+		}
+
+		writer.Add(file, [file]() { return FileSystem::GetFileView(file); });
+	}
+
+	std::cout << files.size() << " files, " << cookedTextures.size() << " cooked textures, " << cookedModels.size() << " cooked models" << std::endl;
+
+	return writer.Write(outputPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,256 @@
+#include "TextureCooker.h"
+#include "BlockCompressor.h"
+#include "CookedTextureFile.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+namespace Freeking
+{
+	bool TextureCooker::CanCook(const std::string& path)
+	{
+		static const char* extensions[] = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd" };
+
+		for (const char* extension : extensions)
+		{
+			size_t length = strlen(extension);
+
+			if (path.size() > length && path.compare(path.size() - length, length, extension) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool TextureCooker::CanDecode(const uint8_t* data, size_t size)
+	{
+		int width, height, channels;
+		return stbi_info_from_memory(data, (int)size, &width, &height, &channels) != 0;
+	}
+
+	double TextureCooker::TimeDecode(const uint8_t* data, size_t size)
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		int width, height, channels;
+		stbi_image_free(stbi_load_from_memory(data, (int)size, &width, &height, &channels, 0));
+
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+	bool TextureCooker::IsInterfaceTexture(const std::string& path)
+	{
+		return path.compare(0, 5, "pics/") == 0 || path.compare(0, 6, "fonts/") == 0;
+	}
+
+	static float SRGBToLinear(uint8_t value)
+	{
+		static const auto table = []()
+		{
+			std::array<float, 256> table;
+
+			for (int i = 0; i < 256; ++i)
+			{
+				float c = i / 255.0f;
+				table[i] = (c <= 0.04045f) ? (c / 12.92f) : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+
+			return table;
+		}();
+
+		return table[value];
+	}
+
+	static uint8_t LinearToSRGB(float value)
+	{
+		value = std::clamp(value, 0.0f, 1.0f);
+		float c = (value <= 0.0031308f) ? (value * 12.92f) : (1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f);
+
+		return (uint8_t)(c * 255.0f + 0.5f);
+	}
+
+	// Linear RGB and alpha, four floats per texel.
+	struct LinearImage
+	{
+		uint32_t width;
+		uint32_t height;
+		std::vector<float> texels;
+	};
+
+	// 2x2 box filter in linear space. Colour is weighted by alpha so fully transparent
+	// texels don't bleed into the smaller levels of masked textures.
+	static LinearImage Downsample(const LinearImage& source)
+	{
+		LinearImage level;
+		level.width = std::max(1u, source.width / 2);
+		level.height = std::max(1u, source.height / 2);
+		level.texels.resize((size_t)level.width * level.height * 4);
+
+		for (uint32_t y = 0; y < level.height; ++y)
+		{
+			uint32_t y0 = std::min(y * 2, source.height - 1);
+			uint32_t y1 = std::min(y * 2 + 1, source.height - 1);
+
+			for (uint32_t x = 0; x < level.width; ++x)
+			{
+				uint32_t x0 = std::min(x * 2, source.width - 1);
+				uint32_t x1 = std::min(x * 2 + 1, source.width - 1);
+
+				const float* samples[4] =
+				{
+					&source.texels[((size_t)y0 * source.width + x0) * 4],
+					&source.texels[((size_t)y0 * source.width + x1) * 4],
+					&source.texels[((size_t)y1 * source.width + x0) * 4],
+					&source.texels[((size_t)y1 * source.width + x1) * 4],
+				};
+
+				float color[3] = {};
+				float unweighted[3] = {};
+				float alpha = 0.0f;
+
+				for (const float* sample : samples)
+				{
+					for (int c = 0; c < 3; ++c)
+					{
+						color[c] += sample[c] * sample[3];
+						unweighted[c] += sample[c];
+					}
+
+					alpha += sample[3];
+				}
+
+				float* texel = &level.texels[((size_t)y * level.width + x) * 4];
+
+				for (int c = 0; c < 3; ++c)
+				{
+					texel[c] = (alpha > 0.0f) ? (color[c] / alpha) : (unweighted[c] / 4.0f);
+				}
+
+				texel[3] = alpha / 4.0f;
+			}
+		}
+
+		return level;
+	}
+
+	static std::vector<uint8_t> ToRGBA8(const LinearImage& image)
+	{
+		std::vector<uint8_t> rgba(image.texels.size());
+
+		for (size_t i = 0; i < image.texels.size(); i += 4)
+		{
+			rgba[i + 0] = LinearToSRGB(image.texels[i + 0]);
+			rgba[i + 1] = LinearToSRGB(image.texels[i + 1]);
+			rgba[i + 2] = LinearToSRGB(image.texels[i + 2]);
+			rgba[i + 3] = (uint8_t)(std::clamp(image.texels[i + 3], 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+
+		return rgba;
+	}
+
+	static std::vector<uint8_t> EncodeLevel(CookedTextureFormat format, const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height)
+	{
+		switch (format)
+		{
+		case CookedTextureFormat::BC1: return BlockCompressor::CompressBC1(rgba.data(), width, height);
+		case CookedTextureFormat::BC3: return BlockCompressor::CompressBC3(rgba.data(), width, height);
+		case CookedTextureFormat::RGB565: return BlockCompressor::ConvertRGB565(rgba.data(), width, height);
+		case CookedTextureFormat::RGBA4: return BlockCompressor::ConvertRGBA4(rgba.data(), width, height);
+		default: return rgba;
+		}
+	}
+
+	std::vector<uint8_t> TextureCooker::Cook(const uint8_t* data, size_t size, bool interfaceTexture)
+	{
+		int width, height, sourceChannels;
+		uint8_t* image = stbi_load_from_memory(data, (int)size, &width, &height, &sourceChannels, 4);
+		if (!image)
+		{
+			return {};
+		}
+
+		LinearImage level;
+		level.width = width;
+		level.height = height;
+		level.texels.resize((size_t)width * height * 4);
+
+		bool hasAlpha = false;
+
+		for (size_t i = 0; i < level.texels.size(); i += 4)
+		{
+			level.texels[i + 0] = SRGBToLinear(image[i + 0]);
+			level.texels[i + 1] = SRGBToLinear(image[i + 1]);
+			level.texels[i + 2] = SRGBToLinear(image[i + 2]);
+			level.texels[i + 3] = image[i + 3] / 255.0f;
+
+			hasAlpha |= (image[i + 3] != 255);
+		}
+
+		stbi_image_free(image);
+
+		CookedTextureFormat format;
+		if (interfaceTexture)
+		{
+			format = hasAlpha ? CookedTextureFormat::RGBA4 : CookedTextureFormat::RGB565;
+		}
+		else
+		{
+			format = hasAlpha ? CookedTextureFormat::BC3 : CookedTextureFormat::BC1;
+		}
+
+		// Interface textures aren't minified, so they only keep the top level.
+		uint32_t maxLevels = interfaceTexture ? 1 : CookedTextureFile::MaxLevels;
+
+		std::vector<std::vector<uint8_t>> levels;
+		std::vector<std::pair<uint32_t, uint32_t>> sizes;
+
+		while (true)
+		{
+			auto rgba = ToRGBA8(level);
+			levels.push_back(EncodeLevel(format, rgba, level.width, level.height));
+			sizes.push_back({ level.width, level.height });
+
+			if ((level.width == 1 && level.height == 1) || levels.size() >= maxLevels)
+			{
+				break;
+			}
+
+			level = Downsample(level);
+		}
+
+		CookedTextureHeader header;
+		header.Ident = CookedTextureFile::Ident;
+		header.Version = CookedTextureFile::Version;
+		header.Width = width;
+		header.Height = height;
+		header.Format = format;
+		header.NumLevels = (uint32_t)levels.size();
+
+		size_t offset = sizeof(CookedTextureHeader) + levels.size() * sizeof(CookedTextureLevel);
+		std::vector<CookedTextureLevel> levelHeaders;
+
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			levelHeaders.push_back({ sizes[i].first, sizes[i].second, (uint32_t)offset, (uint32_t)levels[i].size() });
+			offset += levels[i].size();
+		}
+
+		std::vector<uint8_t> file(offset);
+		std::memcpy(file.data(), &header, sizeof(header));
+		std::memcpy(file.data() + sizeof(header), levelHeaders.data(), levelHeaders.size() * sizeof(CookedTextureLevel));
+
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			std::memcpy(file.data() + levelHeaders[i].Offset, levels[i].data(), levels[i].size());
+		}
+
+		return file;
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace Freeking
+{
+	class TextureCooker
+	{
+	public:
+
+		static bool CanCook(const std::string& path);
+		static bool CanDecode(const uint8_t* data, size_t size);
+
+		// Interface art is drawn at or near 1:1, where block artifacts show, so it's stored
+		// as 16-bit texels instead of BC1/BC3.
+		static bool IsInterfaceTexture(const std::string& path);
+
+		// Decodes a source image and builds a .fktex with a gamma-correct mip chain. Returns an
+		// empty buffer when the image can't be decoded.
+		static std::vector<uint8_t> Cook(const uint8_t* data, size_t size, bool interfaceTexture);
+
+		// Seconds stb_image takes to decode the source, which is what a cooked texture saves at load.
+		static double TimeDecode(const uint8_t* data, size_t size);
+
+		// Bumped whenever Cook's output changes, so cached results are rebuilt.
+		static constexpr uint32_t CookVersion = 2;
+	};
+}
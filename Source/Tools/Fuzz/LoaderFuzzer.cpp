@@ -0,0 +1,119 @@
+#include "FileSystem.h"
+#include "WavLoader.h"
+#include "Md2Loader.h"
+#include "MdxLoader.h"
+#include "TextureLoader.h"
+#include "CookedTextureFile.h"
+#include "BspFile.h"
+#include "EntityLump.h"
+#include "NavFile.h"
+#include <array>
+
+using namespace Freeking;
+
+// libFuzzer entry point for the asset decoders. The first input byte picks the format and
+// the rest is served as the file. Only the Decode half of each loader runs, so no GL or
+// AL context is needed.
+//   freeking-fuzz-loaders [corpus dir] [libFuzzer options]
+
+namespace
+{
+	const std::array<const char*, 8> FileNames =
+	{
+		"fuzz.wav",
+		"fuzz.md2",
+		"fuzz.mdx",
+		"fuzz.tga",
+		"fuzz.png.fktex",
+		"fuzz.bsp",
+		"fuzz.nav",
+		"fuzz.mdx.fkmdl",
+	};
+
+	class FuzzFileSystem : public IFileSystem
+	{
+	public:
+
+		virtual bool FileExists(const std::string& filename) override
+		{
+			return filename == Name;
+		}
+
+		virtual std::vector<uint8_t> GetFileData(const std::string& filename) override
+		{
+			auto view = GetFileView(filename);
+
+			return std::vector<uint8_t>(view.begin(), view.end());
+		}
+
+		virtual FileView GetFileView(const std::string& filename) override
+		{
+			if (filename != Name)
+			{
+				return {};
+			}
+
+			return FileView(Data, Size);
+		}
+
+		virtual void FindFiles(const std::string&, const std::string&, std::vector<std::string>& files) override
+		{
+			files.insert(files.end(), FileNames.begin(), FileNames.end());
+		}
+
+		static inline std::string Name;
+		static inline const uint8_t* Data = nullptr;
+		static inline size_t Size = 0;
+	};
+
+	template <typename T>
+	void Decode(const std::string& name)
+	{
+		T loader;
+		loader.Decode(name);
+	}
+
+	void ReadBsp(const uint8_t* data, size_t size)
+	{
+		if (auto bspFile = BspFile::Create(data, size))
+		{
+			auto entities = bspFile->GetLumpArray<char>(bspFile->Header.Entities);
+
+			EntityLump lump;
+			lump.Parse(std::string_view(entities.Data(), entities.Num()));
+		}
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	static bool mounted = false;
+	if (!mounted)
+	{
+		FileSystem::AddFileSystem(std::make_unique<FuzzFileSystem>());
+		mounted = true;
+	}
+
+	if (size < 1)
+	{
+		return 0;
+	}
+
+	auto format = data[0] % FileNames.size();
+	FuzzFileSystem::Name = FileNames[format];
+	FuzzFileSystem::Data = data + 1;
+	FuzzFileSystem::Size = size - 1;
+
+	switch (format)
+	{
+	case 0: Decode<WavLoader>("fuzz.wav"); break;
+	case 1: Decode<MD2Loader>("fuzz.md2"); break;
+	case 2: Decode<MDXLoader>("fuzz.mdx"); break;
+	case 3: Decode<TextureLoader>("fuzz.tga"); break;
+	case 4: Decode<TextureLoader>("fuzz.png"); break;
+	case 5: ReadBsp(FuzzFileSystem::Data, FuzzFileSystem::Size); break;
+	case 6: NavFile::ReadNodes(FuzzFileSystem::Data, FuzzFileSystem::Size); break;
+	}
+
+	return 0;
+}